@@ -0,0 +1,569 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+/*
+ * Benchmarks of the main rendering paths of Forge
+ *
+ * Every benchmark is run a few times to warm up caches and drivers and then
+ * repeated a number of times, each repetition is timed separately. Results
+ * are written as JSON, one entry per benchmark with the statistics of the
+ * repetition times and the throughput at median time.
+ *
+ * usage: forge_bench [--output file] [--filter substring]
+ *                    [--warmup count] [--repetitions count] [--software]
+ *
+ * --software selects Mesa's llvmpipe rasterizer, which along with an
+ * invisible window lets the suite run on machines without a GPU.
+ *
+ * Built with FG_BENCH_CUDA defined, as forge_bench_cuda is, the suite also
+ * measures copies from CUDA device memory using the helpers of ComputeCopy.h
+ */
+
+#include <forge.h>
+#if defined(FG_BENCH_CUDA)
+#define USE_FORGE_CUDA_COPY_HELPERS
+#include <ComputeCopy.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static const int WIDTH  = 1024;
+static const int HEIGHT = 768;
+
+using namespace std;
+
+struct Result {
+    string         mName;
+    string         mUnit;
+    double         mWork;
+    vector<double> mSeconds;
+};
+
+class Suite {
+    private:
+        string         mFilter;
+        int            mWarmup;
+        int            mRepetitions;
+        vector<Result> mResults;
+
+    public:
+        Suite(const string& pFilter, const int pWarmup, const int pRepetitions)
+            : mFilter(pFilter), mWarmup(pWarmup), mRepetitions(pRepetitions) {}
+
+        bool selected(const string& pName) const {
+            return mFilter.empty() || pName.find(mFilter) != string::npos;
+        }
+
+        /* pWork is the amount of work done by one call to pBody, in pUnit */
+        Result* run(const string& pName, const string& pUnit, const double pWork,
+                    const function<void()>& pBody)
+        {
+            typedef chrono::steady_clock Clock;
+
+            if (!selected(pName))
+                return nullptr;
+
+            cerr << pName << endl;
+            for (int i = 0; i < mWarmup; ++i)
+                pBody();
+
+            Result result;
+            result.mName = pName;
+            result.mUnit = pUnit;
+            result.mWork = pWork;
+            for (int i = 0; i < mRepetitions; ++i) {
+                Clock::time_point start = Clock::now();
+                pBody();
+                result.mSeconds.push_back(chrono::duration<double>(Clock::now() - start).count());
+            }
+            mResults.push_back(result);
+            return &mResults.back();
+        }
+
+        void write(ostream& pOut) const
+        {
+            pOut << "{\n";
+            pOut << "  \"forge_version\": \"" << FG_VERSION << "\",\n";
+            pOut << "  \"forge_revision\": \"" << FG_REVISION << "\",\n";
+            pOut << "  \"gl_vendor\": \"" << (const char*)glGetString(GL_VENDOR) << "\",\n";
+            pOut << "  \"gl_renderer\": \"" << (const char*)glGetString(GL_RENDERER) << "\",\n";
+            pOut << "  \"gl_version\": \"" << (const char*)glGetString(GL_VERSION) << "\",\n";
+            pOut << "  \"warmup\": " << mWarmup << ",\n";
+            pOut << "  \"repetitions\": " << mRepetitions << ",\n";
+            pOut << "  \"benchmarks\": [";
+            for (size_t r = 0; r < mResults.size(); ++r) {
+                const Result& result = mResults[r];
+                vector<double> sorted = result.mSeconds;
+                sort(sorted.begin(), sorted.end());
+                const size_t n = sorted.size();
+                double mean = 0.0;
+                for (double s : sorted) mean += s;
+                mean /= n;
+                double var = 0.0;
+                for (double s : sorted) var += (s - mean) * (s - mean);
+                const double stddev = n > 1 ? sqrt(var / (n - 1)) : 0.0;
+                const double median = n % 2 ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+
+                pOut << (r ? ",\n" : "\n");
+                pOut << "    {\n";
+                pOut << "      \"name\": \"" << result.mName << "\",\n";
+                pOut << "      \"unit\": \"" << result.mUnit << "\",\n";
+                pOut << "      \"work\": " << result.mWork << ",\n";
+                pOut << "      \"throughput\": " << result.mWork / median << ",\n";
+                pOut << "      \"seconds\": {\"min\": " << sorted.front()
+                     << ", \"median\": " << median << ", \"mean\": " << mean
+                     << ", \"max\": " << sorted.back() << ", \"stddev\": " << stddev << "},\n";
+                pOut << "      \"samples\": [";
+                for (size_t i = 0; i < result.mSeconds.size(); ++i)
+                    pOut << (i ? ", " : "") << result.mSeconds[i];
+                pOut << "]\n";
+                pOut << "    }";
+            }
+            pOut << "\n  ]\n}\n";
+        }
+};
+
+static string name(const char* pFormat, ...)
+{
+    char buffer[256];
+    va_list args;
+    va_start(args, pFormat);
+    vsnprintf(buffer, sizeof(buffer), pFormat, args);
+    va_end(args);
+    return string(buffer);
+}
+
+/* wait for the GPU, so that a repetition is charged for all of its work */
+static void sync()
+{
+    glFinish();
+}
+
+static void copyToBuffer(const GLenum pTarget, const unsigned pBuffer,
+                         const void* pData, const size_t pBytes)
+{
+    glBindBuffer(pTarget, pBuffer);
+    glBufferSubData(pTarget, 0, pBytes, pData);
+    glBindBuffer(pTarget, 0);
+}
+
+static void fillRandom(vector<float>& pData, const float pMin, const float pMax)
+{
+    for (auto& v : pData)
+        v = pMin + (pMax - pMin) * (rand() / (float)RAND_MAX);
+}
+
+static void benchSetup(Suite& pSuite, fg::Window& pWindow)
+{
+    pSuite.run("setup/window_create", "windows", 1.0, [&] {
+        fg::Window window(64, 64, "forge_bench", &pWindow, true);
+    });
+    pWindow.makeCurrent();
+
+#ifndef OS_WIN
+    pSuite.run("setup/font_load", "fonts", 1.0, [&] {
+        fg::Font font;
+        font.loadSystemFont("Vera");
+    });
+#endif
+
+    /* renderables compile and link their programs on creation */
+    pSuite.run("setup/shader_image", "objects", 1.0, [&] {
+        fg::Image image(64, 64, FG_RGBA, fg::f32);
+    });
+    pSuite.run("setup/shader_plot", "objects", 1.0, [&] {
+        fg::Plot plot(16, fg::f32, FG_CHART_2D, FG_PLOT_SCATTER, FG_MARKER_CIRCLE);
+    });
+    pSuite.run("setup/shader_surface", "objects", 1.0, [&] {
+        fg::Surface surface(16, 16, fg::f32, FG_PLOT_SURFACE, FG_MARKER_NONE);
+    });
+}
+
+static void benchUploads(Suite& pSuite, fg::Window& pWindow)
+{
+    static const size_t MEGABYTES[] = {1, 16, 64};
+
+    for (size_t mb : MEGABYTES) {
+        const size_t bytes  = mb << 20;
+        const unsigned points = (unsigned)(bytes / (2 * sizeof(float)));
+        const string benches[] = {name("upload/buffer_sub_data/%zuMB", mb),
+                                  name("upload/map/%zuMB", mb),
+                                  name("upload/async/%zuMB", mb),
+                                  name("upload/image_pbo/%zuMB", mb)};
+
+        /* skip allocating inputs when the filter leaves nothing to run */
+        if (none_of(begin(benches), end(benches),
+                    [&](const string& pName) { return pSuite.selected(pName); }))
+            continue;
+
+        fg::Plot plot(points, fg::f32, FG_CHART_2D);
+        vector<float> data(bytes / sizeof(float));
+        fillRandom(data, -1.0f, 1.0f);
+
+        pSuite.run(benches[0], "bytes", (double)bytes, [&] {
+            copyToBuffer(GL_ARRAY_BUFFER, plot.vertices(), data.data(), bytes);
+            sync();
+        });
+        pSuite.run(benches[1], "bytes", (double)bytes, [&] {
+            memcpy(plot.map(FG_VERTEX_BUFFER), data.data(), bytes);
+            plot.unmap(FG_VERTEX_BUFFER);
+            sync();
+        });
+        pSuite.run(benches[2], "bytes", (double)bytes, [&] {
+            pWindow.uploadAsync(plot.vertices(), data.data(), bytes);
+            pWindow.finishUploads();
+            sync();
+        });
+
+        if (!pSuite.selected(benches[3]))
+            continue;
+
+        /* pixel buffer copy plus the texture update on draw */
+        const unsigned side = (unsigned)sqrt((double)(bytes / 4));
+        fg::Image image(side, side, FG_RGBA, fg::u8);
+        pSuite.run(benches[3], "bytes", (double)image.size(), [&] {
+            copyToBuffer(GL_PIXEL_UNPACK_BUFFER, image.pbo(), data.data(), image.size());
+            pWindow.draw(image);
+            sync();
+        });
+    }
+}
+
+#if defined(FG_BENCH_CUDA)
+/* device to device copies into buffers registered with CUDA, which
+ * is how compute libraries hand their results over to Forge */
+static void benchInteropUploads(Suite& pSuite, fg::Window& pWindow)
+{
+    static const size_t MEGABYTES[] = {1, 16, 64};
+
+    for (size_t mb : MEGABYTES) {
+        const size_t bytes  = mb << 20;
+        const unsigned points = (unsigned)(bytes / (2 * sizeof(float)));
+        const string benches[] = {name("upload/cuda/%zuMB", mb),
+                                  name("upload/cuda_image_pbo/%zuMB", mb)};
+
+        if (none_of(begin(benches), end(benches),
+                    [&](const string& pName) { return pSuite.selected(pName); }))
+            continue;
+
+        vector<float> data(bytes / sizeof(float));
+        fillRandom(data, -1.0f, 1.0f);
+        void* source = NULL;
+        FORGE_CUDA_CHECK(cudaMalloc(&source, bytes));
+        FORGE_CUDA_CHECK(cudaMemcpy(source, data.data(), bytes, cudaMemcpyHostToDevice));
+
+        GfxHandle* handle = NULL;
+        if (pSuite.selected(benches[0])) {
+            fg::Plot plot(points, fg::f32, FG_CHART_2D);
+            createGLBuffer(&handle, plot.vertices(), FORGE_VBO);
+            pSuite.run(benches[0], "bytes", (double)bytes, [&] {
+                copyToGLBuffer(handle, (ComputeResourceHandle)source, bytes);
+                sync();
+            });
+            releaseGLBuffer(handle);
+        }
+
+        if (pSuite.selected(benches[1])) {
+            /* interop copy plus the texture update on draw */
+            const unsigned side = (unsigned)sqrt((double)(bytes / 4));
+            fg::Image image(side, side, FG_RGBA, fg::u8);
+            createGLBuffer(&handle, image.pbo(), FORGE_PBO);
+            pSuite.run(benches[1], "bytes", (double)image.size(), [&] {
+                copyToGLBuffer(handle, (ComputeResourceHandle)source, image.size());
+                pWindow.draw(image);
+                sync();
+            });
+            releaseGLBuffer(handle);
+        }
+
+        FORGE_CUDA_CHECK(cudaFree(source));
+    }
+}
+#endif
+
+static void benchPlots(Suite& pSuite, fg::Window& pWindow)
+{
+    static const unsigned SIZES[] = {1000, 100000, 1000000};
+    static const struct {
+        fg::PlotType   mType;
+        fg::MarkerType mMarker;
+        const char*    mName;
+    } KINDS[] = {
+        {FG_PLOT_LINE   , FG_MARKER_NONE    , "line"            },
+        {FG_PLOT_LINE   , FG_MARKER_CIRCLE  , "line_circle"     },
+        {FG_PLOT_SCATTER, FG_MARKER_POINT   , "scatter_point"   },
+        {FG_PLOT_SCATTER, FG_MARKER_CIRCLE  , "scatter_circle"  },
+        {FG_PLOT_SCATTER, FG_MARKER_SQUARE  , "scatter_square"  },
+        {FG_PLOT_SCATTER, FG_MARKER_STAR    , "scatter_star"    },
+    };
+
+    for (unsigned size : SIZES) {
+        for (const auto& kind : KINDS) {
+            const string bench = name("plot/%s/%u", kind.mName, size);
+            if (!pSuite.selected(bench))
+                continue;
+
+            fg::Chart chart(FG_CHART_2D);
+            chart.setAxesLimits(-1.0f, 1.0f, -1.0f, 1.0f);
+            fg::Plot plot = chart.plot(size, fg::f32, kind.mType, kind.mMarker);
+            vector<float> data(2 * size);
+            fillRandom(data, -1.0f, 1.0f);
+            copyToBuffer(GL_ARRAY_BUFFER, plot.vertices(), data.data(), plot.verticesSize());
+
+            pSuite.run(bench, "vertices", size, [&] {
+                pWindow.draw(chart);
+                sync();
+            });
+        }
+    }
+}
+
+static void benchHistograms(Suite& pSuite, fg::Window& pWindow)
+{
+    static const unsigned BINS[] = {16, 256, 4096};
+
+    for (unsigned bins : BINS) {
+        const string bench = name("histogram/%u", bins);
+        if (!pSuite.selected(bench))
+            continue;
+
+        fg::Chart chart(FG_CHART_2D);
+        chart.setAxesLimits(0.0f, (float)bins, 0.0f, 1.0f);
+        fg::Histogram hist = chart.histogram(bins, fg::f32);
+        vector<float> data(bins);
+        fillRandom(data, 0.0f, 1.0f);
+        copyToBuffer(GL_ARRAY_BUFFER, hist.vertices(), data.data(), hist.verticesSize());
+
+        pSuite.run(bench, "bars", bins, [&] {
+            pWindow.draw(chart);
+            sync();
+        });
+    }
+}
+
+static void benchSurfaces(Suite& pSuite, fg::Window& pWindow)
+{
+    static const unsigned SIDES[] = {64, 256, 1024};
+
+    for (unsigned side : SIDES) {
+        const string bench = name("surface/%ux%u", side, side);
+        if (!pSuite.selected(bench))
+            continue;
+
+        fg::Chart chart(FG_CHART_3D);
+        chart.setAxesLimits(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
+        fg::Surface surf = chart.surface(side, side, fg::f32);
+        vector<float> data(3 * side * side);
+        for (unsigned y = 0; y < side; ++y) {
+            for (unsigned x = 0; x < side; ++x) {
+                float* v = &data[3 * (y * side + x)];
+                v[0] = 2.0f * x / side - 1.0f;
+                v[1] = 2.0f * y / side - 1.0f;
+                v[2] = sin(4.0f * v[0]) * cos(4.0f * v[1]);
+            }
+        }
+        copyToBuffer(GL_ARRAY_BUFFER, surf.vertices(), data.data(), surf.verticesSize());
+
+        pSuite.run(bench, "vertices", (double)side * side, [&] {
+            pWindow.draw(chart);
+            sync();
+        });
+    }
+}
+
+static void benchImages(Suite& pSuite, fg::Window& pWindow)
+{
+    static const unsigned SIDES[] = {512, 2048};
+    static const struct {
+        fg::ChannelFormat mFormat;
+        fg::dtype         mType;
+        const char*       mName;
+    } FORMATS[] = {
+        {FG_RGBA     , fg::f32, "rgba_f32"},
+        {FG_RGBA     , fg::u8 , "rgba_u8" },
+        {FG_RGB      , fg::u8 , "rgb_u8"  },
+        {FG_GRAYSCALE, fg::f32, "gray_f32"},
+        {FG_GRAYSCALE, fg::u8 , "gray_u8" },
+    };
+
+    for (unsigned side : SIDES) {
+        for (const auto& format : FORMATS) {
+            const string bench = name("image/%s/%ux%u", format.mName, side, side);
+            if (!pSuite.selected(bench))
+                continue;
+
+            fg::Image image(side, side, format.mFormat, format.mType);
+            vector<unsigned char> data(image.size());
+            for (auto& v : data)
+                v = (unsigned char)rand();
+
+            pSuite.run(bench, "pixels", (double)side * side, [&] {
+                copyToBuffer(GL_PIXEL_UNPACK_BUFFER, image.pbo(), data.data(), image.size());
+                pWindow.draw(image);
+                sync();
+            });
+        }
+    }
+}
+
+static void benchText(Suite& pSuite, fg::Window& pWindow)
+{
+    if (!pSuite.selected("text/chart_labels"))
+        return;
+
+    fg::Chart chart(FG_CHART_2D);
+    chart.setAxesLimits(-123456.0f, 123456.0f, -123456.0f, 123456.0f);
+    chart.setAxesTitles("a rather long title of the horizontal axis of this chart",
+                        "a rather long title of the vertical axis of this chart");
+
+    /* each glyph is a draw call of the text pass, the
+     * profiler tells how many glyphs are drawn per frame */
+    pWindow.setProfiling(true);
+    Result* result = pSuite.run("text/chart_labels", "glyphs", 0.0, [&] {
+        pWindow.draw(chart);
+        sync();
+    });
+    for (int i = 0; i < 8; ++i)
+        pWindow.draw(chart);
+    sync();
+    pWindow.draw(chart);
+    result->mWork = pWindow.frameStats().mDrawCalls[FG_STAT_TEXT];
+    pWindow.setProfiling(false);
+}
+
+static void benchReadback(Suite& pSuite, fg::Window& pWindow)
+{
+    const size_t bytes = (size_t)WIDTH * HEIGHT * 4;
+    vector<unsigned char> pixels(bytes);
+
+    pSuite.run("readback/read_pixels", "bytes", (double)bytes, [&] {
+        glReadPixels(0, 0, WIDTH, HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    });
+
+    const char* file = "forge_bench_readback.bmp";
+    if (pSuite.run("readback/save_bmp", "frames", 1.0, [&] { pWindow.saveFrameBuffer(file); }))
+        remove(file);
+}
+
+static void benchUtil(Suite& pSuite, fg::Window&)
+{
+    static const char* const BENCHES[] = {"util/bounds", "util/histogram", "util/convert_u8",
+                                          "util/deinterleave", "util/interleave"};
+    const size_t count = 1 << 24;
+
+    /* skip allocating inputs when the filter leaves nothing to run */
+    if (none_of(begin(BENCHES), end(BENCHES),
+                [&](const char* pName) { return pSuite.selected(pName); }))
+        return;
+
+    vector<float> data(2 * count);
+    fillRandom(data, 0.0f, 1.0f);
+    vector<float> xs(count), ys(count);
+    float* planes[] = {xs.data(), ys.data()};
+    vector<unsigned char> bytes(count);
+    for (size_t i = 0; i < count; ++i)
+        bytes[i] = (unsigned char)(i * 2654435761u >> 24);
+
+    float bmin[2], bmax[2];
+    pSuite.run("util/bounds", "elements", 2.0 * count, [&] {
+        fg::util::bounds(bmin, bmax, data.data(), count, 2);
+    });
+
+    vector<int> bins(256);
+    pSuite.run("util/histogram", "elements", (double)count, [&] {
+        fg::util::histogram(bins.data(), fg::s32, 256, data.data(), count, 0.0f, 1.0f);
+    });
+
+    pSuite.run("util/convert_u8", "elements", (double)count, [&] {
+        fg::util::convert(xs.data(), bytes.data(), count);
+    });
+
+    pSuite.run("util/deinterleave", "elements", 2.0 * count, [&] {
+        fg::util::deinterleave(planes, data.data(), 2, count);
+    });
+
+    pSuite.run("util/interleave", "elements", 2.0 * count, [&] {
+        fg::util::interleave(data.data(), planes, 2, count);
+    });
+}
+
+int main(int argc, char* argv[])
+{
+    string output;
+    string filter;
+    int warmup      = 3;
+    int repetitions = 10;
+
+    for (int i = 1; i < argc; ++i) {
+        const string arg(argv[i]);
+        if (arg == "--output" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            warmup = max(0, atoi(argv[++i]));
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            repetitions = max(1, atoi(argv[++i]));
+        } else if (arg == "--software") {
+#ifdef OS_WIN
+            _putenv_s("GALLIUM_DRIVER", "llvmpipe");
+#else
+            setenv("LIBGL_ALWAYS_SOFTWARE", "1", 1);
+            setenv("GALLIUM_DRIVER", "llvmpipe", 1);
+#endif
+        } else {
+            cerr << "usage: " << argv[0] << " [--output file] [--filter substring]"
+                 << " [--warmup count] [--repetitions count] [--software]" << endl;
+            return 1;
+        }
+    }
+
+    try {
+        fg::Window wnd(WIDTH, HEIGHT, "forge_bench", 0, true);
+        wnd.makeCurrent();
+
+        Suite suite(filter, warmup, repetitions);
+        benchSetup(suite, wnd);
+        benchUploads(suite, wnd);
+#if defined(FG_BENCH_CUDA)
+        benchInteropUploads(suite, wnd);
+#endif
+        benchPlots(suite, wnd);
+        benchHistograms(suite, wnd);
+        benchSurfaces(suite, wnd);
+        benchImages(suite, wnd);
+        benchText(suite, wnd);
+        benchReadback(suite, wnd);
+        benchUtil(suite, wnd);
+
+        if (output.empty()) {
+            suite.write(cout);
+        } else {
+            ofstream file(output.c_str());
+            suite.write(file);
+        }
+    } catch (const fg::Error& err) {
+        cerr << "forge_bench: " << err.what() << endl;
+        return 1;
+    }
+    return 0;
+}
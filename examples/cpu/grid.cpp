@@ -0,0 +1,114 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <forge.h>
+#define USE_FORGE_CPU_COPY_HELPERS
+#include <ComputeCopy.h>
+#include <cmath>
+#include <vector>
+#include <iostream>
+
+const unsigned DIMX     = 1000;
+const unsigned DIMY     = 500;
+const unsigned NPOINTS  = 200;
+
+const float FRANGE_START = 0.f;
+const float FRANGE_END   = 2.f * 3.1415926f;
+
+using namespace std;
+
+void sineWave(std::vector<float>& pOut, const float pPhase)
+{
+    const float dx = (FRANGE_END - FRANGE_START) / (NPOINTS - 1);
+    for (unsigned i = 0; i < NPOINTS; ++i) {
+        float x = FRANGE_START + i * dx;
+        pOut[2*i+0] = x;
+        pOut[2*i+1] = sinf(x + pPhase);
+    }
+}
+
+/* sum of the pixels of left half of the back buffer,
+ * which holds the cell whose plot changes every frame */
+unsigned long long leftCellChecksum(const fg::Window& pWindow)
+{
+    const int w = pWindow.width() / 2;
+    const int h = pWindow.height();
+    std::vector<unsigned char> pixels(4 * w * h);
+    glReadBuffer(GL_BACK);
+    glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    unsigned long long sum = 0;
+    for (size_t i = 0; i < pixels.size(); ++i)
+        sum = sum * 31 + pixels[i];
+    return sum;
+}
+
+int main(void)
+{
+    std::vector<float> wave(2 * NPOINTS);
+    std::vector<float> still(2 * NPOINTS);
+    sineWave(still, 0.0f);
+
+    /*
+     * First Forge call should be a window creation call
+     * so that necessary OpenGL context is created for any
+     * other fg::* object to be created successfully
+     */
+    fg::Window wnd(DIMX, DIMY, "Grid Demo");
+    wnd.makeCurrent();
+
+    /*
+     * Split the window into grid regions
+     */
+    wnd.grid(1, 2);
+
+    fg::Chart moving(FG_CHART_2D);
+    moving.setAxesLimits(FRANGE_START, FRANGE_END, -1.0f, 1.0f);
+    fg::Plot wavePlot = moving.plot(NPOINTS, fg::f32);
+    wavePlot.setColor(FG_RED);
+
+    fg::Chart fixed(FG_CHART_2D);
+    fixed.setAxesLimits(FRANGE_START, FRANGE_END, -1.0f, 1.0f);
+    fg::Plot stillPlot = fixed.plot(NPOINTS, fg::f32);
+    stillPlot.setColor(FG_BLUE);
+
+    GfxHandle* handles[2];
+    createGLBuffer(&handles[0], wavePlot.vertices(), FORGE_VBO);
+    createGLBuffer(&handles[1], stillPlot.vertices(), FORGE_VBO);
+
+    copyToGLBuffer(handles[1], (ComputeResourceHandle)still.data(), stillPlot.verticesSize());
+
+    /* the left cell is updated through the buffer only, without
+     * marking the plot dirty, and has to change on screen anyway */
+    unsigned frame = 0;
+    unsigned long long previous = 0;
+    do {
+        sineWave(wave, 0.05f * frame);
+        copyToGLBuffer(handles[0], (ComputeResourceHandle)wave.data(), wavePlot.verticesSize());
+
+        wnd.draw(0, 0, moving, "Updated every frame");
+        wnd.draw(1, 0, fixed, "Static");
+
+        unsigned long long checksum = leftCellChecksum(wnd);
+        if (frame > 0 && checksum == previous) {
+            std::cerr << "Grid cell did not change after its buffer was updated\n";
+            releaseGLBuffer(handles[0]);
+            releaseGLBuffer(handles[1]);
+            return 1;
+        }
+        previous = checksum;
+        ++frame;
+
+        wnd.swapBuffers();
+    } while(!wnd.close());
+
+    releaseGLBuffer(handles[0]);
+    releaseGLBuffer(handles[1]);
+
+    return 0;
+}
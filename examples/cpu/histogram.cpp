@@ -224,14 +224,12 @@ void kernel(Bitmap& bmp)
 
 void populateBins(Bitmap& bmp, int *hist_array, const unsigned nbins, float *hist_cols)
 {
-    for (unsigned y=0; y<bmp.height; ++y) {
-        for (unsigned x=0; x<bmp.width; ++x) {
-            int offset  = x + y * bmp.width;
-            unsigned char noiseVal = bmp.ptr[offset*4];
-            unsigned idx = (int)((float)noiseVal/255.f * nbins);
-            hist_array[idx]++;
-        }
-    }
+    /* red channel of every pixel, normalized to [0, 1] */
+    const size_t count = 4 * bmp.width * bmp.height;
+    std::vector<float> pixels(count);
+    fg::util::convert(pixels.data(), bmp.ptr, count);
+    fg::util::histogram(hist_array, fg::s32, nbins, pixels.data(),
+                        bmp.width * bmp.height, 0.0f, 1.0f, 4);
 
     for (unsigned b=0; b<nbins; ++b) {
         hist_cols[3*b+0] = std::rand()/(float)RAND_MAX;
@@ -38,6 +38,20 @@ extern "C" {
 
 #endif
 
+/* Copies issue OpenGL calls on the calling thread, which needs a current
+ * context. For windows in threaded mode, see fg::Window::setThreaded, they
+ * have to be made from tasks queued using fg::Window::submit */
+
+/* Copies show up in the trace of Forge, see fg::TraceScope,
+ * when FG_ENABLE_TRACING is defined before including this file */
+#if defined(FG_ENABLE_TRACING)
+#define FORGE_TRACE_BEGIN(pName) fg_trace_begin(pName)
+#define FORGE_TRACE_END()        fg_trace_end()
+#else
+#define FORGE_TRACE_BEGIN(pName)
+#define FORGE_TRACE_END()
+#endif
+
 
 /** A backend-agnostic handle to a compute memory resource originating from an OpenGL resource.
 
@@ -70,6 +84,7 @@ typedef enum {
 typedef struct {
     GfxResourceHandle mId;
     BufferType mTarget;
+    size_t mOffset;     ///< Offset in bytes at which copies start, see fg::arena
 } GfxHandle;
 
 
@@ -78,16 +93,24 @@ typedef struct {
 #if defined(USE_FORGE_CPU_COPY_HELPERS)
 
 static
-void createGLBuffer(GfxHandle** pOut, const unsigned pResourceId, const BufferType pTarget)
+void createGLBufferAt(GfxHandle** pOut, const unsigned pResourceId, const BufferType pTarget,
+                      const size_t pOffset)
 {
     GfxHandle* temp = (GfxHandle*)malloc(sizeof(GfxHandle));
 
     temp->mId = pResourceId;
     temp->mTarget = pTarget;
+    temp->mOffset = pOffset;
 
     *pOut = temp;
 }
 
+static
+void createGLBuffer(GfxHandle** pOut, const unsigned pResourceId, const BufferType pTarget)
+{
+    createGLBufferAt(pOut, pResourceId, pTarget, 0);
+}
+
 static
 void releaseGLBuffer(GfxHandle* pHandle)
 {
@@ -97,13 +120,17 @@ void releaseGLBuffer(GfxHandle* pHandle)
 static
 void copyToGLBuffer(GfxHandle* pGLDestination, ComputeResourceHandle  pSource, const size_t pSize)
 {
+    FORGE_TRACE_BEGIN("copyToGLBuffer");
+
     GfxHandle* temp = pGLDestination;
 
     GLenum target = (temp->mTarget==FORGE_PBO ? GL_PIXEL_UNPACK_BUFFER : GL_ARRAY_BUFFER);
 
     glBindBuffer(target, temp->mId);
-    glBufferSubData(target, 0, pSize, pSource);
+    glBufferSubData(target, temp->mOffset, pSize, pSource);
     glBindBuffer(target, 0);
+
+    FORGE_TRACE_END();
 }
 #endif
 
@@ -122,23 +149,39 @@ static void handleCUDAError(cudaError_t err, const char *file, int line)
 #define FORGE_CUDA_CHECK(err) (handleCUDAError(err, __FILE__, __LINE__ ))
 
 static
-void createGLBuffer(GfxHandle** pOut, const unsigned pResourceId, const BufferType pTarget)
+void registerGLBuffer(GfxHandle** pOut, const unsigned pResourceId, const BufferType pTarget,
+                      const size_t pOffset, const unsigned pFlags)
 {
     GfxHandle* temp = (GfxHandle*)malloc(sizeof(GfxHandle));
 
     temp->mTarget = pTarget;
+    temp->mOffset = pOffset;
 
     cudaGraphicsResource *cudaPBOResource;
 
     FORGE_CUDA_CHECK(cudaGraphicsGLRegisterBuffer(&cudaPBOResource,
                                                   pResourceId,
-                                                  cudaGraphicsMapFlagsWriteDiscard));
+                                                  pFlags));
 
     temp->mId = cudaPBOResource;
 
     *pOut = temp;
 }
 
+static
+void createGLBuffer(GfxHandle** pOut, const unsigned pResourceId, const BufferType pTarget)
+{
+    registerGLBuffer(pOut, pResourceId, pTarget, 0, cudaGraphicsMapFlagsWriteDiscard);
+}
+
+/* Rest of the buffer belongs to others, hence it is not discarded */
+static
+void createGLBufferAt(GfxHandle** pOut, const unsigned pResourceId, const BufferType pTarget,
+                      const size_t pOffset)
+{
+    registerGLBuffer(pOut, pResourceId, pTarget, pOffset, cudaGraphicsMapFlagsNone);
+}
+
 static
 void releaseGLBuffer(GfxHandle* pHandle)
 {
@@ -149,6 +192,8 @@ void releaseGLBuffer(GfxHandle* pHandle)
 static
 void copyToGLBuffer(GfxHandle* pGLDestination, ComputeResourceHandle  pSource, const size_t pSize)
 {
+    FORGE_TRACE_BEGIN("copyToGLBuffer");
+
     size_t numBytes;
     void* pointer = NULL;
 
@@ -158,9 +203,12 @@ void copyToGLBuffer(GfxHandle* pGLDestination, ComputeResourceHandle  pSource, c
 
     FORGE_CUDA_CHECK(cudaGraphicsResourceGetMappedPointer(&pointer, &numBytes, cudaResource));
 
-    FORGE_CUDA_CHECK(cudaMemcpy(pointer, pSource, numBytes, cudaMemcpyDeviceToDevice));
+    FORGE_CUDA_CHECK(cudaMemcpy((char*)pointer + pGLDestination->mOffset, pSource,
+                                pSize, cudaMemcpyDeviceToDevice));
 
     FORGE_CUDA_CHECK(cudaGraphicsUnmapResources(1, &cudaResource, 0));
+
+    FORGE_TRACE_END();
 }
 #endif
 
@@ -180,11 +228,13 @@ void copyToGLBuffer(GfxHandle* pGLDestination, ComputeResourceHandle  pSource, c
     }
 
 static
-void createGLBuffer(GfxHandle** pOut, const unsigned pResourceId, const BufferType pTarget)
+void createGLBufferAt(GfxHandle** pOut, const unsigned pResourceId, const BufferType pTarget,
+                      const size_t pOffset)
 {
     GfxHandle* temp = (GfxHandle*)malloc(sizeof(GfxHandle));
 
     temp->mTarget = pTarget;
+    temp->mOffset = pOffset;
 
     cl_int returnCode = CL_SUCCESS;
 
@@ -195,6 +245,12 @@ void createGLBuffer(GfxHandle** pOut, const unsigned pResourceId, const BufferTy
     *pOut = temp;
 }
 
+static
+void createGLBuffer(GfxHandle** pOut, const unsigned pResourceId, const BufferType pTarget)
+{
+    createGLBufferAt(pOut, pResourceId, pTarget, 0);
+}
+
 static
 void releaseGLBuffer(GfxHandle* pHandle)
 {
@@ -205,6 +261,8 @@ void releaseGLBuffer(GfxHandle* pHandle)
 static
 void copyToGLBuffer(GfxHandle* pGLDestination, ComputeResourceHandle  pSource, const size_t pSize)
 {
+    FORGE_TRACE_BEGIN("copyToGLBuffer");
+
     // The user is expected to implement a function
     // `cl_command_queue getCommandQueue()`
     cl_command_queue queue = getCommandQueue();
@@ -222,7 +280,8 @@ void copyToGLBuffer(GfxHandle* pGLDestination, ComputeResourceHandle  pSource, c
     FORGE_OCL_CHECK(clWaitForEvents(1, &waitEvent),
                     "Failed in clWaitForEvents after clEnqueueAcquireGLObjects");
 
-    FORGE_OCL_CHECK(clEnqueueCopyBuffer(queue, src, dst, 0, 0, pSize, 0, NULL, &waitEvent),
+    FORGE_OCL_CHECK(clEnqueueCopyBuffer(queue, src, dst, 0, pGLDestination->mOffset, pSize,
+                                        0, NULL, &waitEvent),
                     "Failed in clEnqueueCopyBuffer");
 
     FORGE_OCL_CHECK(clEnqueueReleaseGLObjects(queue, 1, &dst, 0, NULL, &waitEvent),
@@ -230,6 +289,8 @@ void copyToGLBuffer(GfxHandle* pGLDestination, ComputeResourceHandle  pSource, c
 
     FORGE_OCL_CHECK(clWaitForEvents(1, &waitEvent),
                     "Failed in clWaitForEvents after clEnqueueReleaseGLObjects");
+
+    FORGE_TRACE_END();
 }
 
 #pragma GCC diagnostic pop
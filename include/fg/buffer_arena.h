@@ -0,0 +1,85 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#pragma once
+
+#include <fg/defines.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+FGAPI fg_err fg_set_buffer_arena(const bool pEnable);
+
+FGAPI fg_err fg_defragment_buffer_arena();
+
+FGAPI fg_err fg_get_buffer_arena_stats(fg_buffer_arena_stats* pOut);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#ifdef __cplusplus
+
+namespace fg
+{
+
+/**
+   \brief Shared storage for the vertex buffers of many small renderables
+
+   Plots created while the arena is enabled take their vertex, color, alpha
+   and marker size buffers out of a few large OpenGL buffer objects instead
+   of creating their own. Dashboards with thousands of plots then create and
+   destroy them cheaply and keep the number of OpenGL objects low.
+
+   Such buffers share an OpenGL buffer object with other plots, so they
+   start at the offset given by Plot::offset. Copies into them have to be
+   done at that offset, using createGLBufferAt of ComputeCopy.h or
+   Window::uploadAsync, and only one of them can be mapped at a time.
+   All windows have to share the context that was current when the plots
+   were created.
+ */
+namespace arena
+{
+
+/**
+   Turn the arena on or off for plots created from now on
+
+   Plots keep the storage they were created with. This value defaults to false
+
+   \param[in] pEnable is true to take storage of new plots from the arena
+ */
+FGAPI void enable(const bool pEnable);
+
+/**
+   Move buffers of the arena into as few OpenGL buffer objects as they fit in
+
+   Creating and destroying many plots leaves gaps in the arena, this call
+   closes them. Moved buffers get another OpenGL buffer object and offset,
+   hence handles created by the application for them, see ComputeCopy.h,
+   have to be created again using Plot::vertices and Plot::offset.
+   No buffer of the arena may be mapped and the context that owns the
+   arena has to be current on the calling thread.
+ */
+FGAPI void defragment();
+
+/**
+   Get usage of the arena
+
+   \return number and size of buffer objects, blocks and free ranges
+ */
+FGAPI BufferArenaStats stats();
+
+}
+
+}
+
+#endif
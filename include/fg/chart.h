@@ -12,6 +12,7 @@
 #include <fg/defines.h>
 #include <fg/image.h>
 #include <fg/plot.h>
+#include <fg/plot_collection.h>
 #include <fg/surface.h>
 #include <fg/vector_field.h>
 #include <fg/histogram.h>
@@ -36,6 +37,11 @@ FGAPI fg_err fg_set_chart_axes_limits(fg_chart pHandle,
                                       const float pYmin, const float pYmax,
                                       const float pZmin, const float pZmax);
 
+FGAPI fg_err fg_set_chart_axes_limits_f64(fg_chart pHandle,
+                                          const double pXmin, const double pXmax,
+                                          const double pYmin, const double pYmax,
+                                          const double pZmin, const double pZmax);
+
 FGAPI fg_err fg_set_chart_legend_position(fg_chart pHandle, const float pX, const float pY);
 
 FGAPI fg_err fg_add_image_to_chart(fg_image* pImage, fg_chart pHandle,
@@ -50,6 +56,12 @@ FGAPI fg_err fg_add_plot_to_chart(fg_plot* pPlot, fg_chart pHandle,
                                   const uint pNPoints, const fg_dtype pType,
                                   const fg_plot_type pPlotType, const fg_marker_type pMarkerType);
 
+FGAPI fg_err fg_add_plot_collection_to_chart(fg_plot_collection* pCollection, fg_chart pHandle,
+                                             const uint pNSeries, const uint pNPoints,
+                                             const fg_dtype pType,
+                                             const fg_plot_type pPlotType,
+                                             const fg_marker_type pMarkerType);
+
 FGAPI fg_err fg_add_surface_to_chart(fg_surface* pSurface, fg_chart pHandle,
                                      const uint pXPoints, const uint pYPoints, const fg_dtype pType,
                                      const fg_plot_type pPlotType, const fg_marker_type pMarkerType);
@@ -127,6 +139,25 @@ class Chart {
                                  const float pYmin, const float pYmax,
                                  const float pZmin=-1, const float pZmax=1);
 
+        /**
+           Set axes data ranges in double precision
+
+           Use this for data that needs more precision than float, such as
+           time stamps in nanoseconds, along with plots of type f64. Such plots
+           are drawn relative to an origin close to the center of these ranges,
+           hence their position is accurate at any zoom level.
+
+           \param[in] pXmin is x-axis minimum data value
+           \param[in] pXmax is x-axis maximum data value
+           \param[in] pYmin is y-axis minimum data value
+           \param[in] pYmax is y-axis maximum data value
+           \param[in] pZmin is z-axis minimum data value
+           \param[in] pZmax is z-axis maximum data value
+         */
+        FGAPI void setAxesLimitsF64(const double pXmin, const double pXmax,
+                                    const double pYmin, const double pYmax,
+                                    const double pZmin=-1, const double pZmax=1);
+
         /**
            Set legend position for Chart
 
@@ -159,6 +190,13 @@ class Chart {
          */
         FGAPI void add(const Plot& pPlot);
 
+        /**
+           Add an existing PlotCollection object to the current chart
+
+           \param[in] pCollection is the PlotCollection to render on the chart
+         */
+        FGAPI void add(const PlotCollection& pCollection);
+
         /**
            Add an existing Surface object to the current chart
 
@@ -202,6 +240,22 @@ class Chart {
         FGAPI Plot plot(const uint pNumPoints, const dtype pDataType,
                         const PlotType pPlotType=FG_PLOT_LINE, const MarkerType pMarkerType=FG_MARKER_NONE);
 
+        /**
+           Create and add a PlotCollection object to the current chart
+
+           \param[in] pNumSeries is number of series in the collection
+           \param[in] pNumPoints is maximum number of data points per series
+           \param[in] pDataType takes one of the values of \ref dtype that indicates
+                      the integral data type of plot data
+           \param[in] pPlotType dictates the type of plot/graph,
+                      it can take one of the values of \ref PlotType
+           \param[in] pMarkerType indicates which symbol is rendered as marker. It can take one of
+                      the values of \ref MarkerType.
+         */
+        FGAPI PlotCollection plots(const uint pNumSeries, const uint pNumPoints, const dtype pDataType,
+                                   const PlotType pPlotType=FG_PLOT_LINE,
+                                   const MarkerType pMarkerType=FG_MARKER_NONE);
+
         /**
            Create and add an Plot object to the current chart
 
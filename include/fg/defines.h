@@ -54,13 +54,53 @@ typedef void* fg_chart;
 typedef void* fg_image;
 typedef void* fg_histogram;
 typedef void* fg_plot;
+typedef void* fg_plot_collection;
 typedef void* fg_surface;
 typedef void* fg_vector_field;
+typedef void* fg_tiled_image;
+typedef void* fg_scheduler;
 
 typedef unsigned int    uint;
 typedef unsigned short  ushort;
 typedef unsigned char   uchar;
 
+/**
+   Function that fills the pixels of a tile of a TiledImage
+
+   \param[out] pTileData is the memory to which pixels are to be written, tightly
+               packed in row major order
+   \param[in] pLevel is the pyramid level of the tile, level zero being the full
+              resolution image and each following level half the size of previous level
+   \param[in] pTileX is the column index of the tile in the level
+   \param[in] pTileY is the row index of the tile in the level
+   \param[in] pTileWidth is the number of valid pixels along a row of the tile
+   \param[in] pTileHeight is the number of valid rows in the tile
+   \param[in] pUserData is the pointer provided while creating the TiledImage
+ */
+typedef void (*fg_tile_loader)(void* pTileData, const uint pLevel,
+                               const uint pTileX, const uint pTileY,
+                               const uint pTileWidth, const uint pTileHeight,
+                               void* pUserData);
+
+/**
+   Task executed on the render thread of a window in threaded mode
+
+   Changes to charts and renderables that are drawn by a render thread,
+   axes limits for example, should be made from such a task.
+
+   \param[in] pUserData is the pointer provided while submitting the task
+ */
+typedef void (*fg_window_task)(void* pUserData);
+
+/**
+   Frame callback invoked by the event loop of a window, see fg_run_window
+
+   \param[in] pUserData is the pointer provided while starting the event loop
+
+   \return false to leave the event loop, true otherwise
+ */
+typedef bool (*fg_frame_callback)(void* pUserData);
+
 typedef enum {
     FG_ERR_NONE           = 0,              ///< Fuction returned successfully.
     /*
@@ -126,9 +166,27 @@ typedef enum {
     FG_RGB       = 300,                     ///< Three(Red, Green & Blue) channels
     FG_BGR       = 301,                     ///< Three(Red, Green & Blue) channels
     FG_RGBA      = 400,                     ///< Four(Red, Green, Blue & Alpha) channels
-    FG_BGRA      = 401                      ///< Four(Red, Green, Blue & Alpha) channels
+    FG_BGRA      = 401,                     ///< Four(Red, Green, Blue & Alpha) channels
+    FG_NV12      = 500,                     ///< Luma plane followed by interleaved half resolution chroma(U, V) plane
+    FG_YUYV      = 501,                     ///< Packed luma and chroma(Y0, U, Y1, V) for each pair of pixels
+    FG_BAYER_RGGB = 600,                    ///< Raw Bayer mosaic with red at first pixel
+    FG_BAYER_BGGR = 601,                    ///< Raw Bayer mosaic with blue at first pixel
+    FG_BAYER_GRBG = 602,                    ///< Raw Bayer mosaic with green, red in first row
+    FG_BAYER_GBRG = 603                     ///< Raw Bayer mosaic with green, blue in first row
 } fg_channel_format;
 
+typedef enum {
+    FG_FILTER_NEAREST     = 0,              ///< Nearest texel, no filtering
+    FG_FILTER_LINEAR      = 1,              ///< Bilinear filtering of full resolution image
+    FG_FILTER_TRILINEAR   = 2,              ///< Trilinear filtering over mipmaps
+    FG_FILTER_ANISOTROPIC = 3               ///< Anisotropic filtering over mipmaps, if supported
+} fg_filter_mode;
+
+typedef enum {
+    FG_YUV_BT601 = 0,                       ///< ITU-R BT.601 (SD video) limited range
+    FG_YUV_BT709 = 1                        ///< ITU-R BT.709 (HD video) limited range
+} fg_yuv_matrix;
+
 typedef enum {
     FG_CHART_2D = 2,                        ///< Two dimensional charts
     FG_CHART_3D = 3                         ///< Three dimensional charts
@@ -167,7 +225,12 @@ typedef enum {
     FG_UINT32  = 3,                                ///< Unsigned integer (32-bits)
     FG_FLOAT32 = 4,                                ///< Float (32-bits)
     FG_INT16   = 5,                                ///< Signed integer (16-bits)
-    FG_UINT16  = 6                                 ///< Unsigned integer (16-bits)
+    FG_UINT16  = 6,                                ///< Unsigned integer (16-bits)
+    FG_FLOAT16 = 7,                                ///< Half precision float (16-bits)
+    FG_UNORM8  = 8,                                ///< Unsigned byte read as a value in [0, 1]
+    FG_UNORM16 = 9,                                ///< Unsigned integer (16-bits) read as a value in [0, 1]
+    FG_SNORM16 = 10,                               ///< Signed integer (16-bits) read as a value in [-1, 1]
+    FG_FLOAT64 = 11                                ///< Double (64-bits), supported by plots only
 } fg_dtype;
 
 typedef enum {
@@ -187,17 +250,97 @@ typedef enum {
     FG_MARKER_STAR         = 7                     ///< Star symbol marker
 } fg_marker_type;
 
+typedef enum {
+    FG_LINE_JOIN_MITER     = 0,                    ///< Sharp corners, beveled past four times the line width
+    FG_LINE_JOIN_ROUND     = 1                     ///< Rounded corners and line ends
+} fg_line_join;
+
+typedef enum {
+    FG_DENSITY_NONE        = 0,                    ///< Markers drawn one by one
+    FG_DENSITY_LINEAR      = 1,                    ///< Points per pixel mapped linearly through the color map
+    FG_DENSITY_LOG         = 2                     ///< Points per pixel mapped logarithmically through the color map
+} fg_density_scale;
+
+typedef enum {
+    FG_VERTEX_BUFFER    = 0,                    ///< Vertex positions
+    FG_COLOR_BUFFER     = 1,                    ///< Per vertex colors
+    FG_ALPHA_BUFFER     = 2,                    ///< Per vertex alpha values
+    FG_RADIUS_BUFFER    = 3,                    ///< Per vertex marker sizes, plots only
+    FG_DIRECTION_BUFFER = 4,                    ///< Per vertex directions, vector fields only
+    FG_SAMPLE_BUFFER    = 5,                    ///< Bin values, histograms only
+    FG_INTERLEAVED_BUFFER = 6                   ///< Positions, rgba8 colors and marker sizes in one buffer, plots only
+} fg_buffer_type;
+
+typedef enum {
+    FG_STAT_FRAME       = 0,                    ///< Whole frame, from first draw call to buffer swap
+    FG_STAT_CHART       = 1,                    ///< Chart grids, borders and ticks
+    FG_STAT_RENDERABLE  = 2,                    ///< Images, plots, histograms, surfaces and vector fields
+    FG_STAT_TEXT        = 3,                    ///< Titles, tick labels and legends
+    FG_STAT_UPLOAD      = 4,                    ///< Pixel and tile uploads to textures
+    FG_STAT_COUNT       = 5                     ///< Number of kinds of work measured
+} fg_stat_kind;
+
+#define FG_MAX_STAT_RENDERABLES 32
+#define FG_STAT_NAME_LENGTH     64
+
+/**
+   Time spent on drawing a single renderable in a frame
+ */
+typedef struct {
+    char     mName[FG_STAT_NAME_LENGTH];        ///< Legend of renderable, if any
+    double   mCPUTime;                          ///< CPU time in milliseconds
+    double   mGPUTime;                          ///< GPU time in milliseconds
+    unsigned mDrawCalls;                        ///< Number of draw calls issued
+} fg_renderable_stats;
+
+/**
+   Breakdown of the time spent on a frame of a window
+
+   Times of each kind of work exclude the time spent in other kinds
+   nested in it, so time taken by the renderables of a chart is not
+   charged to the chart. FG_STAT_FRAME entries hold the totals.
+ */
+typedef struct {
+    unsigned long long  mFrame;                 ///< Index of the frame, counting from zero
+    double              mCPUTime[FG_STAT_COUNT];///< CPU time in milliseconds per kind of work
+    double              mGPUTime[FG_STAT_COUNT];///< GPU time in milliseconds per kind of work
+    unsigned            mDrawCalls[FG_STAT_COUNT];///< Number of draw calls per kind of work
+    unsigned long long  mUploadedBytes;         ///< Bytes uploaded to textures and buffers
+    unsigned            mRenderableCount;       ///< Number of valid entries in mRenderables
+    fg_renderable_stats mRenderables[FG_MAX_STAT_RENDERABLES];
+} fg_frame_stats;
+
+/**
+   Usage of the buffer arena that renderables take vertex storage from
+ */
+typedef struct {
+    unsigned            mSlabCount;             ///< Number of OpenGL buffer objects held by the arena
+    unsigned            mBlockCount;            ///< Number of buffers handed out to renderables
+    unsigned            mFreeRangeCount;        ///< Number of free ranges left between and after blocks
+    unsigned long long  mSlabBytes;             ///< Total size of all buffer objects in bytes
+    unsigned long long  mUsedBytes;             ///< Bytes taken by blocks, including alignment
+    unsigned long long  mLargestFreeRange;      ///< Largest block that fits without another buffer object
+    unsigned long long  mGeneration;            ///< Number of times blocks got moved by defragmentation
+} fg_buffer_arena_stats;
+
 
 #ifdef __cplusplus
 namespace fg
 {
     typedef fg_err ErrorCode;
     typedef fg_channel_format ChannelFormat;
+    typedef fg_yuv_matrix YUVMatrix;
+    typedef fg_filter_mode FilterMode;
     typedef fg_chart_type ChartType;
     typedef fg_color_map ColorMap;
     typedef fg_color Color;
     typedef fg_plot_type PlotType;
     typedef fg_marker_type MarkerType;
+    typedef fg_line_join LineJoin;
+    typedef fg_density_scale DensityScale;
+    typedef fg_buffer_type BufferKind;
+    typedef fg_frame_stats FrameStats;
+    typedef fg_buffer_arena_stats BufferArenaStats;
 
     typedef enum {
         s8  = FG_INT8,
@@ -207,6 +350,11 @@ namespace fg
         f32 = FG_FLOAT32,
         s16 = FG_INT16,
         u16 = FG_UINT16,
+        f16 = FG_FLOAT16,
+        un8 = FG_UNORM8,
+        un16 = FG_UNORM16,
+        sn16 = FG_SNORM16,
+        f64 = FG_FLOAT64,
     } dtype;
 }
 #endif
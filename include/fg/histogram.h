@@ -39,6 +39,20 @@ FGAPI fg_err fg_get_histogram_cbo_size(uint* out, const fg_histogram pHistogram)
 
 FGAPI fg_err fg_get_histogram_abo_size(uint* out, const fg_histogram pHistogram);
 
+FGAPI fg_err fg_set_histogram_sample_binning(fg_histogram pHistogram, const uint pNumSamples,
+                                             const float pMinValue, const float pMaxValue,
+                                             const bool pNormalize, const bool pCumulative);
+
+FGAPI fg_err fg_get_histogram_sbo(uint* out, const fg_histogram pHistogram);
+
+FGAPI fg_err fg_get_histogram_sbo_size(uint* out, const fg_histogram pHistogram);
+
+FGAPI fg_err fg_map_histogram_buffer(void** pOut, fg_histogram pHistogram, const fg_buffer_type pBuffer);
+
+FGAPI fg_err fg_unmap_histogram_buffer(fg_histogram pHistogram, const fg_buffer_type pBuffer);
+
+FGAPI fg_err fg_mark_histogram_dirty(fg_histogram pHistogram);
+
 #ifdef __cplusplus
 }
 #endif
@@ -153,6 +167,72 @@ class Histogram {
          */
         FGAPI uint alphasSize() const;
 
+        /**
+           Enable binning of raw samples on the GPU
+
+           Once enabled, the samples written to the buffer returned by
+           Histogram::samples() are sorted into bins on every render and
+           the resulting frequencies are written to Histogram::vertices().
+           Samples outside of [pMinValue, pMaxValue] are ignored.
+           This mode is only supported for histograms of type f32.
+
+           \param[in] pNumSamples is the number of float samples
+           \param[in] pMinValue is the lower limit of the binning range
+           \param[in] pMaxValue is the upper limit of the binning range
+           \param[in] pNormalize when true, frequencies are divided by pNumSamples
+           \param[in] pCumulative when true, each bin holds the sum of frequencies
+                      of itself and all the bins before it
+         */
+        FGAPI void setSampleBinning(const uint pNumSamples,
+                                    const float pMinValue, const float pMaxValue,
+                                    const bool pNormalize=false,
+                                    const bool pCumulative=false);
+
+        /**
+           Get the OpenGL buffer object identifier for raw samples
+
+           \return OpenGL VBO resource id, zero if sample binning is not enabled.
+         */
+        FGAPI uint samples() const;
+
+        /**
+           Get the OpenGL Vertex Buffer Object resource size
+
+           \return samples buffer object size in bytes
+         */
+        FGAPI uint samplesSize() const;
+
+        /**
+           Map one of the histogram buffers for writing from host
+
+           The previous contents of the buffer are discarded, hence the whole
+           buffer has to be written before it is unmapped. The returned pointer
+           is write only and stays valid until unmap is called. The window
+           context has to be current on the calling thread.
+
+           \param[in] pBuffer is one of FG_VERTEX_BUFFER, FG_COLOR_BUFFER, FG_ALPHA_BUFFER or, once sample binning is
+                      enabled, FG_SAMPLE_BUFFER
+
+           \return pointer to the mapped buffer
+         */
+        FGAPI void* map(const BufferKind pBuffer=FG_VERTEX_BUFFER);
+
+        /**
+           Unmap buffer previously mapped using Histogram::map
+
+           \param[in] pBuffer is the buffer kind passed to Histogram::map
+         */
+        FGAPI void unmap(const BufferKind pBuffer=FG_VERTEX_BUFFER);
+
+        /**
+           Inform that contents of histogram buffers were changed by the user
+
+           Windows that render on demand redraw the histogram only after this call
+           when its buffers are written using OpenGL or compute interop. Calls to
+           Histogram::unmap take care of it already.
+         */
+        FGAPI void markDirty();
+
         /**
            Get the handle to internal implementation of Histogram
          */
@@ -26,6 +26,21 @@ FGAPI fg_err fg_set_image_alpha(fg_image pImage, const float pAlpha);
 
 FGAPI fg_err fg_set_image_aspect_ratio(fg_image pImage, const bool pKeepRatio);
 
+FGAPI fg_err fg_set_image_value_range(fg_image pImage, const float pMin, const float pMax,
+                                      const float pGamma, const bool pLogScale);
+
+FGAPI fg_err fg_set_image_filter(fg_image pImage, const fg_filter_mode pFilter);
+
+FGAPI fg_err fg_set_image_yuv_matrix(fg_image pImage, const fg_yuv_matrix pMatrix);
+
+FGAPI fg_err fg_set_image_colormap(fg_image pImage, const float* pRGBA, const size_t pLength);
+
+FGAPI fg_err fg_mark_image_dirty(fg_image pImage);
+
+FGAPI fg_err fg_map_image_pbo(void** pOut, fg_image pImage);
+
+FGAPI fg_err fg_unmap_image_pbo(fg_image pImage);
+
 FGAPI fg_err fg_get_image_width(uint *pOut, const fg_image pImage);
 
 FGAPI fg_err fg_get_image_height(uint *pOut, const fg_image pImage);
@@ -73,6 +88,11 @@ class Image {
                       of \ref ChannelFormat
            \param[in] pDataType takes one of the values of \ref dtype that indicates
                       the integral data type of histogram data
+
+           \note YUV formats, \ref FG_NV12 and \ref FG_YUYV, take only u8 data and
+           even dimensions. Bayer formats take u8 or u16 data. These formats are
+           converted to RGB while rendering, hence the pixel buffer holds the frame
+           as produced by the camera.
          */
         FGAPI Image(const uint pWidth, const uint pHeight,
                     const ChannelFormat pFormat=FG_RGBA, const dtype pDataType=f32);
@@ -103,6 +123,91 @@ class Image {
          */
         FGAPI void keepAspectRatio(const bool pKeep);
 
+        /**
+           Set the range of pixel values that is mapped onto the colormap
+
+           Pixel values are given in the units of the image data type, i.e. [0, 65535]
+           covers the entire range of an u16 image. The mapping happens while
+           rendering, hence the range can be changed on every frame without
+           uploading the pixels again. By default, the range is [0, 1] for f32 images
+           and the entire range of the data type for other types.
+
+           \param[in] pMin is the value mapped to the first color of colormap
+           \param[in] pMax is the value mapped to the last color of colormap
+           \param[in] pGamma is the exponent applied to the normalized value,
+                      values less than one brighten the darker regions of image
+           \param[in] pLogScale when true maps the value t normalized to [0, 1] by the
+                      range using log(1 + 1000 t) / log(1 + 1000) instead of a linear
+                      ramp, the mapping is independent of the units of data
+         */
+        FGAPI void setValueRange(const float pMin, const float pMax,
+                                 const float pGamma=1.0f, const bool pLogScale=false);
+
+        /**
+           Set the filtering used when image is magnified or minified on screen
+
+           Mipmap based modes rebuild the mip chain after every upload of pixel data,
+           which avoids aliasing when a large image is shown in a small viewport.
+           Integer(s32, u32) images are always sampled without interpolation,
+           and YUYV and Bayer images are not mipmapped. Default is \ref FG_FILTER_NEAREST.
+
+           \param[in] pFilter is one of the values of \ref FilterMode
+         */
+        FGAPI void setFilter(const FilterMode pFilter);
+
+        /**
+           Set the matrix used to convert YUV pixels to RGB
+
+           This setting is used only by images of \ref FG_NV12 and \ref FG_YUYV formats.
+           BT.601 is used by default.
+
+           \param[in] pMatrix is one of the values of \ref YUVMatrix
+         */
+        FGAPI void setYUVMatrix(const YUVMatrix pMatrix);
+
+        /**
+           Set a colormap for this Image alone, overriding the colormap of Window
+
+           \param[in] pRGBA is the array of \p pLength colors, each color being
+                      four floating point values (red, green, blue, alpha) in [0, 1].
+                      Passing null reverts to the colormap of Window.
+           \param[in] pLength is the number of colors in the colormap
+         */
+        FGAPI void setColorMap(const float* pRGBA, const size_t pLength);
+
+        /**
+           Inform that the pixel buffer object has new data
+
+           By default, the pixel data is uploaded to the texture on every render.
+           Once this function is called, the upload happens only on the first
+           render after the image is marked dirty. Images that do not change
+           thereby cost no upload bandwidth.
+
+           In this mode the contents of Image::pbo() are copied to an internal
+           buffer on upload, so that the next frame can be filled while the
+           previous upload is in flight. Image::pbo() keeps returning the same
+           buffer, hence it can be registered with compute interop once.
+         */
+        FGAPI void markDirty();
+
+        /**
+           Map the pixel buffer object for writing from host
+
+           Pixels written to the returned pointer reach the texture on the next
+           render after Image::unmap. The previous contents of the buffer are
+           discarded, hence all Image::size() bytes have to be written. The
+           pointer is write only and the window context has to be current on
+           the calling thread.
+
+           \return pointer to the mapped pixel buffer
+         */
+        FGAPI void* map();
+
+        /**
+           Unmap the pixel buffer object and mark the image dirty
+         */
+        FGAPI void unmap();
+
         /**
            Get Image width
            \return image width
@@ -130,7 +235,7 @@ class Image {
         /**
            Get the OpenGL Pixel Buffer Object identifier
 
-           \return OpenGL PBO resource id.
+           \return OpenGL PBO resource id to which the next frame is to be written.
          */
         FGAPI uint pbo() const;
 
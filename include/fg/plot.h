@@ -32,6 +32,12 @@ FGAPI fg_err fg_set_plot_legend(fg_plot pPlot, const char* pLegend);
 
 FGAPI fg_err fg_set_plot_marker_size(fg_plot pPlot, const float pMarkerSize);
 
+FGAPI fg_err fg_set_plot_line_width(fg_plot pPlot, const float pLineWidth);
+
+FGAPI fg_err fg_set_plot_line_join(fg_plot pPlot, const fg_line_join pLineJoin);
+
+FGAPI fg_err fg_set_plot_density(fg_plot pPlot, const fg_density_scale pScale);
+
 FGAPI fg_err fg_get_plot_vbo(uint* pOut, const fg_plot pPlot);
 
 FGAPI fg_err fg_get_plot_cbo(uint* pOut, const fg_plot pPlot);
@@ -48,6 +54,18 @@ FGAPI fg_err fg_get_plot_abo_size(uint* pOut, const fg_plot pPlot);
 
 FGAPI fg_err fg_get_plot_mbo_size(uint* pOut, const fg_plot pPlot);
 
+FGAPI fg_err fg_get_plot_interleaved_buffer(uint* pOut, const fg_plot pPlot);
+
+FGAPI fg_err fg_get_plot_interleaved_buffer_size(uint* pOut, const fg_plot pPlot);
+
+FGAPI fg_err fg_get_plot_buffer_offset(uint* pOut, const fg_plot pPlot, const fg_buffer_type pBuffer);
+
+FGAPI fg_err fg_map_plot_buffer(void** pOut, fg_plot pPlot, const fg_buffer_type pBuffer);
+
+FGAPI fg_err fg_unmap_plot_buffer(fg_plot pPlot, const fg_buffer_type pBuffer);
+
+FGAPI fg_err fg_mark_plot_dirty(fg_plot pPlot);
+
 #ifdef __cplusplus
 }
 #endif
@@ -79,6 +97,12 @@ class Plot {
                       it can take one of the values of \ref PlotType
            \param[in] pMarkerType indicates which symbol is rendered as marker. It can take one of
                       the values of \ref MarkerType.
+
+           \note Points of type f64 are converted on the GPU to floats relative to
+           an origin near the center of the chart, use Chart::setAxesLimitsF64
+           to set limits of such charts. The conversion runs after Plot::unmap
+           and Plot::markDirty only, hence markDirty has to be called after
+           writing the vertex buffer through OpenGL or compute interop.
          */
         FGAPI Plot(const uint pNumPoints, const dtype pDataType, const ChartType pChartType,
                    const PlotType pPlotType=FG_PLOT_LINE, const MarkerType pMarkerType=FG_MARKER_NONE);
@@ -130,6 +154,37 @@ class Plot {
          */
         FGAPI void setMarkerSize(const float pMarkerSize);
 
+        /**
+           Set width of lines in pixels
+
+           Lines are drawn as screen space quads with anti-aliased edges,
+           hence they look smooth without multisampling. This value defaults to 1
+
+           \param[in] pLineWidth is the target line width for line plots
+         */
+        FGAPI void setLineWidth(const float pLineWidth);
+
+        /**
+           Set the shape of corners between line segments
+
+           This value defaults to FG_LINE_JOIN_MITER
+
+           \param[in] pLineJoin takes one of the values of \ref LineJoin
+         */
+        FGAPI void setLineJoin(const LineJoin pLineJoin);
+
+        /**
+           Show markers as a density map
+
+           Instead of drawing a marker per point, the number of points that fall
+           on every pixel is mapped through the color map of the window. This keeps
+           plots of millions of points readable and cheap to draw. Alpha of the
+           plot color sets the opacity of the map. This value defaults to FG_DENSITY_NONE
+
+           \param[in] pScale takes one of the values of \ref DensityScale
+         */
+        FGAPI void setDensity(const DensityScale pScale);
+
         /**
            Get the OpenGL buffer object identifier for vertices
 
@@ -186,6 +241,72 @@ class Plot {
          */
         FGAPI uint markersSize() const;
 
+        /**
+           Get the OpenGL buffer object identifier for all vertex attributes
+           in one buffer
+
+           Every vertex takes a stride of interleavedSize() / number of points
+           bytes: its position of the plot data type, zero padded to a multiple
+           of four bytes, followed by an rgba8 color and a float marker size.
+           The first call switches the plot to draw from this buffer instead of
+           the separate ones, so that a single copy per frame updates all of them.
+
+           \return OpenGL VBO resource id.
+         */
+        FGAPI uint interleaved() const;
+
+        /**
+           Get the OpenGL interleaved Buffer Object resource size
+
+           \return interleaved buffer object size in bytes
+         */
+        FGAPI uint interleavedSize() const;
+
+        /**
+           Get the offset at which a buffer starts within its OpenGL buffer object
+
+           Offsets are zero unless the plot was created while fg::arena was enabled,
+           in which case copies into its buffers have to start at this offset.
+           The buffer object and offset change when the arena is defragmented.
+
+           \param[in] pBuffer is one of FG_VERTEX_BUFFER, FG_COLOR_BUFFER, FG_ALPHA_BUFFER,
+                      FG_RADIUS_BUFFER or FG_INTERLEAVED_BUFFER
+
+           \return offset in bytes
+         */
+        FGAPI uint offset(const BufferKind pBuffer=FG_VERTEX_BUFFER) const;
+
+        /**
+           Map one of the plot buffers for writing from host
+
+           The previous contents of the buffer are discarded, hence the whole
+           buffer has to be written before it is unmapped. The returned pointer
+           is write only and stays valid until unmap is called. The window
+           context has to be current on the calling thread.
+
+           \param[in] pBuffer is one of FG_VERTEX_BUFFER, FG_COLOR_BUFFER, FG_ALPHA_BUFFER, FG_RADIUS_BUFFER
+                      or FG_INTERLEAVED_BUFFER
+
+           \return pointer to the mapped buffer
+         */
+        FGAPI void* map(const BufferKind pBuffer=FG_VERTEX_BUFFER);
+
+        /**
+           Unmap buffer previously mapped using Plot::map
+
+           \param[in] pBuffer is the buffer kind passed to Plot::map
+         */
+        FGAPI void unmap(const BufferKind pBuffer=FG_VERTEX_BUFFER);
+
+        /**
+           Inform that contents of plot buffers were changed by the user
+
+           Windows that render on demand redraw the plot only after this call
+           when its buffers are written using OpenGL or compute interop. Calls to
+           Plot::unmap take care of it already.
+         */
+        FGAPI void markDirty();
+
         /**
            Get the handle to internal implementation of plot
          */
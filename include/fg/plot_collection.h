@@ -0,0 +1,256 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#pragma once
+
+#include <fg/defines.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+FGAPI fg_err fg_create_plot_collection(fg_plot_collection *pCollection,
+                                       const uint pNSeries, const uint pNPoints,
+                                       const fg_dtype pType,
+                                       const fg_chart_type pChartType,
+                                       const fg_plot_type pPlotType,
+                                       const fg_marker_type pMarkerType);
+
+FGAPI fg_err fg_destroy_plot_collection(fg_plot_collection pCollection);
+
+FGAPI fg_err fg_set_plot_collection_color(fg_plot_collection pCollection,
+                                          const float pRed, const float pGreen,
+                                          const float pBlue, const float pAlpha);
+
+FGAPI fg_err fg_set_plot_collection_legend(fg_plot_collection pCollection, const char* pLegend);
+
+FGAPI fg_err fg_set_plot_collection_marker_size(fg_plot_collection pCollection,
+                                                const float pMarkerSize);
+
+FGAPI fg_err fg_set_plot_collection_series_points(fg_plot_collection pCollection,
+                                                  const uint pSeries, const uint pNPoints);
+
+FGAPI fg_err fg_set_plot_collection_series_color(fg_plot_collection pCollection,
+                                                 const uint pSeries,
+                                                 const float pRed, const float pGreen,
+                                                 const float pBlue, const float pAlpha);
+
+FGAPI fg_err fg_get_plot_collection_vbo(uint* pOut, const fg_plot_collection pCollection);
+
+FGAPI fg_err fg_get_plot_collection_cbo(uint* pOut, const fg_plot_collection pCollection);
+
+FGAPI fg_err fg_get_plot_collection_abo(uint* pOut, const fg_plot_collection pCollection);
+
+FGAPI fg_err fg_get_plot_collection_vbo_size(uint* pOut, const fg_plot_collection pCollection);
+
+FGAPI fg_err fg_get_plot_collection_cbo_size(uint* pOut, const fg_plot_collection pCollection);
+
+FGAPI fg_err fg_get_plot_collection_abo_size(uint* pOut, const fg_plot_collection pCollection);
+
+FGAPI fg_err fg_map_plot_collection_buffer(void** pOut, fg_plot_collection pCollection,
+                                           const fg_buffer_type pBuffer);
+
+FGAPI fg_err fg_unmap_plot_collection_buffer(fg_plot_collection pCollection,
+                                             const fg_buffer_type pBuffer);
+
+FGAPI fg_err fg_mark_plot_collection_dirty(fg_plot_collection pCollection);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#ifdef __cplusplus
+
+namespace fg
+{
+
+/**
+   \class PlotCollection
+
+   \brief PlotCollection displays many line graphs of equal length as one object.
+
+   Vertices of all series are stored back to back in a single buffer, series i
+   occupies the points [i*N, (i+1)*N) where N is the number of points per series.
+   Colors and alpha values are given per series rather than per vertex. All the
+   series are drawn using one draw call for lines and one for markers, which
+   keeps the cost of rendering thousands of series low.
+ */
+class PlotCollection {
+    private:
+        fg_plot_collection mValue;
+
+    public:
+        /**
+           Creates a PlotCollection object
+
+           \param[in] pNumSeries is number of series in the collection
+           \param[in] pNumPoints is maximum number of data points per series
+           \param[in] pDataType takes one of the values of \ref dtype that indicates
+                      the integral data type of plot data
+           \param[in] pChartType dictates the dimensionality of the chart
+           \param[in] pPlotType dictates the type of plot/graph,
+                      it can take one of the values of \ref PlotType
+           \param[in] pMarkerType indicates which symbol is rendered as marker. It can take one of
+                      the values of \ref MarkerType.
+         */
+        FGAPI PlotCollection(const uint pNumSeries, const uint pNumPoints,
+                             const dtype pDataType, const ChartType pChartType,
+                             const PlotType pPlotType=FG_PLOT_LINE,
+                             const MarkerType pMarkerType=FG_MARKER_NONE);
+
+        /**
+           Copy constructor for PlotCollection
+
+           \param[in] pOther is the PlotCollection of which we make a copy of.
+         */
+        FGAPI PlotCollection(const PlotCollection& pOther);
+
+        /**
+           PlotCollection Destructor
+         */
+        FGAPI ~PlotCollection();
+
+        /**
+           Set the color used for the legend entry of the collection
+
+           \param[in] pColor takes values of fg::Color to define legend color
+        */
+        FGAPI void setColor(const fg::Color pColor);
+
+        /**
+           Set the color used for the legend entry of the collection
+
+           \param[in] pRed is Red component in range [0, 1]
+           \param[in] pGreen is Green component in range [0, 1]
+           \param[in] pBlue is Blue component in range [0, 1]
+           \param[in] pAlpha is Blue component in range [0, 1]
+         */
+        FGAPI void setColor(const float pRed, const float pGreen,
+                            const float pBlue, const float pAlpha);
+
+        /**
+           Set collection legend
+
+           \param[in] pLegend
+         */
+        FGAPI void setLegend(const char* pLegend);
+
+        /**
+           Set marker size of all series
+
+           This value defaults to 12
+
+           \param[in] pMarkerSize is the target marker size
+         */
+        FGAPI void setMarkerSize(const float pMarkerSize);
+
+        /**
+           Set the number of points drawn for a series
+
+           \param[in] pSeries is the index of the series
+           \param[in] pNumPoints is at most the number of points per series
+                      the collection was created with
+         */
+        FGAPI void setSeriesPoints(const uint pSeries, const uint pNumPoints);
+
+        /**
+           Set the color of a series
+
+           \param[in] pSeries is the index of the series
+           \param[in] pColor takes values of fg::Color to define series color
+         */
+        FGAPI void setSeriesColor(const uint pSeries, const fg::Color pColor);
+
+        /**
+           Set the color of a series
+
+           \param[in] pSeries is the index of the series
+           \param[in] pRed is Red component in range [0, 1]
+           \param[in] pGreen is Green component in range [0, 1]
+           \param[in] pBlue is Blue component in range [0, 1]
+           \param[in] pAlpha is Blue component in range [0, 1]
+         */
+        FGAPI void setSeriesColor(const uint pSeries,
+                                  const float pRed, const float pGreen,
+                                  const float pBlue, const float pAlpha);
+
+        /**
+           Get the OpenGL buffer object identifier for vertices
+
+           \return OpenGL VBO resource id.
+         */
+        FGAPI uint vertices() const;
+
+        /**
+           Get the OpenGL buffer object identifier for color values, three floats per series
+
+           \return OpenGL VBO resource id.
+         */
+        FGAPI uint colors() const;
+
+        /**
+           Get the OpenGL buffer object identifier for alpha values, one float per series
+
+           \return OpenGL VBO resource id.
+         */
+        FGAPI uint alphas() const;
+
+        /**
+           Get the OpenGL Vertex Buffer Object resource size
+
+           \return vertex buffer object size in bytes
+         */
+        FGAPI uint verticesSize() const;
+
+        /**
+           Get the OpenGL colors Buffer Object resource size
+
+           \return colors buffer object size in bytes
+         */
+        FGAPI uint colorsSize() const;
+
+        /**
+           Get the OpenGL alpha Buffer Object resource size
+
+           \return alpha buffer object size in bytes
+         */
+        FGAPI uint alphasSize() const;
+
+        /**
+           Map one of the collection buffers for writing from host
+
+           \param[in] pBuffer is one of FG_VERTEX_BUFFER, FG_COLOR_BUFFER or FG_ALPHA_BUFFER
+
+           \return pointer to the mapped buffer
+         */
+        FGAPI void* map(const BufferKind pBuffer=FG_VERTEX_BUFFER);
+
+        /**
+           Unmap buffer previously mapped using PlotCollection::map
+
+           \param[in] pBuffer is the buffer kind passed to PlotCollection::map
+         */
+        FGAPI void unmap(const BufferKind pBuffer=FG_VERTEX_BUFFER);
+
+        /**
+           Inform that contents of collection buffers were changed by the user
+         */
+        FGAPI void markDirty();
+
+        /**
+           Get the handle to internal implementation of plot collection
+         */
+        FGAPI fg_plot_collection get() const;
+};
+
+}
+
+#endif
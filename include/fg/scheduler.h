@@ -0,0 +1,185 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#pragma once
+
+#include <fg/window.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+FGAPI fg_err fg_create_scheduler(fg_scheduler* pScheduler);
+
+FGAPI fg_err fg_destroy_scheduler(fg_scheduler pScheduler);
+
+FGAPI fg_err fg_schedule_image(fg_scheduler pScheduler, const fg_window pWindow,
+                               const fg_image pImage, const bool pKeepAspectRatio);
+
+FGAPI fg_err fg_schedule_tiled_image(fg_scheduler pScheduler, const fg_window pWindow,
+                                     const fg_tiled_image pImage, const bool pKeepAspectRatio);
+
+FGAPI fg_err fg_schedule_chart(fg_scheduler pScheduler, const fg_window pWindow,
+                               const fg_chart pChart);
+
+FGAPI fg_err fg_schedule_image_to_cell(fg_scheduler pScheduler, const fg_window pWindow,
+                                       int pColId, int pRowId, const fg_image pImage,
+                                       const char* pTitle, const bool pKeepAspectRatio);
+
+FGAPI fg_err fg_schedule_tiled_image_to_cell(fg_scheduler pScheduler, const fg_window pWindow,
+                                             int pColId, int pRowId, const fg_tiled_image pImage,
+                                             const char* pTitle, const bool pKeepAspectRatio);
+
+FGAPI fg_err fg_schedule_chart_to_cell(fg_scheduler pScheduler, const fg_window pWindow,
+                                       int pColId, int pRowId, const fg_chart pChart,
+                                       const char* pTitle);
+
+FGAPI fg_err fg_clear_scheduler(fg_scheduler pScheduler);
+
+FGAPI fg_err fg_draw_scheduled(fg_scheduler pScheduler);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#ifdef __cplusplus
+
+namespace fg
+{
+
+/**
+   \class Scheduler
+
+   \brief Scheduler draws several windows as a single frame.
+
+   Drawing each window with Window::draw makes every window wait for vertical
+   sync, so N windows run at 1/N of the display refresh rate. Scheduler renders
+   all the windows added to it and presents them together. Only the window that
+   is presented last waits for vertical sync, the others swap immediately.
+   Windows that share a context are rendered one after the other.
+
+   Objects added to the scheduler stay scheduled until Scheduler::clear is called,
+   a typical render loop calls Scheduler::draw once per frame.
+ */
+class Scheduler {
+    private:
+        fg_scheduler mValue;
+
+    public:
+        /**
+           Creates an empty Scheduler object
+         */
+        FGAPI Scheduler();
+
+        /**
+           Copy constructor of Scheduler
+
+           \param[in] pOther is the Scheduler of which we make a copy of.
+         */
+        FGAPI Scheduler(const Scheduler& pOther);
+
+        /**
+           Scheduler Destructor
+
+           Windows that were presented without vertical sync get it back.
+         */
+        FGAPI ~Scheduler();
+
+        /**
+           Render an Image to a Window on every Scheduler::draw
+
+           \param[in] pWindow is the target window
+           \param[in] pImage is an object of class Image
+           \param[in] pKeepAspectRatio when set to true keeps the aspect ratio
+                      of the input image constant.
+         */
+        FGAPI void add(const Window& pWindow, const Image& pImage, const bool pKeepAspectRatio=true);
+
+        /**
+           Render a TiledImage to a Window on every Scheduler::draw
+
+           \param[in] pWindow is the target window
+           \param[in] pImage is an object of class TiledImage
+           \param[in] pKeepAspectRatio when set to true keeps the aspect ratio
+                      of the input image constant.
+         */
+        FGAPI void add(const Window& pWindow, const TiledImage& pImage, const bool pKeepAspectRatio=true);
+
+        /**
+           Render a Chart to a Window on every Scheduler::draw
+
+           \param[in] pWindow is the target window
+           \param[in] pChart is an chart object
+         */
+        FGAPI void add(const Window& pWindow, const Chart& pChart);
+
+        /**
+           Render an Image to a cell of the grid layout of Window
+
+           \param[in] pWindow is the target window, Window::grid should have been called on it
+           \param[in] pColId is coloumn index
+           \param[in] pRowId is row index
+           \param[in] pImage is an object of class Image
+           \param[in] pTitle is the title that will be displayed for the cell
+           \param[in] pKeepAspectRatio when set to true keeps the aspect ratio
+                      of the input image constant.
+         */
+        FGAPI void add(const Window& pWindow, int pColId, int pRowId, const Image& pImage,
+                       const char* pTitle=0, const bool pKeepAspectRatio=true);
+
+        /**
+           Render a TiledImage to a cell of the grid layout of Window
+
+           \param[in] pWindow is the target window, Window::grid should have been called on it
+           \param[in] pColId is coloumn index
+           \param[in] pRowId is row index
+           \param[in] pImage is an object of class TiledImage
+           \param[in] pTitle is the title that will be displayed for the cell
+           \param[in] pKeepAspectRatio when set to true keeps the aspect ratio
+                      of the input image constant.
+         */
+        FGAPI void add(const Window& pWindow, int pColId, int pRowId, const TiledImage& pImage,
+                       const char* pTitle=0, const bool pKeepAspectRatio=true);
+
+        /**
+           Render a Chart to a cell of the grid layout of Window
+
+           \param[in] pWindow is the target window, Window::grid should have been called on it
+           \param[in] pColId is coloumn index
+           \param[in] pRowId is row index
+           \param[in] pChart is a Chart with one or more plottable renderables
+           \param[in] pTitle is the title that will be displayed for the cell
+         */
+        FGAPI void add(const Window& pWindow, int pColId, int pRowId, const Chart& pChart,
+                       const char* pTitle=0);
+
+        /**
+           Remove all scheduled objects
+         */
+        FGAPI void clear();
+
+        /**
+           Render all scheduled objects and present the windows
+
+           Window events are processed once per call. Windows in threaded mode,
+           see Window::setThreaded, are handed over to their render threads.
+         */
+        FGAPI void draw();
+
+        /**
+           Get the handle to internal implementation of Scheduler
+         */
+        FGAPI fg_scheduler get() const;
+};
+
+}
+
+#endif
@@ -41,6 +41,12 @@ FGAPI fg_err fg_get_surface_cbo_size(uint* pOut, const fg_surface pSurface);
 
 FGAPI fg_err fg_get_surface_abo_size(uint* pOut, const fg_surface pSurface);
 
+FGAPI fg_err fg_map_surface_buffer(void** pOut, fg_surface pSurface, const fg_buffer_type pBuffer);
+
+FGAPI fg_err fg_unmap_surface_buffer(fg_surface pSurface, const fg_buffer_type pBuffer);
+
+FGAPI fg_err fg_mark_surface_dirty(fg_surface pSurface);
+
 #ifdef __cplusplus
 }
 #endif
@@ -153,6 +159,36 @@ class Surface {
          */
         FGAPI uint alphasSize() const;
 
+        /**
+           Map one of the surface buffers for writing from host
+
+           The previous contents of the buffer are discarded, hence the whole
+           buffer has to be written before it is unmapped. The returned pointer
+           is write only and stays valid until unmap is called. The window
+           context has to be current on the calling thread.
+
+           \param[in] pBuffer is one of FG_VERTEX_BUFFER, FG_COLOR_BUFFER or FG_ALPHA_BUFFER
+
+           \return pointer to the mapped buffer
+         */
+        FGAPI void* map(const BufferKind pBuffer=FG_VERTEX_BUFFER);
+
+        /**
+           Unmap buffer previously mapped using Surface::map
+
+           \param[in] pBuffer is the buffer kind passed to Surface::map
+         */
+        FGAPI void unmap(const BufferKind pBuffer=FG_VERTEX_BUFFER);
+
+        /**
+           Inform that contents of surface buffers were changed by the user
+
+           Windows that render on demand redraw the surface only after this call
+           when its buffers are written using OpenGL or compute interop. Calls to
+           Surface::unmap take care of it already.
+         */
+        FGAPI void markDirty();
+
         /**
            Get the handle to internal implementation of surface
          */
@@ -0,0 +1,180 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#pragma once
+
+#include <fg/defines.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+FGAPI fg_err fg_create_tiled_image(fg_tiled_image* pImage,
+                                   const uint pWidth, const uint pHeight,
+                                   const fg_channel_format pFormat, const fg_dtype pType,
+                                   fg_tile_loader pLoader, void* pUserData);
+
+FGAPI fg_err fg_create_tiled_image_from_file(fg_tiled_image* pImage, const char* pFilePath,
+                                             const uint pWidth, const uint pHeight,
+                                             const fg_channel_format pFormat, const fg_dtype pType);
+
+FGAPI fg_err fg_destroy_tiled_image(fg_tiled_image pImage);
+
+FGAPI fg_err fg_set_tiled_image_cache_size(fg_tiled_image pImage, const uint pMaxTiles);
+
+FGAPI fg_err fg_set_tiled_image_alpha(fg_tiled_image pImage, const float pAlpha);
+
+FGAPI fg_err fg_set_tiled_image_aspect_ratio(fg_tiled_image pImage, const bool pKeepRatio);
+
+FGAPI fg_err fg_set_tiled_image_colormap(fg_tiled_image pImage, const float* pRGBA, const size_t pLength);
+
+FGAPI fg_err fg_get_tiled_image_width(uint *pOut, const fg_tiled_image pImage);
+
+FGAPI fg_err fg_get_tiled_image_height(uint *pOut, const fg_tiled_image pImage);
+
+FGAPI fg_err fg_get_tiled_image_levels(uint *pOut, const fg_tiled_image pImage);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#ifdef __cplusplus
+
+namespace fg
+{
+
+/**
+   \class TiledImage
+
+   \brief TiledImage renders images that are too large to fit into a single texture.
+
+   The image is split into tiles of 256x256 pixels and a pyramid of successively
+   halved levels is built over them. Only the tiles visible in the current view
+   are fetched, by a background thread, and kept in a bounded cache of textures.
+ */
+class TiledImage {
+    private:
+        fg_tiled_image mValue;
+
+    public:
+        /**
+           Creates a TiledImage object whose tiles are provided by a callback
+
+           \param[in] pWidth Width of the full resolution image
+           \param[in] pHeight Height of the full resolution image
+           \param[in] pFormat Color channel format of image, uses one of the values
+                      of \ref ChannelFormat
+           \param[in] pDataType takes one of the values of \ref dtype that indicates
+                      the integral data type of image data
+           \param[in] pLoader is the function that fills the pixels of a tile
+           \param[in] pUserData is passed as is to \p pLoader
+
+           \note \p pLoader is invoked from a background thread, it shall not make
+           any calls to forge or OpenGL.
+         */
+        FGAPI TiledImage(const uint pWidth, const uint pHeight,
+                         const ChannelFormat pFormat, const dtype pDataType,
+                         fg_tile_loader pLoader, void* pUserData=0);
+
+        /**
+           Creates a TiledImage object whose tiles are read from a file
+
+           The file is expected to hold the raw pixels of the full resolution image
+           in row major order without any header. It is memory mapped and the
+           coarser levels are box filtered from it on demand.
+
+           \param[in] pFilePath is the path to the raw image file
+           \param[in] pWidth Width of the image
+           \param[in] pHeight Height of the image
+           \param[in] pFormat Color channel format of image, uses one of the values
+                      of \ref ChannelFormat
+           \param[in] pDataType takes one of the values of \ref dtype that indicates
+                      the integral data type of image data
+         */
+        FGAPI TiledImage(const char* pFilePath,
+                         const uint pWidth, const uint pHeight,
+                         const ChannelFormat pFormat=FG_RGBA, const dtype pDataType=u8);
+
+        /**
+           Copy constructor of TiledImage
+
+           \param[in] pOther is the TiledImage of which we make a copy of.
+         */
+        FGAPI TiledImage(const TiledImage& pOther);
+
+        /**
+           TiledImage Destructor
+         */
+        FGAPI ~TiledImage();
+
+        /**
+           Set the maximum number of tiles kept in GPU memory
+
+           Least recently used tiles are released once the limit is reached.
+           When the cache is smaller than the number of tiles in view, the
+           missing regions are drawn from coarser tiles in cache, if any.
+
+           \param[in] pMaxTiles is the number of tiles, each tile occupies
+                      256x256 pixels worth of texture memory
+         */
+        FGAPI void setCacheSize(const uint pMaxTiles);
+
+        /**
+           Set a global alpha value for rendering the image
+
+           \param[in] pAlpha
+         */
+        FGAPI void setAlpha(const float pAlpha);
+
+        /**
+           Set option to inform whether to maintain aspect ratio of original image
+
+           \param[in] pKeep
+         */
+        FGAPI void keepAspectRatio(const bool pKeep);
+
+        /**
+           Set a colormap for this TiledImage alone, overriding the colormap of Window
+
+           \param[in] pRGBA is the array of \p pLength colors, each color being
+                      four floating point values (red, green, blue, alpha) in [0, 1].
+                      Passing null reverts to the colormap of Window.
+           \param[in] pLength is the number of colors in the colormap
+         */
+        FGAPI void setColorMap(const float* pRGBA, const size_t pLength);
+
+        /**
+           Get TiledImage width
+           \return image width
+         */
+        FGAPI uint width() const;
+
+        /**
+           Get TiledImage height
+           \return image height
+         */
+        FGAPI uint height() const;
+
+        /**
+           Get number of levels in the tile pyramid
+           \return number of levels
+         */
+        FGAPI uint levels() const;
+
+        /**
+           Get the handle to internal implementation of TiledImage
+         */
+        FGAPI fg_tiled_image get() const;
+};
+
+}
+
+#endif
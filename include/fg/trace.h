@@ -0,0 +1,78 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#pragma once
+
+#include <fg/defines.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+FGAPI fg_err fg_trace_begin(const char* pName);
+
+FGAPI fg_err fg_trace_end();
+
+FGAPI fg_err fg_trace_enabled(bool* pOut);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#ifdef __cplusplus
+
+namespace fg
+{
+
+/**
+   \class TraceScope
+
+   \brief TraceScope adds a span of application work to the trace of Forge.
+
+   Setting the environment variable FG_TRACE_FILE to a file path makes Forge
+   write a Chrome trace_event JSON file, which can be opened in chrome://tracing
+   or Perfetto. When Forge is built with ENABLE_TRACING, the file has spans of
+   its draw calls, renderables, font loading, shader compilation and frame
+   buffer reads, including the time they take on the GPU.
+
+   Spans of the application, such as the steps of a compute pipeline, go to the
+   same file so that both timelines can be looked at together. A TraceScope
+   spans from its construction to its destruction, on the thread it is created on.
+ */
+class TraceScope {
+    private:
+        TraceScope(const TraceScope&);
+        TraceScope& operator=(const TraceScope&);
+
+    public:
+        /**
+           Open a span
+
+           \param[in] pName is the name shown for the span
+         */
+        FGAPI TraceScope(const char* pName);
+
+        /**
+           Close the span
+         */
+        FGAPI ~TraceScope();
+
+        /**
+           Check if tracing is turned on
+
+           \return true if a trace file is being written
+         */
+        FGAPI static bool enabled();
+};
+
+}
+
+#endif
@@ -0,0 +1,146 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#pragma once
+
+#include <fg/defines.h>
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+FGAPI fg_err fg_util_bounds(float* pMin, float* pMax,
+                            const float* pData, const size_t pCount,
+                            const uint pNComps);
+
+FGAPI fg_err fg_util_histogram(void* pBins, const fg_dtype pBinType, const uint pNBins,
+                               const float* pData, const size_t pCount,
+                               const float pMin, const float pMax, const uint pStride);
+
+FGAPI fg_err fg_util_convert_u8(float* pOut, const uchar* pIn,
+                                const size_t pCount, const float pScale);
+
+FGAPI fg_err fg_util_convert_u16(float* pOut, const unsigned short* pIn,
+                                 const size_t pCount, const float pScale);
+
+FGAPI fg_err fg_util_interleave(float* pOut, const float* const* pIn,
+                                const uint pNComps, const size_t pCount);
+
+FGAPI fg_err fg_util_deinterleave(float* const* pOut, const float* pIn,
+                                  const uint pNComps, const size_t pCount);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#ifdef __cplusplus
+
+namespace fg
+{
+
+/**
+   \brief Helpers to prepare host data before it is copied to Forge buffers
+
+   These run on a pool of threads shared by all calls and use SIMD
+   instructions where the CPU has them. The number of threads defaults to
+   the number of cores and can be set using the environment variable
+   FG_UTIL_THREADS. All buffers are host memory, none of these functions
+   need a window context.
+ */
+namespace util
+{
+
+/**
+   Find the range of data, usually to set the axes limits of a chart
+
+   NaN values are ignored. Limits are zero when there are no points.
+
+   \param[out] pMin is an array of pNComps elements that receives the smallest value of each component
+   \param[out] pMax is an array of pNComps elements that receives the largest value of each component
+   \param[in] pData is the array of pCount points, with pNComps interleaved components each
+   \param[in] pCount is the number of points
+   \param[in] pNComps is the number of components per point, in range [1, 4]
+ */
+FGAPI void bounds(float* pMin, float* pMax, const float* pData, const size_t pCount,
+                  const uint pNComps=1);
+
+/**
+   Count values into bins of equal width
+
+   Values outside of [pMin, pMax] and NaN values are not counted, pMax
+   itself is counted into the last bin. The result can be written straight
+   into a mapped histogram buffer.
+
+   \param[out] pBins is the array of pNBins elements of type pBinType
+   \param[in] pBinType is the type of bins, one of f32, s32 or u32
+   \param[in] pNBins is the number of bins
+   \param[in] pData is the array of values
+   \param[in] pCount is the number of values
+   \param[in] pMin is the lower limit of the first bin
+   \param[in] pMax is the upper limit of the last bin
+   \param[in] pStride is the distance between consecutive values in elements, for example
+              4 to count one channel of an RGBA image
+ */
+FGAPI void histogram(void* pBins, const dtype pBinType, const uint pNBins,
+                     const float* pData, const size_t pCount,
+                     const float pMin, const float pMax, const uint pStride=1);
+
+/**
+   Convert unsigned bytes to floats
+
+   \param[out] pOut is the array of pCount floats
+   \param[in] pIn is the array of pCount bytes
+   \param[in] pCount is the number of elements
+   \param[in] pScale multiplies every value, the default maps bytes to [0, 1]
+ */
+FGAPI void convert(float* pOut, const uchar* pIn, const size_t pCount,
+                   const float pScale=1.0f/255.0f);
+
+/**
+   Convert unsigned 16 bit integers to floats
+
+   \param[out] pOut is the array of pCount floats
+   \param[in] pIn is the array of pCount integers
+   \param[in] pCount is the number of elements
+   \param[in] pScale multiplies every value, the default maps integers to [0, 1]
+ */
+FGAPI void convert(float* pOut, const unsigned short* pIn, const size_t pCount,
+                   const float pScale=1.0f/65535.0f);
+
+/**
+   Pack separate component arrays into points, e.g. x and y arrays into a plot vertex buffer
+
+   \param[out] pOut is the array of pCount points of pNComps components each
+   \param[in] pIn is the array of pNComps pointers, each to pCount values of a component
+   \param[in] pNComps is the number of components, in range [1, 4]
+   \param[in] pCount is the number of points
+ */
+FGAPI void interleave(float* pOut, const float* const* pIn,
+                      const uint pNComps, const size_t pCount);
+
+/**
+   Split points into separate component arrays, inverse of \ref interleave
+
+   \param[out] pOut is the array of pNComps pointers, each to pCount values of a component
+   \param[in] pIn is the array of pCount points of pNComps components each
+   \param[in] pNComps is the number of components, in range [1, 4]
+   \param[in] pCount is the number of points
+ */
+FGAPI void deinterleave(float* const* pOut, const float* pIn,
+                        const uint pNComps, const size_t pCount);
+
+}
+
+}
+
+#endif
@@ -45,6 +45,12 @@ FGAPI fg_err fg_get_vector_field_abo_size(uint* pOut, const fg_vector_field pFie
 
 FGAPI fg_err fg_get_vector_field_dbo_size(uint* pOut, const fg_vector_field pField);
 
+FGAPI fg_err fg_map_vector_field_buffer(void** pOut, fg_vector_field pField, const fg_buffer_type pBuffer);
+
+FGAPI fg_err fg_unmap_vector_field_buffer(fg_vector_field pField, const fg_buffer_type pBuffer);
+
+FGAPI fg_err fg_mark_vector_field_dirty(fg_vector_field pField);
+
 #ifdef __cplusplus
 }
 #endif
@@ -168,6 +174,36 @@ class VectorField {
          */
         FGAPI uint directionsSize() const;
 
+        /**
+           Map one of the vector field buffers for writing from host
+
+           The previous contents of the buffer are discarded, hence the whole
+           buffer has to be written before it is unmapped. The returned pointer
+           is write only and stays valid until unmap is called. The window
+           context has to be current on the calling thread.
+
+           \param[in] pBuffer is one of FG_VERTEX_BUFFER, FG_COLOR_BUFFER, FG_ALPHA_BUFFER or FG_DIRECTION_BUFFER
+
+           \return pointer to the mapped buffer
+         */
+        FGAPI void* map(const BufferKind pBuffer=FG_VERTEX_BUFFER);
+
+        /**
+           Unmap buffer previously mapped using VectorField::map
+
+           \param[in] pBuffer is the buffer kind passed to VectorField::map
+         */
+        FGAPI void unmap(const BufferKind pBuffer=FG_VERTEX_BUFFER);
+
+        /**
+           Inform that contents of vector field buffers were changed by the user
+
+           Windows that render on demand redraw the vector field only after this call
+           when its buffers are written using OpenGL or compute interop. Calls to
+           VectorField::unmap take care of it already.
+         */
+        FGAPI void markDirty();
+
         /**
            Get the handle to internal implementation of VectorField
          */
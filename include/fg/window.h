@@ -12,6 +12,7 @@
 #include <fg/defines.h>
 #include <fg/font.h>
 #include <fg/image.h>
+#include <fg/tiled_image.h>
 #include <fg/chart.h>
 #include <fg/surface.h>
 #include <fg/histogram.h>
@@ -39,6 +40,8 @@ FGAPI fg_err fg_set_window_size(fg_window pWindow, const uint pWidth, const uint
 
 FGAPI fg_err fg_set_window_colormap(fg_window pWindow, const fg_color_map pColorMap);
 
+FGAPI fg_err fg_set_window_custom_colormap(fg_window pWindow, const float* pRGBA, const size_t pLength);
+
 FGAPI fg_err fg_get_window_context_handle(long long *pContext, const fg_window pWindow);
 
 FGAPI fg_err fg_get_window_display_handle(long long *pDisplay, const fg_window pWindow);
@@ -57,6 +60,8 @@ FGAPI fg_err fg_close_window(bool* pIsClosed, const fg_window pWindow);
 
 FGAPI fg_err fg_draw_image(const fg_window pWindow, const fg_image pImage, const bool pKeepAspectRatio);
 
+FGAPI fg_err fg_draw_tiled_image(const fg_window pWindow, const fg_tiled_image pImage, const bool pKeepAspectRatio);
+
 FGAPI fg_err fg_draw_chart(const fg_window pWindow, const fg_chart pChart);
 
 FGAPI fg_err fg_setup_window_layout(int pRows, int pCols, fg_window pWindow);
@@ -64,6 +69,9 @@ FGAPI fg_err fg_setup_window_layout(int pRows, int pCols, fg_window pWindow);
 FGAPI fg_err fg_draw_image_to_cell(const fg_window pWindow, int pColId, int pRowId,
                                    const fg_image pImage, const char* pTitle, const bool pKeepAspectRatio);
 
+FGAPI fg_err fg_draw_tiled_image_to_cell(const fg_window pWindow, int pColId, int pRowId,
+                                         const fg_tiled_image pImage, const char* pTitle, const bool pKeepAspectRatio);
+
 FGAPI fg_err fg_draw_chart_to_cell(const fg_window pWindow, int pColId, int pRowId,
                                    const fg_chart pChart, const char* pTitle);
 
@@ -71,6 +79,52 @@ FGAPI fg_err fg_swap_window_buffers(const fg_window pWindow);
 
 FGAPI fg_err fg_save_window_framebuffer(const char* pFullPath, const fg_window pWindow);
 
+FGAPI fg_err fg_upload_buffer_async(const fg_window pWindow, const uint pBuffer,
+                                    const void* pData, const size_t pBytes, const size_t pOffset);
+
+FGAPI fg_err fg_finish_window_uploads(const fg_window pWindow);
+
+FGAPI fg_err fg_set_window_threaded(fg_window pWindow, const bool pThreaded);
+
+FGAPI fg_err fg_draw_image_async(unsigned long long* pFrameId, const fg_window pWindow,
+                                 const fg_image pImage, const bool pKeepAspectRatio);
+
+FGAPI fg_err fg_draw_tiled_image_async(unsigned long long* pFrameId, const fg_window pWindow,
+                                       const fg_tiled_image pImage, const bool pKeepAspectRatio);
+
+FGAPI fg_err fg_draw_chart_async(unsigned long long* pFrameId, const fg_window pWindow,
+                                 const fg_chart pChart);
+
+FGAPI fg_err fg_draw_image_to_cell_async(unsigned long long* pFrameId, const fg_window pWindow,
+                                         int pColId, int pRowId, const fg_image pImage,
+                                         const char* pTitle, const bool pKeepAspectRatio);
+
+FGAPI fg_err fg_draw_tiled_image_to_cell_async(unsigned long long* pFrameId, const fg_window pWindow,
+                                               int pColId, int pRowId, const fg_tiled_image pImage,
+                                               const char* pTitle, const bool pKeepAspectRatio);
+
+FGAPI fg_err fg_draw_chart_to_cell_async(unsigned long long* pFrameId, const fg_window pWindow,
+                                         int pColId, int pRowId, const fg_chart pChart,
+                                         const char* pTitle);
+
+FGAPI fg_err fg_swap_window_buffers_async(unsigned long long* pFrameId, const fg_window pWindow);
+
+FGAPI fg_err fg_submit_window_task(unsigned long long* pTaskId, const fg_window pWindow,
+                                   fg_window_task pTask, void* pUserData);
+
+FGAPI fg_err fg_wait_window(const fg_window pWindow, const unsigned long long pId);
+
+FGAPI fg_err fg_set_window_render_on_demand(fg_window pWindow, const bool pOnDemand);
+
+FGAPI fg_err fg_run_window(fg_window pWindow, fg_frame_callback pCallback,
+                           void* pUserData, const float pMaxFps);
+
+FGAPI fg_err fg_set_window_profiling(fg_window pWindow, const bool pProfile);
+
+FGAPI fg_err fg_show_window_stats(fg_window pWindow, const bool pShow);
+
+FGAPI fg_err fg_get_window_frame_stats(fg_frame_stats* pOut, const fg_window pWindow);
+
 #ifdef __cplusplus
 }
 #endif
@@ -157,6 +211,18 @@ class Window {
          */
         FGAPI void setColorMap(ColorMap cmap);
 
+        /**
+           Set a user defined colormap to be used for subsequent rendering calls
+
+           The colors are looked up with linear interpolation between neighbouring
+           entries, the first color maps to zero and the last color maps to one.
+
+           \param[in] pRGBA is the array of \p pLength colors, each color being
+                      four floating point values (red, green, blue, alpha) in [0, 1]
+           \param[in] pLength is the number of colors in the colormap
+         */
+        FGAPI void setColorMap(const float* pRGBA, const size_t pLength);
+
         /**
            Get OpenGL context handle
            \return Context handle for the window's OpenGL context
@@ -221,6 +287,22 @@ class Window {
          */
         FGAPI void draw(const Image& pImage, const bool pKeepAspectRatio=true);
 
+        /**
+           Render a TiledImage to Window
+
+           Only the tiles visible in the current view are rendered. Tiles that
+           are not yet loaded are substituted by coarser levels of the image.
+
+           \param[in] pImage is an object of class TiledImage
+           \param[in] pKeepAspectRatio when set to true keeps the aspect ratio
+                      of the input image constant.
+
+           \note this draw call does a OpenGL swap buffer, so we do not need
+           to call Window::draw() after this function is called upon for rendering
+           an image
+         */
+        FGAPI void draw(const TiledImage& pImage, const bool pKeepAspectRatio=true);
+
         /**
            Render a chart to Window
 
@@ -264,6 +346,22 @@ class Window {
          */
         FGAPI void draw(int pColId, int pRowId, const Image& pImage, const char* pTitle=0, const bool pKeepAspectRatio=true);
 
+        /**
+           Render TiledImage to given sub-region of the window in multiview mode
+
+           \param[in] pColId is coloumn index
+           \param[in] pRowId is row index
+           \param[in] pImage is an object of class TiledImage
+           \param[in] pTitle is the title that will be displayed for the cell represented
+                      by \p pColId and \p pRowId
+           \param[in] pKeepAspectRatio when set to true keeps the aspect ratio
+                      of the input image constant.
+
+           \note This draw call doesn't do OpenGL swap buffer, see the Image variant
+           of this function for details.
+         */
+        FGAPI void draw(int pColId, int pRowId, const TiledImage& pImage, const char* pTitle=0, const bool pKeepAspectRatio=true);
+
         /**
            Render the chart to given sub-region of the window in multiview mode
 
@@ -302,6 +400,188 @@ class Window {
                       is inferred from the file extension.
          */
         FGAPI void saveFrameBuffer(const char* pFullPath);
+
+        /**
+           Copy host data into an OpenGL buffer object on a background thread
+
+           The copy is done by a worker thread using a hidden window that shares
+           the context of this window. Subsequent draw calls of this window make
+           the GPU wait for the finished copies, hence rendering does not stall
+           on the transfer. Copies that are still queued when a frame is drawn
+           show up in a later frame.
+
+           The first call creates the hidden window, so it has to be made on the
+           thread that created this window. Later calls can be made from any thread.
+
+           \param[in] pBuffer is the buffer object identifier, for example
+                      the one returned by Plot::vertices
+           \param[in] pData is the host memory to be copied. It is copied
+                      before this call returns.
+           \param[in] pBytes is the number of bytes to be copied
+           \param[in] pOffset is the offset in bytes into the buffer object
+         */
+        FGAPI void uploadAsync(const uint pBuffer, const void* pData,
+                               const size_t pBytes, const size_t pOffset=0);
+
+        /**
+           Block until all uploads queued using Window::uploadAsync are issued
+         */
+        FGAPI void finishUploads();
+
+        /**
+           Move rendering of this window to a thread owned by Forge
+
+           In threaded mode the OpenGL context of the window is current on a
+           render thread. Draw calls only queue commands and return, so the
+           calling thread does not block on vsync or GPU work. Window events
+           are still processed by the thread that created the window, from
+           within the draw and swap calls made on that thread.
+
+           The blocking draw and swap calls keep working in threaded mode, they
+           queue the command and wait for it. Changes to charts or renderables
+           that are drawn asynchronously, like axes limits, should be made using
+           Window::submit. Window::makeCurrent must not be used in this mode.
+
+           The calling thread has no OpenGL context in threaded mode. Creating
+           charts or renderables, mapping their buffers and copying into them,
+           for example using the helpers of ComputeCopy.h, have to be done from
+           tasks queued using Window::submit. Creation and mapping throw
+           fg::Error when called without a current context.
+
+           \param[in] pThreaded turns threaded mode on or off. Turning it off
+                      waits for queued commands and makes the context current
+                      on the calling thread again.
+         */
+        FGAPI void setThreaded(const bool pThreaded=true);
+
+        /**
+           Queue rendering of an Image, see Window::draw for details
+
+           \return identifier of the frame that can be passed to Window::wait.
+                   When the window is not in threaded mode, the image is drawn
+                   before returning and zero is returned.
+         */
+        FGAPI unsigned long long drawAsync(const Image& pImage, const bool pKeepAspectRatio=true);
+
+        /**
+           Queue rendering of a TiledImage, see Window::drawAsync(const Image&, const bool)
+         */
+        FGAPI unsigned long long drawAsync(const TiledImage& pImage, const bool pKeepAspectRatio=true);
+
+        /**
+           Queue rendering of a Chart, see Window::drawAsync(const Image&, const bool)
+         */
+        FGAPI unsigned long long drawAsync(const Chart& pChart);
+
+        /**
+           Queue rendering of an Image to a cell of the grid layout
+
+           \return identifier that can be passed to Window::wait
+         */
+        FGAPI unsigned long long drawAsync(int pColId, int pRowId, const Image& pImage,
+                                           const char* pTitle=0, const bool pKeepAspectRatio=true);
+
+        /**
+           Queue rendering of a TiledImage to a cell of the grid layout
+
+           \return identifier that can be passed to Window::wait
+         */
+        FGAPI unsigned long long drawAsync(int pColId, int pRowId, const TiledImage& pImage,
+                                           const char* pTitle=0, const bool pKeepAspectRatio=true);
+
+        /**
+           Queue rendering of a Chart to a cell of the grid layout
+
+           \return identifier that can be passed to Window::wait
+         */
+        FGAPI unsigned long long drawAsync(int pColId, int pRowId, const Chart& pChart,
+                                           const char* pTitle=0);
+
+        /**
+           Queue a swap of front and back buffers, used in multiview mode
+
+           \return identifier of the frame that can be passed to Window::wait
+         */
+        FGAPI unsigned long long swapBuffersAsync();
+
+        /**
+           Run a function on the render thread, in order with queued draws
+
+           \param[in] pTask is the function to be run
+           \param[in] pUserData is passed on to \p pTask
+
+           \return identifier that can be passed to Window::wait
+         */
+        FGAPI unsigned long long submit(fg_window_task pTask, void* pUserData=0);
+
+        /**
+           Block until a queued command has been executed by the render thread
+
+           Errors raised while executing queued commands are reported here.
+
+           \param[in] pId is the identifier returned by one of the asynchronous calls
+         */
+        FGAPI void wait(const unsigned long long pId);
+
+        /**
+           Draw frames only when something on screen changed
+
+           In this mode draw and swap calls return right away, without
+           rendering or swapping, when neither the window (size, view
+           transforms, exposure) nor the objects drawn in it changed since
+           the last frame. Hidden and minimized windows are not drawn at all.
+
+           Changes made through Forge API are tracked. Buffers written using
+           OpenGL or compute interop have to be flagged using the markDirty
+           method of the respective object.
+
+           \param[in] pOnDemand turns render on demand mode on or off
+         */
+        FGAPI void setRenderOnDemand(const bool pOnDemand=true);
+
+        /**
+           Run the event loop of the window
+
+           The window is put into render on demand mode for the duration of the
+           loop. pCallback is invoked at most pMaxFps times a second and draws
+           the window, while the calling thread sleeps waiting for events in
+           between. The loop ends when the window is closed or pCallback
+           returns false.
+
+           \param[in] pCallback is invoked once per frame
+           \param[in] pUserData is passed on to pCallback
+           \param[in] pMaxFps is the upper limit on frame rate. When zero,
+                      pCallback is invoked only after an event arrives.
+         */
+        FGAPI void run(fg_frame_callback pCallback, void* pUserData=0,
+                       const float pMaxFps=60.0f);
+
+        /**
+           Measure time spent on drawing frames of this window
+
+           CPU time is measured while draw calls are made, GPU time using
+           timer queries. Results of a frame become available a few frames
+           later and are fetched using Window::frameStats.
+
+           \param[in] pProfile turns profiling on or off
+         */
+        FGAPI void setProfiling(const bool pProfile=true);
+
+        /**
+           Show frame statistics on top of the window contents
+
+           Turns profiling on when the overlay is shown.
+
+           \param[in] pShow turns the overlay on or off
+         */
+        FGAPI void showStats(const bool pShow=true);
+
+        /**
+           Get the statistics of the latest profiled frame
+
+           \return frame statistics, all zero when no frame has been profiled yet
+         */
+        FGAPI FrameStats frameStats() const;
 };
 
 }
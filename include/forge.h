@@ -14,7 +14,13 @@
 #include "fg/window.h"
 #include "fg/font.h"
 #include "fg/image.h"
+#include "fg/tiled_image.h"
+#include "fg/scheduler.h"
 #include "fg/version.h"
 #include "fg/plot.h"
+#include "fg/plot_collection.h"
 #include "fg/surface.h"
 #include "fg/histogram.h"
+#include "fg/trace.h"
+#include "fg/util.h"
+#include "fg/buffer_arena.h"
@@ -0,0 +1,48 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <fg/buffer_arena.h>
+
+#include <backend.hpp>
+#include <buffer_arena_impl.hpp>
+#include <err_common.hpp>
+
+fg_err fg_set_buffer_arena(const bool pEnable)
+{
+    try {
+        detail::buffer_arena_impl::instance().setEnabled(pEnable);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_defragment_buffer_arena()
+{
+    try {
+        detail::buffer_arena_impl::instance().defragment();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_get_buffer_arena_stats(fg_buffer_arena_stats* pOut)
+{
+    try {
+        if (pOut == NULL)
+            throw fg::ArgumentError("fg_get_buffer_arena_stats", __LINE__, 0,
+                                    "Output pointer is NULL");
+
+        detail::buffer_arena_impl::instance().stats(*pOut);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
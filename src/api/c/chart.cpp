@@ -13,6 +13,7 @@
 #include <fg/histogram.h>
 #include <fg/image.h>
 #include <fg/plot.h>
+#include <fg/plot_collection.h>
 #include <fg/surface.h>
 #include <fg/window.h>
 
@@ -70,6 +71,19 @@ fg_err fg_set_chart_axes_limits(fg_chart pHandle,
     return FG_ERR_NONE;
 }
 
+fg_err fg_set_chart_axes_limits_f64(fg_chart pHandle,
+                                    const double pXmin, const double pXmax,
+                                    const double pYmin, const double pYmax,
+                                    const double pZmin, const double pZmax)
+{
+    try {
+        getChart(pHandle)->setAxesLimits(pXmin, pXmax, pYmin, pYmax, pZmin, pZmax);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
 fg_err fg_set_chart_legend_position(fg_chart pHandle, const float pX, const float pY)
 {
     try {
@@ -140,6 +154,26 @@ fg_err fg_add_plot_to_chart(fg_plot* pPlot, fg_chart pHandle,
     return FG_ERR_NONE;
 }
 
+fg_err fg_add_plot_collection_to_chart(fg_plot_collection* pCollection, fg_chart pHandle,
+                                       const uint pNSeries, const uint pNPoints,
+                                       const fg_dtype pType,
+                                       const fg_plot_type pPlotType,
+                                       const fg_marker_type pMarkerType)
+{
+    try {
+        common::Chart* chrt = getChart(pHandle);
+
+        common::PlotCollection* coll = new common::PlotCollection(pNSeries, pNPoints, (fg::dtype)pType,
+                                                                  pPlotType, pMarkerType,
+                                                                  chrt->chartType());
+        chrt->addRenderable(coll->impl());
+        *pCollection = getHandle(coll);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
 fg_err fg_add_surface_to_chart(fg_surface* pSurface, fg_chart pHandle,
                                const uint pXPoints, const uint pYPoints, const fg_dtype pType,
                                const fg_plot_type pPlotType, const fg_marker_type pMarkerType)
@@ -114,3 +114,66 @@ fg_err fg_get_histogram_abo_size(uint* pOut, const fg_histogram pHistogram)
 
     return FG_ERR_NONE;
 }
+
+fg_err fg_set_histogram_sample_binning(fg_histogram pHistogram, const uint pNumSamples,
+                                       const float pMinValue, const float pMaxValue,
+                                       const bool pNormalize, const bool pCumulative)
+{
+    try {
+        getHistogram(pHistogram)->setSampleBinning(pNumSamples, pMinValue, pMaxValue,
+                                                   pNormalize, pCumulative);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_get_histogram_sbo(uint* pOut, const fg_histogram pHistogram)
+{
+    try {
+        *pOut = getHistogram(pHistogram)->sbo();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_get_histogram_sbo_size(uint* pOut, const fg_histogram pHistogram)
+{
+    try {
+        *pOut = (uint)getHistogram(pHistogram)->sboSize();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_map_histogram_buffer(void** pOut, fg_histogram pHistogram, const fg_buffer_type pBuffer)
+{
+    try {
+        *pOut = getHistogram(pHistogram)->map(pBuffer);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_unmap_histogram_buffer(fg_histogram pHistogram, const fg_buffer_type pBuffer)
+{
+    try {
+        getHistogram(pHistogram)->unmap(pBuffer);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_mark_histogram_dirty(fg_histogram pHistogram)
+{
+    try {
+        getHistogram(pHistogram)->markDirty();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
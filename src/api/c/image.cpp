@@ -60,6 +60,77 @@ fg_err fg_set_image_aspect_ratio(fg_image pImage, const bool pKeepRatio)
     return FG_ERR_NONE;
 }
 
+fg_err fg_set_image_value_range(fg_image pImage, const float pMin, const float pMax,
+                                const float pGamma, const bool pLogScale)
+{
+    try {
+        getImage(pImage)->setValueRange(pMin, pMax, pGamma, pLogScale);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_image_filter(fg_image pImage, const fg_filter_mode pFilter)
+{
+    try {
+        getImage(pImage)->setFilter(pFilter);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_image_yuv_matrix(fg_image pImage, const fg_yuv_matrix pMatrix)
+{
+    try {
+        getImage(pImage)->setYUVMatrix(pMatrix);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_image_colormap(fg_image pImage, const float* pRGBA, const size_t pLength)
+{
+    try {
+        getImage(pImage)->setColorMap(pRGBA, pLength);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_mark_image_dirty(fg_image pImage)
+{
+    try {
+        getImage(pImage)->markDirty();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_map_image_pbo(void** pOut, fg_image pImage)
+{
+    try {
+        *pOut = getImage(pImage)->map();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_unmap_image_pbo(fg_image pImage)
+{
+    try {
+        getImage(pImage)->unmap();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
 fg_err fg_get_image_width(uint *pOut, const fg_image pImage)
 {
     try {
@@ -69,6 +69,36 @@ fg_err fg_set_plot_marker_size(fg_plot pPlot, const float pMarkerSize)
     return FG_ERR_NONE;
 }
 
+fg_err fg_set_plot_line_width(fg_plot pPlot, const float pLineWidth)
+{
+    try {
+        getPlot(pPlot)->setLineWidth(pLineWidth);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_plot_line_join(fg_plot pPlot, const fg_line_join pLineJoin)
+{
+    try {
+        getPlot(pPlot)->setLineJoin(pLineJoin);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_plot_density(fg_plot pPlot, const fg_density_scale pScale)
+{
+    try {
+        getPlot(pPlot)->setDensity(pScale);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
 fg_err fg_get_plot_vbo(uint* pOut, const fg_plot pPlot)
 {
     try {
@@ -148,3 +178,63 @@ fg_err fg_get_plot_mbo_size(uint* pOut, const fg_plot pPlot)
 
     return FG_ERR_NONE;
 }
+
+fg_err fg_get_plot_interleaved_buffer(uint* pOut, const fg_plot pPlot)
+{
+    try {
+        *pOut = getPlot(pPlot)->interleaved();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_get_plot_interleaved_buffer_size(uint* pOut, const fg_plot pPlot)
+{
+    try {
+        *pOut = (uint)getPlot(pPlot)->interleavedSize();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_get_plot_buffer_offset(uint* pOut, const fg_plot pPlot, const fg_buffer_type pBuffer)
+{
+    try {
+        *pOut = (uint)getPlot(pPlot)->offset(pBuffer);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_map_plot_buffer(void** pOut, fg_plot pPlot, const fg_buffer_type pBuffer)
+{
+    try {
+        *pOut = getPlot(pPlot)->map(pBuffer);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_unmap_plot_buffer(fg_plot pPlot, const fg_buffer_type pBuffer)
+{
+    try {
+        getPlot(pPlot)->unmap(pBuffer);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_mark_plot_dirty(fg_plot pPlot)
+{
+    try {
+        getPlot(pPlot)->markDirty();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
@@ -0,0 +1,188 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <fg/plot_collection.h>
+
+#include <handle.hpp>
+#include <chart_renderables.hpp>
+
+fg_err fg_create_plot_collection(fg_plot_collection *pCollection,
+                                 const uint pNSeries, const uint pNPoints,
+                                 const fg_dtype pType,
+                                 const fg_chart_type pChartType,
+                                 const fg_plot_type pPlotType,
+                                 const fg_marker_type pMarkerType)
+{
+    try {
+        *pCollection = getHandle(new common::PlotCollection(pNSeries, pNPoints, (fg::dtype)pType,
+                                                            pPlotType, pMarkerType, pChartType));
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_destroy_plot_collection(fg_plot_collection pCollection)
+{
+    try {
+        delete getPlotCollection(pCollection);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_plot_collection_color(fg_plot_collection pCollection,
+                                    const float pRed, const float pGreen,
+                                    const float pBlue, const float pAlpha)
+{
+    try {
+        getPlotCollection(pCollection)->setColor(pRed, pGreen, pBlue, pAlpha);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_plot_collection_legend(fg_plot_collection pCollection, const char* pLegend)
+{
+    try {
+        getPlotCollection(pCollection)->setLegend(pLegend);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_plot_collection_marker_size(fg_plot_collection pCollection,
+                                          const float pMarkerSize)
+{
+    try {
+        getPlotCollection(pCollection)->setMarkerSize(pMarkerSize);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_plot_collection_series_points(fg_plot_collection pCollection,
+                                            const uint pSeries, const uint pNPoints)
+{
+    try {
+        getPlotCollection(pCollection)->setSeriesPoints(pSeries, pNPoints);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_plot_collection_series_color(fg_plot_collection pCollection,
+                                           const uint pSeries,
+                                           const float pRed, const float pGreen,
+                                           const float pBlue, const float pAlpha)
+{
+    try {
+        getPlotCollection(pCollection)->setSeriesColor(pSeries, pRed, pGreen, pBlue, pAlpha);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_get_plot_collection_vbo(uint* pOut, const fg_plot_collection pCollection)
+{
+    try {
+        *pOut = getPlotCollection(pCollection)->vbo();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_get_plot_collection_cbo(uint* pOut, const fg_plot_collection pCollection)
+{
+    try {
+        *pOut = getPlotCollection(pCollection)->cbo();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_get_plot_collection_abo(uint* pOut, const fg_plot_collection pCollection)
+{
+    try {
+        *pOut = getPlotCollection(pCollection)->abo();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_get_plot_collection_vbo_size(uint* pOut, const fg_plot_collection pCollection)
+{
+    try {
+        *pOut = (uint)getPlotCollection(pCollection)->vboSize();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_get_plot_collection_cbo_size(uint* pOut, const fg_plot_collection pCollection)
+{
+    try {
+        *pOut = (uint)getPlotCollection(pCollection)->cboSize();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_get_plot_collection_abo_size(uint* pOut, const fg_plot_collection pCollection)
+{
+    try {
+        *pOut = (uint)getPlotCollection(pCollection)->aboSize();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_map_plot_collection_buffer(void** pOut, fg_plot_collection pCollection,
+                                     const fg_buffer_type pBuffer)
+{
+    try {
+        *pOut = getPlotCollection(pCollection)->map(pBuffer);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_unmap_plot_collection_buffer(fg_plot_collection pCollection,
+                                       const fg_buffer_type pBuffer)
+{
+    try {
+        getPlotCollection(pCollection)->unmap(pBuffer);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_mark_plot_collection_dirty(fg_plot_collection pCollection)
+{
+    try {
+        getPlotCollection(pCollection)->markDirty();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
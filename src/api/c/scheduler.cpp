@@ -0,0 +1,126 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <fg/scheduler.h>
+
+#include <handle.hpp>
+#include <err_common.hpp>
+#include <scheduler.hpp>
+
+fg_err fg_create_scheduler(fg_scheduler* pScheduler)
+{
+    try {
+        *pScheduler = getHandle(new common::Scheduler());
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_destroy_scheduler(fg_scheduler pScheduler)
+{
+    try {
+        delete getScheduler(pScheduler);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_schedule_image(fg_scheduler pScheduler, const fg_window pWindow,
+                         const fg_image pImage, const bool pKeepAspectRatio)
+{
+    try {
+        getScheduler(pScheduler)->add(getWindow(pWindow), getImage(pImage), pKeepAspectRatio);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_schedule_tiled_image(fg_scheduler pScheduler, const fg_window pWindow,
+                               const fg_tiled_image pImage, const bool pKeepAspectRatio)
+{
+    try {
+        getScheduler(pScheduler)->add(getWindow(pWindow), getTiledImage(pImage), pKeepAspectRatio);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_schedule_chart(fg_scheduler pScheduler, const fg_window pWindow,
+                         const fg_chart pChart)
+{
+    try {
+        getScheduler(pScheduler)->add(getWindow(pWindow), getChart(pChart));
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_schedule_image_to_cell(fg_scheduler pScheduler, const fg_window pWindow,
+                                 int pColId, int pRowId, const fg_image pImage,
+                                 const char* pTitle, const bool pKeepAspectRatio)
+{
+    try {
+        getScheduler(pScheduler)->add(getWindow(pWindow), pColId, pRowId,
+                                      getImage(pImage), pTitle, pKeepAspectRatio);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_schedule_tiled_image_to_cell(fg_scheduler pScheduler, const fg_window pWindow,
+                                       int pColId, int pRowId, const fg_tiled_image pImage,
+                                       const char* pTitle, const bool pKeepAspectRatio)
+{
+    try {
+        getScheduler(pScheduler)->add(getWindow(pWindow), pColId, pRowId,
+                                      getTiledImage(pImage), pTitle, pKeepAspectRatio);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_schedule_chart_to_cell(fg_scheduler pScheduler, const fg_window pWindow,
+                                 int pColId, int pRowId, const fg_chart pChart,
+                                 const char* pTitle)
+{
+    try {
+        getScheduler(pScheduler)->add(getWindow(pWindow), pColId, pRowId,
+                                      getChart(pChart), pTitle);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_clear_scheduler(fg_scheduler pScheduler)
+{
+    try {
+        getScheduler(pScheduler)->clear();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_draw_scheduled(fg_scheduler pScheduler)
+{
+    try {
+        getScheduler(pScheduler)->draw();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
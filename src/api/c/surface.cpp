@@ -118,3 +118,33 @@ fg_err fg_get_surface_abo_size(uint* pOut, const fg_surface pSurface)
 
     return FG_ERR_NONE;
 }
+
+fg_err fg_map_surface_buffer(void** pOut, fg_surface pSurface, const fg_buffer_type pBuffer)
+{
+    try {
+        *pOut = getSurface(pSurface)->map(pBuffer);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_unmap_surface_buffer(fg_surface pSurface, const fg_buffer_type pBuffer)
+{
+    try {
+        getSurface(pSurface)->unmap(pBuffer);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_mark_surface_dirty(fg_surface pSurface)
+{
+    try {
+        getSurface(pSurface)->markDirty();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
@@ -0,0 +1,121 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <fg/tiled_image.h>
+
+#include <handle.hpp>
+#include <err_common.hpp>
+#include <tiled_image.hpp>
+
+fg_err fg_create_tiled_image(fg_tiled_image* pImage,
+                             const uint pWidth, const uint pHeight,
+                             const fg_channel_format pFormat, const fg_dtype pType,
+                             fg_tile_loader pLoader, void* pUserData)
+{
+    try {
+        *pImage = getHandle(new common::TiledImage(pWidth, pHeight, pFormat, (fg::dtype)pType,
+                                                   pLoader, pUserData));
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_create_tiled_image_from_file(fg_tiled_image* pImage, const char* pFilePath,
+                                       const uint pWidth, const uint pHeight,
+                                       const fg_channel_format pFormat, const fg_dtype pType)
+{
+    try {
+        *pImage = getHandle(new common::TiledImage(pFilePath, pWidth, pHeight,
+                                                   pFormat, (fg::dtype)pType));
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_destroy_tiled_image(fg_tiled_image pImage)
+{
+    try {
+        delete getTiledImage(pImage);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_tiled_image_cache_size(fg_tiled_image pImage, const uint pMaxTiles)
+{
+    try {
+        getTiledImage(pImage)->setCacheSize(pMaxTiles);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_tiled_image_alpha(fg_tiled_image pImage, const float pAlpha)
+{
+    try {
+        getTiledImage(pImage)->setAlpha(pAlpha);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_tiled_image_aspect_ratio(fg_tiled_image pImage, const bool pKeepRatio)
+{
+    try {
+        getTiledImage(pImage)->keepAspectRatio(pKeepRatio);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_tiled_image_colormap(fg_tiled_image pImage, const float* pRGBA, const size_t pLength)
+{
+    try {
+        getTiledImage(pImage)->setColorMap(pRGBA, pLength);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_get_tiled_image_width(uint *pOut, const fg_tiled_image pImage)
+{
+    try {
+        *pOut = getTiledImage(pImage)->width();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_get_tiled_image_height(uint *pOut, const fg_tiled_image pImage)
+{
+    try {
+        *pOut = getTiledImage(pImage)->height();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_get_tiled_image_levels(uint *pOut, const fg_tiled_image pImage)
+{
+    try {
+        *pOut = getTiledImage(pImage)->levels();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
@@ -0,0 +1,52 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <fg/trace.h>
+
+#include <backend.hpp>
+#include <err_common.hpp>
+#include <trace_impl.hpp>
+
+fg_err fg_trace_begin(const char* pName)
+{
+    try {
+        if (pName == NULL)
+            throw fg::ArgumentError("fg_trace_begin", __LINE__, 0,
+                                    "Span name is NULL");
+
+        detail::trace_impl& tracer = detail::trace_impl::instance();
+        if (tracer.enabled())
+            tracer.begin(pName);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_trace_end()
+{
+    try {
+        detail::trace_impl& tracer = detail::trace_impl::instance();
+        if (tracer.enabled())
+            tracer.end();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_trace_enabled(bool* pOut)
+{
+    try {
+        *pOut = detail::trace_impl::instance().enabled();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
@@ -0,0 +1,82 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <fg/util.h>
+
+#include <cpu_kernels.hpp>
+#include <err_common.hpp>
+
+fg_err fg_util_bounds(float* pMin, float* pMax,
+                      const float* pData, const size_t pCount,
+                      const uint pNComps)
+{
+    try {
+        common::computeBounds(pMin, pMax, pData, pCount, pNComps);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_util_histogram(void* pBins, const fg_dtype pBinType, const uint pNBins,
+                         const float* pData, const size_t pCount,
+                         const float pMin, const float pMax, const uint pStride)
+{
+    try {
+        common::computeHistogram(pBins, (fg::dtype)pBinType, pNBins,
+                                 pData, pCount, pMin, pMax, pStride);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_util_convert_u8(float* pOut, const uchar* pIn,
+                          const size_t pCount, const float pScale)
+{
+    try {
+        common::convertToFloat(pOut, pIn, pCount, pScale);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_util_convert_u16(float* pOut, const unsigned short* pIn,
+                           const size_t pCount, const float pScale)
+{
+    try {
+        common::convertToFloat(pOut, pIn, pCount, pScale);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_util_interleave(float* pOut, const float* const* pIn,
+                          const uint pNComps, const size_t pCount)
+{
+    try {
+        common::interleave(pOut, pIn, pNComps, pCount);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_util_deinterleave(float* const* pOut, const float* pIn,
+                            const uint pNComps, const size_t pCount)
+{
+    try {
+        common::deinterleave(pOut, pIn, pNComps, pCount);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
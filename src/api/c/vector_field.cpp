@@ -136,3 +136,33 @@ fg_err fg_get_vector_field_dbo_size(uint* pOut, const fg_vector_field pField)
 
     return FG_ERR_NONE;
 }
+
+fg_err fg_map_vector_field_buffer(void** pOut, fg_vector_field pField, const fg_buffer_type pBuffer)
+{
+    try {
+        *pOut = getVectorField(pField)->map(pBuffer);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_unmap_vector_field_buffer(fg_vector_field pField, const fg_buffer_type pBuffer)
+{
+    try {
+        getVectorField(pField)->unmap(pBuffer);
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
+
+fg_err fg_mark_vector_field_dirty(fg_vector_field pField)
+{
+    try {
+        getVectorField(pField)->markDirty();
+    }
+    CATCHALL
+
+    return FG_ERR_NONE;
+}
@@ -89,6 +89,15 @@ fg_err fg_set_window_colormap(fg_window pWindow, const fg_color_map pColorMap)
     return FG_ERR_NONE;
 }
 
+fg_err fg_set_window_custom_colormap(fg_window pWindow, const float* pRGBA, const size_t pLength)
+{
+    try {
+        getWindow(pWindow)->setColorMap(pRGBA, pLength);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
 fg_err fg_get_window_context_handle(long long *pContext, const fg_window pWindow)
 {
     try {
@@ -170,6 +179,15 @@ fg_err fg_draw_image(const fg_window pWindow, const fg_image pImage, const bool
     return FG_ERR_NONE;
 }
 
+fg_err fg_draw_tiled_image(const fg_window pWindow, const fg_tiled_image pImage, const bool pKeepAspectRatio)
+{
+    try {
+        getWindow(pWindow)->draw(getTiledImage(pImage), pKeepAspectRatio);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
 fg_err fg_draw_chart(const fg_window pWindow, const fg_chart pChart)
 {
     try {
@@ -198,6 +216,16 @@ fg_err fg_draw_image_to_cell(const fg_window pWindow, int pColId, int pRowId,
     return FG_ERR_NONE;
 }
 
+fg_err fg_draw_tiled_image_to_cell(const fg_window pWindow, int pColId, int pRowId,
+                                   const fg_tiled_image pImage, const char* pTitle, const bool pKeepAspectRatio)
+{
+    try {
+        getWindow(pWindow)->draw(pColId, pRowId, getTiledImage(pImage), pTitle, pKeepAspectRatio);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
 fg_err fg_draw_chart_to_cell(const fg_window pWindow, int pColId, int pRowId,
                              const fg_chart pChart, const char* pTitle)
 {
@@ -225,3 +253,170 @@ fg_err fg_save_window_framebuffer(const char* pFullPath, const fg_window pWindow
     CATCHALL
     return FG_ERR_NONE;
 }
+
+fg_err fg_upload_buffer_async(const fg_window pWindow, const uint pBuffer,
+                              const void* pData, const size_t pBytes, const size_t pOffset)
+{
+    try {
+        getWindow(pWindow)->uploadAsync(pBuffer, pData, pBytes, pOffset);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_finish_window_uploads(const fg_window pWindow)
+{
+    try {
+        getWindow(pWindow)->finishUploads();
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_window_threaded(fg_window pWindow, const bool pThreaded)
+{
+    try {
+        getWindow(pWindow)->setThreaded(pThreaded);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_draw_image_async(unsigned long long* pFrameId, const fg_window pWindow,
+                           const fg_image pImage, const bool pKeepAspectRatio)
+{
+    try {
+        *pFrameId = getWindow(pWindow)->drawAsync(getImage(pImage), pKeepAspectRatio);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_draw_tiled_image_async(unsigned long long* pFrameId, const fg_window pWindow,
+                                 const fg_tiled_image pImage, const bool pKeepAspectRatio)
+{
+    try {
+        *pFrameId = getWindow(pWindow)->drawAsync(getTiledImage(pImage), pKeepAspectRatio);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_draw_chart_async(unsigned long long* pFrameId, const fg_window pWindow,
+                           const fg_chart pChart)
+{
+    try {
+        *pFrameId = getWindow(pWindow)->drawAsync(getChart(pChart));
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_draw_image_to_cell_async(unsigned long long* pFrameId, const fg_window pWindow,
+                                   int pColId, int pRowId, const fg_image pImage,
+                                   const char* pTitle, const bool pKeepAspectRatio)
+{
+    try {
+        *pFrameId = getWindow(pWindow)->drawAsync(pColId, pRowId, getImage(pImage),
+                                                  pTitle, pKeepAspectRatio);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_draw_tiled_image_to_cell_async(unsigned long long* pFrameId, const fg_window pWindow,
+                                         int pColId, int pRowId, const fg_tiled_image pImage,
+                                         const char* pTitle, const bool pKeepAspectRatio)
+{
+    try {
+        *pFrameId = getWindow(pWindow)->drawAsync(pColId, pRowId, getTiledImage(pImage),
+                                                  pTitle, pKeepAspectRatio);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_draw_chart_to_cell_async(unsigned long long* pFrameId, const fg_window pWindow,
+                                   int pColId, int pRowId, const fg_chart pChart,
+                                   const char* pTitle)
+{
+    try {
+        *pFrameId = getWindow(pWindow)->drawAsync(pColId, pRowId, getChart(pChart), pTitle);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_swap_window_buffers_async(unsigned long long* pFrameId, const fg_window pWindow)
+{
+    try {
+        *pFrameId = getWindow(pWindow)->swapBuffersAsync();
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_submit_window_task(unsigned long long* pTaskId, const fg_window pWindow,
+                             fg_window_task pTask, void* pUserData)
+{
+    try {
+        *pTaskId = getWindow(pWindow)->submit(pTask, pUserData);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_wait_window(const fg_window pWindow, const unsigned long long pId)
+{
+    try {
+        getWindow(pWindow)->wait(pId);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_window_render_on_demand(fg_window pWindow, const bool pOnDemand)
+{
+    try {
+        getWindow(pWindow)->setRenderOnDemand(pOnDemand);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_run_window(fg_window pWindow, fg_frame_callback pCallback,
+                     void* pUserData, const float pMaxFps)
+{
+    try {
+        getWindow(pWindow)->run(pCallback, pUserData, pMaxFps);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_set_window_profiling(fg_window pWindow, const bool pProfile)
+{
+    try {
+        getWindow(pWindow)->setProfiling(pProfile);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_show_window_stats(fg_window pWindow, const bool pShow)
+{
+    try {
+        getWindow(pWindow)->showStats(pShow);
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
+
+fg_err fg_get_window_frame_stats(fg_frame_stats* pOut, const fg_window pWindow)
+{
+    try {
+        *pOut = getWindow(pWindow)->frameStats();
+    }
+    CATCHALL
+    return FG_ERR_NONE;
+}
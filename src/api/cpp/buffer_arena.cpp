@@ -0,0 +1,40 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <fg/buffer_arena.h>
+
+#include <backend.hpp>
+#include <buffer_arena_impl.hpp>
+
+namespace fg
+{
+
+namespace arena
+{
+
+void enable(const bool pEnable)
+{
+    detail::buffer_arena_impl::instance().setEnabled(pEnable);
+}
+
+void defragment()
+{
+    detail::buffer_arena_impl::instance().defragment();
+}
+
+BufferArenaStats stats()
+{
+    BufferArenaStats retVal;
+    detail::buffer_arena_impl::instance().stats(retVal);
+    return retVal;
+}
+
+}
+
+}
@@ -12,6 +12,7 @@
 #include <fg/histogram.h>
 #include <fg/image.h>
 #include <fg/plot.h>
+#include <fg/plot_collection.h>
 #include <fg/surface.h>
 #include <fg/window.h>
 
@@ -54,6 +55,13 @@ void Chart::setAxesLimits(const float pXmin, const float pXmax,
     getChart(mValue)->setAxesLimits(pXmin, pXmax, pYmin, pYmax, pZmin, pZmax);
 }
 
+void Chart::setAxesLimitsF64(const double pXmin, const double pXmax,
+                             const double pYmin, const double pYmax,
+                             const double pZmin, const double pZmax)
+{
+    getChart(mValue)->setAxesLimits(pXmin, pXmax, pYmin, pYmax, pZmin, pZmax);
+}
+
 void Chart::setLegendPosition(const float pX, const float pY)
 {
     getChart(mValue)->setLegendPosition(pX, pY);
@@ -74,6 +82,11 @@ void Chart::add(const Plot& pPlot)
     getChart(mValue)->addRenderable(getPlot(pPlot.get())->impl());
 }
 
+void Chart::add(const PlotCollection& pCollection)
+{
+    getChart(mValue)->addRenderable(getPlotCollection(pCollection.get())->impl());
+}
+
 void Chart::add(const Surface& pSurface)
 {
     getChart(mValue)->addRenderable(getSurface(pSurface.get())->impl());
@@ -119,6 +132,16 @@ Plot Chart::plot(const uint pNumPoints, const dtype pDataType,
     }
 }
 
+PlotCollection Chart::plots(const uint pNumSeries, const uint pNumPoints, const dtype pDataType,
+                            const PlotType pPlotType, const MarkerType pMarkerType)
+{
+    common::Chart* chrt = getChart(mValue);
+    PlotCollection retVal(pNumSeries, pNumPoints, pDataType, chrt->chartType(),
+                          pPlotType, pMarkerType);
+    chrt->addRenderable(getPlotCollection(retVal.get())->impl());
+    return retVal;
+}
+
 Surface Chart::surface(const uint pNumXPoints, const uint pNumYPoints, const dtype pDataType,
                        const PlotType pPlotType, const MarkerType pMarkerType)
 {
@@ -80,6 +80,39 @@ uint Histogram::alphasSize() const
     return (uint)getHistogram(mValue)->aboSize();
 }
 
+void Histogram::setSampleBinning(const uint pNumSamples,
+                                 const float pMinValue, const float pMaxValue,
+                                 const bool pNormalize, const bool pCumulative)
+{
+    getHistogram(mValue)->setSampleBinning(pNumSamples, pMinValue, pMaxValue,
+                                           pNormalize, pCumulative);
+}
+
+uint Histogram::samples() const
+{
+    return getHistogram(mValue)->sbo();
+}
+
+uint Histogram::samplesSize() const
+{
+    return (uint)getHistogram(mValue)->sboSize();
+}
+
+void* Histogram::map(const BufferKind pBuffer)
+{
+    return getHistogram(mValue)->map(pBuffer);
+}
+
+void Histogram::unmap(const BufferKind pBuffer)
+{
+    getHistogram(mValue)->unmap(pBuffer);
+}
+
+void Histogram::markDirty()
+{
+    getHistogram(mValue)->markDirty();
+}
+
 fg_histogram Histogram::get() const
 {
     return mValue;
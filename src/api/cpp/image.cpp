@@ -46,6 +46,42 @@ void Image::keepAspectRatio(const bool pKeep)
     getImage(mValue)->keepAspectRatio(pKeep);
 }
 
+void Image::setValueRange(const float pMin, const float pMax,
+                          const float pGamma, const bool pLogScale)
+{
+    getImage(mValue)->setValueRange(pMin, pMax, pGamma, pLogScale);
+}
+
+void Image::setFilter(const FilterMode pFilter)
+{
+    getImage(mValue)->setFilter(pFilter);
+}
+
+void Image::setYUVMatrix(const YUVMatrix pMatrix)
+{
+    getImage(mValue)->setYUVMatrix(pMatrix);
+}
+
+void Image::setColorMap(const float* pRGBA, const size_t pLength)
+{
+    getImage(mValue)->setColorMap(pRGBA, pLength);
+}
+
+void Image::markDirty()
+{
+    getImage(mValue)->markDirty();
+}
+
+void* Image::map()
+{
+    return getImage(mValue)->map();
+}
+
+void Image::unmap()
+{
+    getImage(mValue)->unmap();
+}
+
 uint Image::width() const
 {
     return getImage(mValue)->width();
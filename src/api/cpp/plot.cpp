@@ -56,6 +56,21 @@ void Plot::setMarkerSize(const float pMarkerSize)
     getPlot(mValue)->setMarkerSize(pMarkerSize);
 }
 
+void Plot::setLineWidth(const float pLineWidth)
+{
+    getPlot(mValue)->setLineWidth(pLineWidth);
+}
+
+void Plot::setLineJoin(const LineJoin pLineJoin)
+{
+    getPlot(mValue)->setLineJoin(pLineJoin);
+}
+
+void Plot::setDensity(const DensityScale pScale)
+{
+    getPlot(mValue)->setDensity(pScale);
+}
+
 uint Plot::vertices() const
 {
     return getPlot(mValue)->vbo();
@@ -96,6 +111,36 @@ uint Plot::markersSize() const
     return (uint)getPlot(mValue)->mboSize();
 }
 
+uint Plot::interleaved() const
+{
+    return getPlot(mValue)->interleaved();
+}
+
+uint Plot::interleavedSize() const
+{
+    return (uint)getPlot(mValue)->interleavedSize();
+}
+
+uint Plot::offset(const BufferKind pBuffer) const
+{
+    return (uint)getPlot(mValue)->offset(pBuffer);
+}
+
+void* Plot::map(const BufferKind pBuffer)
+{
+    return getPlot(mValue)->map(pBuffer);
+}
+
+void Plot::unmap(const BufferKind pBuffer)
+{
+    getPlot(mValue)->unmap(pBuffer);
+}
+
+void Plot::markDirty()
+{
+    getPlot(mValue)->markDirty();
+}
+
 fg_plot Plot::get() const
 {
     return mValue;
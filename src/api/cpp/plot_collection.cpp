@@ -0,0 +1,132 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <fg/plot_collection.h>
+
+#include <handle.hpp>
+#include <chart_renderables.hpp>
+
+namespace fg
+{
+
+PlotCollection::PlotCollection(const uint pNumSeries, const uint pNumPoints,
+                               const dtype pDataType, const ChartType pChartType,
+                               const PlotType pPlotType, const MarkerType pMarkerType)
+{
+    mValue = getHandle(new common::PlotCollection(pNumSeries, pNumPoints, pDataType,
+                                                  pPlotType, pMarkerType, pChartType));
+}
+
+PlotCollection::PlotCollection(const PlotCollection& pOther)
+{
+    mValue = getHandle(new common::PlotCollection(pOther.get()));
+}
+
+PlotCollection::~PlotCollection()
+{
+    delete getPlotCollection(mValue);
+}
+
+void PlotCollection::setColor(const Color pColor)
+{
+    float r = (((int) pColor >> 24 ) & 0xFF ) / 255.f;
+    float g = (((int) pColor >> 16 ) & 0xFF ) / 255.f;
+    float b = (((int) pColor >> 8  ) & 0xFF ) / 255.f;
+    float a = (((int) pColor       ) & 0xFF ) / 255.f;
+    getPlotCollection(mValue)->setColor(r, g, b, a);
+}
+
+void PlotCollection::setColor(const float pRed, const float pGreen,
+                              const float pBlue, const float pAlpha)
+{
+    getPlotCollection(mValue)->setColor(pRed, pGreen, pBlue, pAlpha);
+}
+
+void PlotCollection::setLegend(const char* pLegend)
+{
+    getPlotCollection(mValue)->setLegend(pLegend);
+}
+
+void PlotCollection::setMarkerSize(const float pMarkerSize)
+{
+    getPlotCollection(mValue)->setMarkerSize(pMarkerSize);
+}
+
+void PlotCollection::setSeriesPoints(const uint pSeries, const uint pNumPoints)
+{
+    getPlotCollection(mValue)->setSeriesPoints(pSeries, pNumPoints);
+}
+
+void PlotCollection::setSeriesColor(const uint pSeries, const Color pColor)
+{
+    float r = (((int) pColor >> 24 ) & 0xFF ) / 255.f;
+    float g = (((int) pColor >> 16 ) & 0xFF ) / 255.f;
+    float b = (((int) pColor >> 8  ) & 0xFF ) / 255.f;
+    float a = (((int) pColor       ) & 0xFF ) / 255.f;
+    getPlotCollection(mValue)->setSeriesColor(pSeries, r, g, b, a);
+}
+
+void PlotCollection::setSeriesColor(const uint pSeries,
+                                    const float pRed, const float pGreen,
+                                    const float pBlue, const float pAlpha)
+{
+    getPlotCollection(mValue)->setSeriesColor(pSeries, pRed, pGreen, pBlue, pAlpha);
+}
+
+uint PlotCollection::vertices() const
+{
+    return getPlotCollection(mValue)->vbo();
+}
+
+uint PlotCollection::colors() const
+{
+    return getPlotCollection(mValue)->cbo();
+}
+
+uint PlotCollection::alphas() const
+{
+    return getPlotCollection(mValue)->abo();
+}
+
+uint PlotCollection::verticesSize() const
+{
+    return (uint)getPlotCollection(mValue)->vboSize();
+}
+
+uint PlotCollection::colorsSize() const
+{
+    return (uint)getPlotCollection(mValue)->cboSize();
+}
+
+uint PlotCollection::alphasSize() const
+{
+    return (uint)getPlotCollection(mValue)->aboSize();
+}
+
+void* PlotCollection::map(const BufferKind pBuffer)
+{
+    return getPlotCollection(mValue)->map(pBuffer);
+}
+
+void PlotCollection::unmap(const BufferKind pBuffer)
+{
+    getPlotCollection(mValue)->unmap(pBuffer);
+}
+
+void PlotCollection::markDirty()
+{
+    getPlotCollection(mValue)->markDirty();
+}
+
+fg_plot_collection PlotCollection::get() const
+{
+    return mValue;
+}
+
+}
@@ -0,0 +1,84 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <fg/scheduler.h>
+
+#include <handle.hpp>
+#include <scheduler.hpp>
+
+namespace fg
+{
+
+Scheduler::Scheduler()
+{
+    mValue = getHandle(new common::Scheduler());
+}
+
+Scheduler::Scheduler(const Scheduler& pOther)
+{
+    mValue = getHandle(new common::Scheduler(pOther.get()));
+}
+
+Scheduler::~Scheduler()
+{
+    delete getScheduler(mValue);
+}
+
+void Scheduler::add(const Window& pWindow, const Image& pImage, const bool pKeepAspectRatio)
+{
+    getScheduler(mValue)->add(getWindow(pWindow.get()), getImage(pImage.get()), pKeepAspectRatio);
+}
+
+void Scheduler::add(const Window& pWindow, const TiledImage& pImage, const bool pKeepAspectRatio)
+{
+    getScheduler(mValue)->add(getWindow(pWindow.get()), getTiledImage(pImage.get()), pKeepAspectRatio);
+}
+
+void Scheduler::add(const Window& pWindow, const Chart& pChart)
+{
+    getScheduler(mValue)->add(getWindow(pWindow.get()), getChart(pChart.get()));
+}
+
+void Scheduler::add(const Window& pWindow, int pColId, int pRowId, const Image& pImage,
+                    const char* pTitle, const bool pKeepAspectRatio)
+{
+    getScheduler(mValue)->add(getWindow(pWindow.get()), pColId, pRowId,
+                              getImage(pImage.get()), pTitle, pKeepAspectRatio);
+}
+
+void Scheduler::add(const Window& pWindow, int pColId, int pRowId, const TiledImage& pImage,
+                    const char* pTitle, const bool pKeepAspectRatio)
+{
+    getScheduler(mValue)->add(getWindow(pWindow.get()), pColId, pRowId,
+                              getTiledImage(pImage.get()), pTitle, pKeepAspectRatio);
+}
+
+void Scheduler::add(const Window& pWindow, int pColId, int pRowId, const Chart& pChart,
+                    const char* pTitle)
+{
+    getScheduler(mValue)->add(getWindow(pWindow.get()), pColId, pRowId,
+                              getChart(pChart.get()), pTitle);
+}
+
+void Scheduler::clear()
+{
+    getScheduler(mValue)->clear();
+}
+
+void Scheduler::draw()
+{
+    getScheduler(mValue)->draw();
+}
+
+fg_scheduler Scheduler::get() const
+{
+    return mValue;
+}
+
+}
@@ -80,6 +80,21 @@ uint Surface::alphasSize() const
     return (uint)getSurface(mValue)->aboSize();
 }
 
+void* Surface::map(const BufferKind pBuffer)
+{
+    return getSurface(mValue)->map(pBuffer);
+}
+
+void Surface::unmap(const BufferKind pBuffer)
+{
+    getSurface(mValue)->unmap(pBuffer);
+}
+
+void Surface::markDirty()
+{
+    getSurface(mValue)->markDirty();
+}
+
 fg_surface Surface::get() const
 {
     return mValue;
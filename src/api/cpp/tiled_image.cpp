@@ -0,0 +1,83 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <fg/tiled_image.h>
+
+#include <handle.hpp>
+#include <tiled_image.hpp>
+
+namespace fg
+{
+
+TiledImage::TiledImage(const uint pWidth, const uint pHeight,
+                       const ChannelFormat pFormat, const dtype pDataType,
+                       fg_tile_loader pLoader, void* pUserData)
+{
+    mValue = getHandle(new common::TiledImage(pWidth, pHeight, pFormat, pDataType,
+                                              pLoader, pUserData));
+}
+
+TiledImage::TiledImage(const char* pFilePath,
+                       const uint pWidth, const uint pHeight,
+                       const ChannelFormat pFormat, const dtype pDataType)
+{
+    mValue = getHandle(new common::TiledImage(pFilePath, pWidth, pHeight, pFormat, pDataType));
+}
+
+TiledImage::TiledImage(const TiledImage& pOther)
+{
+    mValue = getHandle(new common::TiledImage(pOther.get()));
+}
+
+TiledImage::~TiledImage()
+{
+    delete getTiledImage(mValue);
+}
+
+void TiledImage::setCacheSize(const uint pMaxTiles)
+{
+    getTiledImage(mValue)->setCacheSize(pMaxTiles);
+}
+
+void TiledImage::setAlpha(const float pAlpha)
+{
+    getTiledImage(mValue)->setAlpha(pAlpha);
+}
+
+void TiledImage::keepAspectRatio(const bool pKeep)
+{
+    getTiledImage(mValue)->keepAspectRatio(pKeep);
+}
+
+void TiledImage::setColorMap(const float* pRGBA, const size_t pLength)
+{
+    getTiledImage(mValue)->setColorMap(pRGBA, pLength);
+}
+
+uint TiledImage::width() const
+{
+    return getTiledImage(mValue)->width();
+}
+
+uint TiledImage::height() const
+{
+    return getTiledImage(mValue)->height();
+}
+
+uint TiledImage::levels() const
+{
+    return getTiledImage(mValue)->levels();
+}
+
+fg_tiled_image TiledImage::get() const
+{
+    return mValue;
+}
+
+}
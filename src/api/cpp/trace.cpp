@@ -0,0 +1,37 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <fg/trace.h>
+
+#include <backend.hpp>
+#include <trace_impl.hpp>
+
+namespace fg
+{
+
+TraceScope::TraceScope(const char* pName)
+{
+    detail::trace_impl& tracer = detail::trace_impl::instance();
+    if (tracer.enabled())
+        tracer.begin(pName ? pName : "");
+}
+
+TraceScope::~TraceScope()
+{
+    detail::trace_impl& tracer = detail::trace_impl::instance();
+    if (tracer.enabled())
+        tracer.end();
+}
+
+bool TraceScope::enabled()
+{
+    return detail::trace_impl::instance().enabled();
+}
+
+}
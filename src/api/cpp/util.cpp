@@ -0,0 +1,55 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <fg/util.h>
+
+#include <cpu_kernels.hpp>
+
+namespace fg
+{
+
+namespace util
+{
+
+void bounds(float* pMin, float* pMax, const float* pData, const size_t pCount,
+            const uint pNComps)
+{
+    common::computeBounds(pMin, pMax, pData, pCount, pNComps);
+}
+
+void histogram(void* pBins, const dtype pBinType, const uint pNBins,
+               const float* pData, const size_t pCount,
+               const float pMin, const float pMax, const uint pStride)
+{
+    common::computeHistogram(pBins, pBinType, pNBins, pData, pCount, pMin, pMax, pStride);
+}
+
+void convert(float* pOut, const uchar* pIn, const size_t pCount, const float pScale)
+{
+    common::convertToFloat(pOut, pIn, pCount, pScale);
+}
+
+void convert(float* pOut, const unsigned short* pIn, const size_t pCount, const float pScale)
+{
+    common::convertToFloat(pOut, pIn, pCount, pScale);
+}
+
+void interleave(float* pOut, const float* const* pIn, const uint pNComps, const size_t pCount)
+{
+    common::interleave(pOut, pIn, pNComps, pCount);
+}
+
+void deinterleave(float* const* pOut, const float* pIn, const uint pNComps, const size_t pCount)
+{
+    common::deinterleave(pOut, pIn, pNComps, pCount);
+}
+
+}
+
+}
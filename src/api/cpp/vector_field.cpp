@@ -90,6 +90,21 @@ uint VectorField::directionsSize() const
     return (uint)getVectorField(mValue)->dboSize();
 }
 
+void* VectorField::map(const BufferKind pBuffer)
+{
+    return getVectorField(mValue)->map(pBuffer);
+}
+
+void VectorField::unmap(const BufferKind pBuffer)
+{
+    getVectorField(mValue)->unmap(pBuffer);
+}
+
+void VectorField::markDirty()
+{
+    getVectorField(mValue)->markDirty();
+}
+
 fg_vector_field VectorField::get() const
 {
     return mValue;
@@ -59,6 +59,11 @@ void Window::setColorMap(ColorMap cmap)
     getWindow(mValue)->setColorMap(cmap);
 }
 
+void Window::setColorMap(const float* pRGBA, const size_t pLength)
+{
+    getWindow(mValue)->setColorMap(pRGBA, pLength);
+}
+
 long long Window::context() const
 {
     return getWindow(mValue)->context();
@@ -109,6 +114,11 @@ void Window::draw(const Image& pImage, const bool pKeepAspectRatio)
     getWindow(mValue)->draw(getImage(pImage.get()), pKeepAspectRatio);
 }
 
+void Window::draw(const TiledImage& pImage, const bool pKeepAspectRatio)
+{
+    getWindow(mValue)->draw(getTiledImage(pImage.get()), pKeepAspectRatio);
+}
+
 void Window::draw(const Chart& pChart)
 {
     getWindow(mValue)->draw(getChart(pChart.get()));
@@ -124,6 +134,11 @@ void Window::draw(int pColId, int pRowId, const Image& pImage, const char* pTitl
     getWindow(mValue)->draw(pColId, pRowId, getImage(pImage.get()), pTitle, pKeepAspectRatio);
 }
 
+void Window::draw(int pColId, int pRowId, const TiledImage& pImage, const char* pTitle, const bool pKeepAspectRatio)
+{
+    getWindow(mValue)->draw(pColId, pRowId, getTiledImage(pImage.get()), pTitle, pKeepAspectRatio);
+}
+
 void Window::draw(int pColId, int pRowId, const Chart& pChart, const char* pTitle)
 {
     getWindow(mValue)->draw(pColId, pRowId, getChart(pChart.get()), pTitle);
@@ -139,4 +154,92 @@ void Window::saveFrameBuffer(const char* pFullPath)
     getWindow(mValue)->saveFrameBuffer(pFullPath);
 }
 
+void Window::setThreaded(const bool pThreaded)
+{
+    getWindow(mValue)->setThreaded(pThreaded);
+}
+
+unsigned long long Window::drawAsync(const Image& pImage, const bool pKeepAspectRatio)
+{
+    return getWindow(mValue)->drawAsync(getImage(pImage.get()), pKeepAspectRatio);
+}
+
+unsigned long long Window::drawAsync(const TiledImage& pImage, const bool pKeepAspectRatio)
+{
+    return getWindow(mValue)->drawAsync(getTiledImage(pImage.get()), pKeepAspectRatio);
+}
+
+unsigned long long Window::drawAsync(const Chart& pChart)
+{
+    return getWindow(mValue)->drawAsync(getChart(pChart.get()));
+}
+
+unsigned long long Window::drawAsync(int pColId, int pRowId, const Image& pImage,
+                                     const char* pTitle, const bool pKeepAspectRatio)
+{
+    return getWindow(mValue)->drawAsync(pColId, pRowId, getImage(pImage.get()), pTitle, pKeepAspectRatio);
+}
+
+unsigned long long Window::drawAsync(int pColId, int pRowId, const TiledImage& pImage,
+                                     const char* pTitle, const bool pKeepAspectRatio)
+{
+    return getWindow(mValue)->drawAsync(pColId, pRowId, getTiledImage(pImage.get()), pTitle, pKeepAspectRatio);
+}
+
+unsigned long long Window::drawAsync(int pColId, int pRowId, const Chart& pChart, const char* pTitle)
+{
+    return getWindow(mValue)->drawAsync(pColId, pRowId, getChart(pChart.get()), pTitle);
+}
+
+unsigned long long Window::swapBuffersAsync()
+{
+    return getWindow(mValue)->swapBuffersAsync();
+}
+
+unsigned long long Window::submit(fg_window_task pTask, void* pUserData)
+{
+    return getWindow(mValue)->submit(pTask, pUserData);
+}
+
+void Window::wait(const unsigned long long pId)
+{
+    getWindow(mValue)->wait(pId);
+}
+
+void Window::setRenderOnDemand(const bool pOnDemand)
+{
+    getWindow(mValue)->setRenderOnDemand(pOnDemand);
+}
+
+void Window::run(fg_frame_callback pCallback, void* pUserData, const float pMaxFps)
+{
+    getWindow(mValue)->run(pCallback, pUserData, pMaxFps);
+}
+
+void Window::setProfiling(const bool pProfile)
+{
+    getWindow(mValue)->setProfiling(pProfile);
+}
+
+void Window::showStats(const bool pShow)
+{
+    getWindow(mValue)->showStats(pShow);
+}
+
+FrameStats Window::frameStats() const
+{
+    return getWindow(mValue)->frameStats();
+}
+
+void Window::uploadAsync(const uint pBuffer, const void* pData,
+                         const size_t pBytes, const size_t pOffset)
+{
+    getWindow(mValue)->uploadAsync(pBuffer, pData, pBytes, pOffset);
+}
+
+void Window::finishUploads()
+{
+    getWindow(mValue)->finishUploads();
+}
+
 }
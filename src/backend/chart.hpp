@@ -58,9 +58,9 @@ class Chart {
             mChart->setAxesTitles(pX, pY, pZ);
         }
 
-        inline void setAxesLimits(const float pXmin, const float pXmax,
-                                  const float pYmin, const float pYmax,
-                                  const float pZmin, const float pZmax) {
+        inline void setAxesLimits(const double pXmin, const double pXmax,
+                                  const double pYmin, const double pYmax,
+                                  const double pZmin, const double pZmax) {
             mChart->setAxesLimits(pXmin, pXmax, pYmin, pYmax, pZmin, pZmax);
         }
 
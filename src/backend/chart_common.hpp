@@ -69,6 +69,18 @@ class ChartRenderableBase {
             return mShrdPtr->aboSize();
         }
 
+        inline void* map(const fg::BufferKind pKind) const {
+            return mShrdPtr->map(pKind);
+        }
+
+        inline void unmap(const fg::BufferKind pKind) const {
+            mShrdPtr->unmap(pKind);
+        }
+
+        inline void markDirty() const {
+            mShrdPtr->markDirty();
+        }
+
         inline void render(const int pWindowId,
                            const int pX, const int pY, const int pVPW, const int pVPH,
                            const glm::mat4& pTransform) const {
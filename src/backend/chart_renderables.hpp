@@ -13,6 +13,7 @@
 #include <backend.hpp>
 #include <histogram_impl.hpp>
 #include <plot_impl.hpp>
+#include <plot_collection_impl.hpp>
 #include <surface_impl.hpp>
 #include <vector_field_impl.hpp>
 
@@ -32,6 +33,21 @@ class Histogram : public ChartRenderableBase<detail::histogram_impl> {
             : ChartRenderableBase<detail::histogram_impl>(
                     reinterpret_cast<Histogram*>(pOther)->impl()) {
         }
+
+        inline void setSampleBinning(const uint pNumSamples,
+                                     const float pMinValue, const float pMaxValue,
+                                     const bool pNormalize, const bool pCumulative) {
+            mShrdPtr->setSampleBinning(pNumSamples, pMinValue, pMaxValue,
+                                       pNormalize, pCumulative);
+        }
+
+        inline GLuint sbo() const {
+            return mShrdPtr->sbo();
+        }
+
+        inline size_t sboSize() const {
+            return mShrdPtr->sboSize();
+        }
 };
 
 class Plot : public ChartRenderableBase<detail::plot_impl> {
@@ -57,6 +73,18 @@ class Plot : public ChartRenderableBase<detail::plot_impl> {
             mShrdPtr->setMarkerSize(pMarkerSize);
         }
 
+        inline void setLineWidth(const float pLineWidth) {
+            mShrdPtr->setLineWidth(pLineWidth);
+        }
+
+        inline void setLineJoin(const fg::LineJoin pLineJoin) {
+            mShrdPtr->setLineJoin(pLineJoin);
+        }
+
+        inline void setDensity(const fg::DensityScale pScale) {
+            mShrdPtr->setDensity(pScale);
+        }
+
         inline GLuint mbo() const {
             return mShrdPtr->markers();
         }
@@ -64,6 +92,48 @@ class Plot : public ChartRenderableBase<detail::plot_impl> {
         inline size_t mboSize() const {
             return mShrdPtr->markersSizes();
         }
+
+        inline GLuint interleaved() const {
+            return mShrdPtr->interleaved();
+        }
+
+        inline size_t interleavedSize() const {
+            return mShrdPtr->interleavedSize();
+        }
+
+        inline size_t offset(const fg::BufferKind pKind) const {
+            return mShrdPtr->offset(pKind);
+        }
+};
+
+class PlotCollection : public ChartRenderableBase<detail::plot_collection_impl> {
+    public:
+        PlotCollection(const uint pNumSeries, const uint pNumPoints, const fg::dtype pDataType,
+                       const fg::PlotType pPlotType, const fg::MarkerType pMarkerType,
+                       const fg::ChartType pChartType)
+            : ChartRenderableBase<detail::plot_collection_impl>(
+                    std::make_shared<detail::plot_collection_impl>(pNumSeries, pNumPoints, pDataType,
+                                                                   pChartType, pPlotType, pMarkerType)) {
+        }
+
+        PlotCollection(const fg_plot_collection pOther)
+            : ChartRenderableBase<detail::plot_collection_impl>(
+                    reinterpret_cast<PlotCollection*>(pOther)->impl()) {
+        }
+
+        inline void setMarkerSize(const float pMarkerSize) {
+            mShrdPtr->setMarkerSize(pMarkerSize);
+        }
+
+        inline void setSeriesPoints(const uint pSeries, const uint pNumPoints) {
+            mShrdPtr->setSeriesPoints(pSeries, pNumPoints);
+        }
+
+        inline void setSeriesColor(const uint pSeries,
+                                   const float pRed, const float pGreen,
+                                   const float pBlue, const float pAlpha) {
+            mShrdPtr->setSeriesColor(pSeries, pRed, pGreen, pBlue, pAlpha);
+        }
 };
 
 class Surface : public ChartRenderableBase<detail::surface_impl> {
@@ -0,0 +1,92 @@
+/*******************************************************
+ * Copyright (c) 2016, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+/// Bounded lock free queue, based on the array queue of Dmitry Vyukov
+///
+/// Any number of threads can push, only one thread is expected to pop.
+/// Each successful push is given a ticket, tickets are handed out in the
+/// same order in which the elements are popped.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+template<typename T>
+class CommandQueue {
+    private:
+        struct Cell {
+            std::atomic<size_t> mSequence;
+            T                   mData;
+        };
+
+        /* producers and consumer positions are kept on
+         * separate cache lines to avoid false sharing */
+        char                    mPad0[64];
+        std::unique_ptr<Cell[]> mBuffer;
+        size_t                  mMask;
+        char                    mPad1[64];
+        std::atomic<size_t>     mEnqueuePos;
+        char                    mPad2[64];
+        std::atomic<size_t>     mDequeuePos;
+        char                    mPad3[64];
+
+        CommandQueue(const CommandQueue&);
+        CommandQueue& operator=(const CommandQueue&);
+
+    public:
+        /// pCapacity has to be a power of two
+        explicit CommandQueue(const size_t pCapacity)
+            : mBuffer(new Cell[pCapacity]), mMask(pCapacity - 1),
+              mEnqueuePos(0), mDequeuePos(0)
+        {
+            for (size_t i = 0; i < pCapacity; ++i)
+                mBuffer[i].mSequence.store(i, std::memory_order_relaxed);
+        }
+
+        /// Returns false when the queue is full, pTicket is set on success
+        bool push(T&& pData, size_t& pTicket)
+        {
+            Cell* cell;
+            size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+            while (true) {
+                cell = &mBuffer[pos & mMask];
+                size_t seq = cell->mSequence.load(std::memory_order_acquire);
+                ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)pos;
+                if (diff == 0) {
+                    if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = mEnqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+            cell->mData = std::move(pData);
+            cell->mSequence.store(pos + 1, std::memory_order_release);
+            pTicket = pos;
+            return true;
+        }
+
+        /// Returns false when the queue is empty
+        bool pop(T& pData)
+        {
+            size_t pos  = mDequeuePos.load(std::memory_order_relaxed);
+            Cell* cell  = &mBuffer[pos & mMask];
+            size_t seq  = cell->mSequence.load(std::memory_order_acquire);
+            if ((ptrdiff_t)seq - (ptrdiff_t)(pos + 1) < 0)
+                return false;
+            mDequeuePos.store(pos + 1, std::memory_order_relaxed);
+            pData = std::move(cell->mData);
+            cell->mSequence.store(pos + mMask + 1, std::memory_order_release);
+            return true;
+        }
+};
@@ -0,0 +1,318 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <fg/exception.h>
+
+#include <cpu_kernels.hpp>
+#include <thread_pool.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FG_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace common
+{
+
+/* elements per chunk, large enough to amortize
+ * taking a chunk from the queue of a thread */
+static const size_t GRAIN = 1 << 16;
+
+static void boundsRange(float* pMin, float* pMax, const float* pData,
+                        const size_t pCount, const unsigned pNComps)
+{
+    size_t i = 0;
+#ifdef FG_USE_SSE2
+    /* blocks of lcm(4, pNComps) floats, lane j of
+     * vector v holds component (4*v + j) % pNComps */
+    const unsigned vecs = (pNComps == 3 ? 3 : 1);
+    __m128 mn[3], mx[3];
+    for (unsigned v = 0; v < vecs; ++v) {
+        mn[v] = _mm_set1_ps(FLT_MAX);
+        mx[v] = _mm_set1_ps(-FLT_MAX);
+    }
+    for (; i + 4 * vecs <= pCount; i += 4 * vecs) {
+        for (unsigned v = 0; v < vecs; ++v) {
+            /* NaN in the first operand yields the second one */
+            __m128 x = _mm_loadu_ps(pData + i + 4 * v);
+            mn[v] = _mm_min_ps(x, mn[v]);
+            mx[v] = _mm_max_ps(x, mx[v]);
+        }
+    }
+    float lanesMin[4], lanesMax[4];
+    for (unsigned v = 0; v < vecs; ++v) {
+        _mm_storeu_ps(lanesMin, mn[v]);
+        _mm_storeu_ps(lanesMax, mx[v]);
+        for (unsigned j = 0; j < 4; ++j) {
+            const unsigned c = (4 * v + j) % pNComps;
+            pMin[c] = std::min(pMin[c], lanesMin[j]);
+            pMax[c] = std::max(pMax[c], lanesMax[j]);
+        }
+    }
+#endif
+    for (; i < pCount; ++i) {
+        const unsigned c = i % pNComps;
+        const float    x = pData[i];
+        if (x < pMin[c]) pMin[c] = x;
+        if (x > pMax[c]) pMax[c] = x;
+    }
+}
+
+void computeBounds(float* pMin, float* pMax, const float* pData,
+                   const size_t pCount, const unsigned pNComps)
+{
+    if (pMin == NULL || pMax == NULL)
+        throw fg::ArgumentError("fg::util::bounds", __LINE__, 0, "Output is NULL");
+    if (pData == NULL && pCount > 0)
+        throw fg::ArgumentError("fg::util::bounds", __LINE__, 2, "Data is NULL");
+    if (pNComps < 1 || pNComps > 4)
+        throw fg::ArgumentError("fg::util::bounds", __LINE__, 4,
+                                "Number of components has to be in [1, 4]");
+
+    ThreadPool& pool = ThreadPool::instance();
+
+    std::vector<float> mins(pool.size() * pNComps, FLT_MAX);
+    std::vector<float> maxs(pool.size() * pNComps, -FLT_MAX);
+
+    pool.parallelFor(pCount, GRAIN,
+        [&](size_t pBegin, size_t pEnd, unsigned pThread) {
+            boundsRange(&mins[pThread * pNComps], &maxs[pThread * pNComps],
+                        pData + pBegin * pNComps, (pEnd - pBegin) * pNComps, pNComps);
+        });
+
+    for (unsigned c = 0; c < pNComps; ++c) {
+        pMin[c] = FLT_MAX;
+        pMax[c] = -FLT_MAX;
+        for (unsigned t = 0; t < pool.size(); ++t) {
+            pMin[c] = std::min(pMin[c], mins[t * pNComps + c]);
+            pMax[c] = std::max(pMax[c], maxs[t * pNComps + c]);
+        }
+        if (pCount == 0)
+            pMin[c] = pMax[c] = 0.0f;
+    }
+}
+
+void computeHistogram(void* pBins, const fg::dtype pBinType, const unsigned pNBins,
+                      const float* pData, const size_t pCount,
+                      const float pMin, const float pMax, const unsigned pStride)
+{
+    if (pBins == NULL)
+        throw fg::ArgumentError("fg::util::histogram", __LINE__, 0, "Bins are NULL");
+    if (pBinType != fg::f32 && pBinType != fg::s32 && pBinType != fg::u32)
+        throw fg::ArgumentError("fg::util::histogram", __LINE__, 1,
+                                "Bin type has to be one of f32, s32 or u32");
+    if (pNBins == 0)
+        throw fg::ArgumentError("fg::util::histogram", __LINE__, 2,
+                                "Number of bins has to be positive");
+    if (pData == NULL && pCount > 0)
+        throw fg::ArgumentError("fg::util::histogram", __LINE__, 3, "Data is NULL");
+    if (!(pMax > pMin))
+        throw fg::ArgumentError("fg::util::histogram", __LINE__, 6,
+                                "Upper limit has to be greater than lower limit");
+    if (pStride == 0)
+        throw fg::ArgumentError("fg::util::histogram", __LINE__, 7,
+                                "Stride has to be positive");
+
+    ThreadPool& pool = ThreadPool::instance();
+
+    const float    scale = pNBins / (pMax - pMin);
+    const unsigned last  = pNBins - 1;
+
+    /* bins per thread, added up once all are done */
+    std::vector<unsigned> local(pool.size() * pNBins, 0);
+
+    pool.parallelFor(pCount, GRAIN,
+        [&](size_t pBegin, size_t pEnd, unsigned pThread) {
+            unsigned* bins = &local[pThread * pNBins];
+            size_t i = pBegin;
+#ifdef FG_USE_SSE2
+            if (pStride == 1) {
+                const __m128 vmin   = _mm_set1_ps(pMin);
+                const __m128 vmax   = _mm_set1_ps(pMax);
+                const __m128 vscale = _mm_set1_ps(scale);
+                int idx[4];
+                for (; i + 4 <= pEnd; i += 4) {
+                    __m128 x    = _mm_loadu_ps(pData + i);
+                    /* comparisons with NaN are false */
+                    int inside  = _mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(x, vmin),
+                                                             _mm_cmple_ps(x, vmax)));
+                    _mm_storeu_si128((__m128i*)idx,
+                                     _mm_cvttps_epi32(_mm_mul_ps(_mm_sub_ps(x, vmin), vscale)));
+                    for (int k = 0; k < 4; ++k) {
+                        if (inside & (1 << k))
+                            bins[std::min((unsigned)idx[k], last)]++;
+                    }
+                }
+            }
+#endif
+            for (; i < pEnd; ++i) {
+                const float x = pData[i * pStride];
+                if (x >= pMin && x <= pMax)
+                    bins[std::min((unsigned)((x - pMin) * scale), last)]++;
+            }
+        });
+
+    for (unsigned b = 0; b < pNBins; ++b) {
+        unsigned sum = 0;
+        for (unsigned t = 0; t < pool.size(); ++t)
+            sum += local[t * pNBins + b];
+
+        switch (pBinType) {
+            case fg::f32: static_cast<float*>(pBins)[b]    = (float)sum; break;
+            case fg::s32: static_cast<int*>(pBins)[b]      = (int)sum;   break;
+            default:      static_cast<unsigned*>(pBins)[b] = sum;        break;
+        }
+    }
+}
+
+void convertToFloat(float* pOut, const unsigned char* pIn, const size_t pCount, const float pScale)
+{
+    if ((pOut == NULL || pIn == NULL) && pCount > 0)
+        throw fg::ArgumentError("fg::util::convert", __LINE__, pOut == NULL ? 0 : 1,
+                                "Buffer is NULL");
+
+    ThreadPool::instance().parallelFor(pCount, GRAIN,
+        [&](size_t pBegin, size_t pEnd, unsigned) {
+            size_t i = pBegin;
+#ifdef FG_USE_SSE2
+            const __m128  s    = _mm_set1_ps(pScale);
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 16 <= pEnd; i += 16) {
+                __m128i bytes = _mm_loadu_si128((const __m128i*)(pIn + i));
+                __m128i lo    = _mm_unpacklo_epi8(bytes, zero);
+                __m128i hi    = _mm_unpackhi_epi8(bytes, zero);
+                _mm_storeu_ps(pOut + i,      _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), s));
+                _mm_storeu_ps(pOut + i + 4,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), s));
+                _mm_storeu_ps(pOut + i + 8,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), s));
+                _mm_storeu_ps(pOut + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), s));
+            }
+#endif
+            for (; i < pEnd; ++i)
+                pOut[i] = pIn[i] * pScale;
+        });
+}
+
+void convertToFloat(float* pOut, const unsigned short* pIn, const size_t pCount, const float pScale)
+{
+    if ((pOut == NULL || pIn == NULL) && pCount > 0)
+        throw fg::ArgumentError("fg::util::convert", __LINE__, pOut == NULL ? 0 : 1,
+                                "Buffer is NULL");
+
+    ThreadPool::instance().parallelFor(pCount, GRAIN,
+        [&](size_t pBegin, size_t pEnd, unsigned) {
+            size_t i = pBegin;
+#ifdef FG_USE_SSE2
+            const __m128  s    = _mm_set1_ps(pScale);
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 8 <= pEnd; i += 8) {
+                __m128i words = _mm_loadu_si128((const __m128i*)(pIn + i));
+                _mm_storeu_ps(pOut + i,     _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(words, zero)), s));
+                _mm_storeu_ps(pOut + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(words, zero)), s));
+            }
+#endif
+            for (; i < pEnd; ++i)
+                pOut[i] = pIn[i] * pScale;
+        });
+}
+
+static void checkComponents(const char* pFuncName, const float* pPacked,
+                            const float* const* pPlanes, const unsigned pNComps,
+                            const size_t pCount)
+{
+    if (pNComps < 1 || pNComps > 4)
+        throw fg::ArgumentError(pFuncName, __LINE__, 2,
+                                "Number of components has to be in [1, 4]");
+    if (pCount == 0)
+        return;
+    if (pPacked == NULL || pPlanes == NULL)
+        throw fg::ArgumentError(pFuncName, __LINE__, pPacked == NULL ? 0 : 1,
+                                "Buffer is NULL");
+    for (unsigned c = 0; c < pNComps; ++c) {
+        if (pPlanes[c] == NULL)
+            throw fg::ArgumentError(pFuncName, __LINE__, 1, "Component buffer is NULL");
+    }
+}
+
+void interleave(float* pOut, const float* const* pIn, const unsigned pNComps, const size_t pCount)
+{
+    checkComponents("fg::util::interleave", pOut, pIn, pNComps, pCount);
+
+    ThreadPool::instance().parallelFor(pCount, GRAIN,
+        [&](size_t pBegin, size_t pEnd, unsigned) {
+            size_t i = pBegin;
+#ifdef FG_USE_SSE2
+            if (pNComps == 2) {
+                for (; i + 4 <= pEnd; i += 4) {
+                    __m128 x = _mm_loadu_ps(pIn[0] + i);
+                    __m128 y = _mm_loadu_ps(pIn[1] + i);
+                    _mm_storeu_ps(pOut + 2 * i,     _mm_unpacklo_ps(x, y));
+                    _mm_storeu_ps(pOut + 2 * i + 4, _mm_unpackhi_ps(x, y));
+                }
+            } else if (pNComps == 4) {
+                for (; i + 4 <= pEnd; i += 4) {
+                    __m128 x = _mm_loadu_ps(pIn[0] + i);
+                    __m128 y = _mm_loadu_ps(pIn[1] + i);
+                    __m128 z = _mm_loadu_ps(pIn[2] + i);
+                    __m128 w = _mm_loadu_ps(pIn[3] + i);
+                    _MM_TRANSPOSE4_PS(x, y, z, w);
+                    _mm_storeu_ps(pOut + 4 * i,      x);
+                    _mm_storeu_ps(pOut + 4 * i + 4,  y);
+                    _mm_storeu_ps(pOut + 4 * i + 8,  z);
+                    _mm_storeu_ps(pOut + 4 * i + 12, w);
+                }
+            }
+#endif
+            for (; i < pEnd; ++i) {
+                for (unsigned c = 0; c < pNComps; ++c)
+                    pOut[i * pNComps + c] = pIn[c][i];
+            }
+        });
+}
+
+void deinterleave(float* const* pOut, const float* pIn, const unsigned pNComps, const size_t pCount)
+{
+    checkComponents("fg::util::deinterleave", pIn, pOut, pNComps, pCount);
+
+    ThreadPool::instance().parallelFor(pCount, GRAIN,
+        [&](size_t pBegin, size_t pEnd, unsigned) {
+            size_t i = pBegin;
+#ifdef FG_USE_SSE2
+            if (pNComps == 2) {
+                for (; i + 4 <= pEnd; i += 4) {
+                    __m128 a = _mm_loadu_ps(pIn + 2 * i);
+                    __m128 b = _mm_loadu_ps(pIn + 2 * i + 4);
+                    _mm_storeu_ps(pOut[0] + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+                    _mm_storeu_ps(pOut[1] + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+                }
+            } else if (pNComps == 4) {
+                for (; i + 4 <= pEnd; i += 4) {
+                    __m128 a = _mm_loadu_ps(pIn + 4 * i);
+                    __m128 b = _mm_loadu_ps(pIn + 4 * i + 4);
+                    __m128 c = _mm_loadu_ps(pIn + 4 * i + 8);
+                    __m128 d = _mm_loadu_ps(pIn + 4 * i + 12);
+                    _MM_TRANSPOSE4_PS(a, b, c, d);
+                    _mm_storeu_ps(pOut[0] + i, a);
+                    _mm_storeu_ps(pOut[1] + i, b);
+                    _mm_storeu_ps(pOut[2] + i, c);
+                    _mm_storeu_ps(pOut[3] + i, d);
+                }
+            }
+#endif
+            for (; i < pEnd; ++i) {
+                for (unsigned c = 0; c < pNComps; ++c)
+                    pOut[c][i] = pIn[i * pNComps + c];
+            }
+        });
+}
+
+}
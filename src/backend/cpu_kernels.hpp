@@ -0,0 +1,47 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+/// This file contains the CPU kernels behind fg::util, they run on the
+/// threads of common::ThreadPool and use SSE2 where it is available.
+/// Invalid arguments raise fg::ArgumentError naming the fg::util function.
+
+#pragma once
+
+#include <fg/defines.h>
+
+#include <cstddef>
+
+namespace common
+{
+
+/// Smallest and largest value of each of pNComps interleaved components,
+/// NaN values are ignored. Both are zero when there are no points.
+void computeBounds(float* pMin, float* pMax, const float* pData,
+                   const size_t pCount, const unsigned pNComps);
+
+/// Count values of [pMin, pMax] into pNBins bins of equal width, values
+/// outside of the range and NaN values are not counted. pStride is the
+/// distance in elements between consecutive values. pBinType is one of
+/// f32, s32 or u32.
+void computeHistogram(void* pBins, const fg::dtype pBinType, const unsigned pNBins,
+                      const float* pData, const size_t pCount,
+                      const float pMin, const float pMax, const unsigned pStride);
+
+/// pOut[i] = pIn[i] * pScale
+void convertToFloat(float* pOut, const unsigned char* pIn, const size_t pCount, const float pScale);
+
+void convertToFloat(float* pOut, const unsigned short* pIn, const size_t pCount, const float pScale);
+
+/// pOut[i*pNComps + c] = pIn[c][i]
+void interleave(float* pOut, const float* const* pIn, const unsigned pNComps, const size_t pCount);
+
+/// pOut[c][i] = pIn[i*pNComps + c]
+void deinterleave(float* const* pOut, const float* pIn, const unsigned pNComps, const size_t pCount);
+
+}
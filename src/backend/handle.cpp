@@ -24,6 +24,16 @@ fg_image getHandle(common::Image* pValue)
     return reinterpret_cast<fg_image>(pValue);
 }
 
+fg_tiled_image getHandle(common::TiledImage* pValue)
+{
+    return reinterpret_cast<fg_tiled_image>(pValue);
+}
+
+fg_scheduler getHandle(common::Scheduler* pValue)
+{
+    return reinterpret_cast<fg_scheduler>(pValue);
+}
+
 fg_chart getHandle(common::Chart* pValue)
 {
     return reinterpret_cast<fg_chart>(pValue);
@@ -39,6 +49,11 @@ fg_plot getHandle(common::Plot* pValue)
     return reinterpret_cast<fg_plot>(pValue);
 }
 
+fg_plot_collection getHandle(common::PlotCollection* pValue)
+{
+    return reinterpret_cast<fg_plot_collection>(pValue);
+}
+
 fg_surface getHandle(common::Surface* pValue)
 {
     return reinterpret_cast<fg_surface>(pValue);
@@ -64,6 +79,16 @@ common::Image* getImage(const fg_image& pValue)
     return reinterpret_cast<common::Image*>(pValue);
 }
 
+common::TiledImage* getTiledImage(const fg_tiled_image& pValue)
+{
+    return reinterpret_cast<common::TiledImage*>(pValue);
+}
+
+common::Scheduler* getScheduler(const fg_scheduler& pValue)
+{
+    return reinterpret_cast<common::Scheduler*>(pValue);
+}
+
 common::Chart* getChart(const fg_chart& pValue)
 {
     return reinterpret_cast<common::Chart*>(pValue);
@@ -79,6 +104,11 @@ common::Plot* getPlot(const fg_plot& pValue)
     return reinterpret_cast<common::Plot*>(pValue);
 }
 
+common::PlotCollection* getPlotCollection(const fg_plot_collection& pValue)
+{
+    return reinterpret_cast<common::PlotCollection*>(pValue);
+}
+
 common::Surface* getSurface(const fg_surface& pValue)
 {
     return reinterpret_cast<common::Surface*>(pValue);
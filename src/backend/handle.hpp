@@ -14,6 +14,8 @@
 #include <window.hpp>
 #include <font.hpp>
 #include <image.hpp>
+#include <tiled_image.hpp>
+#include <scheduler.hpp>
 #include <chart.hpp>
 #include <chart_renderables.hpp>
 
@@ -23,12 +25,18 @@ fg_font getHandle(common::Font* pValue);
 
 fg_image getHandle(common::Image* pValue);
 
+fg_tiled_image getHandle(common::TiledImage* pValue);
+
+fg_scheduler getHandle(common::Scheduler* pValue);
+
 fg_chart getHandle(common::Chart* pValue);
 
 fg_histogram getHandle(common::Histogram* pValue);
 
 fg_plot getHandle(common::Plot* pValue);
 
+fg_plot_collection getHandle(common::PlotCollection* pValue);
+
 fg_surface getHandle(common::Surface* pValue);
 
 fg_vector_field getHandle(common::VectorField* pValue);
@@ -39,12 +47,18 @@ common::Font* getFont(const fg_font& pValue);
 
 common::Image* getImage(const fg_image& pValue);
 
+common::TiledImage* getTiledImage(const fg_tiled_image& pValue);
+
+common::Scheduler* getScheduler(const fg_scheduler& pValue);
+
 common::Chart* getChart(const fg_chart& pValue);
 
 common::Histogram* getHistogram(const fg_histogram& pValue);
 
 common::Plot* getPlot(const fg_plot& pValue);
 
+common::PlotCollection* getPlotCollection(const fg_plot_collection& pValue);
+
 common::Surface* getSurface(const fg_surface& pValue);
 
 common::VectorField* getVectorField(const fg_vector_field& pValue);
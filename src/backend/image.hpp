@@ -38,6 +38,25 @@ class Image {
 
         inline void keepAspectRatio(const bool pKeep) { mImage->keepAspectRatio(pKeep); }
 
+        inline void setValueRange(const float pMin, const float pMax,
+                                  const float pGamma, const bool pLogScale) {
+            mImage->setValueRange(pMin, pMax, pGamma, pLogScale);
+        }
+
+        inline void setFilter(const fg::FilterMode pFilter) { mImage->setFilter(pFilter); }
+
+        inline void setYUVMatrix(const fg::YUVMatrix pMatrix) { mImage->setYUVMatrix(pMatrix); }
+
+        inline void setColorMap(const float* pRGBA, const size_t pLength) {
+            mImage->setColorMap(pRGBA, pLength);
+        }
+
+        inline void markDirty() { mImage->markDirty(); }
+
+        inline void* map() { return mImage->map(); }
+
+        inline void unmap() { mImage->unmap(); }
+
         inline uint width() const { return mImage->width(); }
 
         inline uint height() const { return mImage->height(); }
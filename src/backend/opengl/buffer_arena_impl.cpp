@@ -0,0 +1,254 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <buffer_arena_impl.hpp>
+#include <err_opengl.hpp>
+#include <trace_impl.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+using namespace std;
+
+namespace opengl
+{
+
+static const size_t SLAB_SIZE       = 4 << 20;
+static const size_t BLOCK_ALIGNMENT = 256;
+
+static size_t alignUp(const size_t pSize)
+{
+    return (pSize + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+}
+
+buffer_arena_impl::buffer_arena_impl()
+    : mEnabled(false), mGeneration(0)
+{
+}
+
+buffer_arena_impl& buffer_arena_impl::instance()
+{
+    static buffer_arena_impl arena;
+    return arena;
+}
+
+buffer_arena_impl::Slab* buffer_arena_impl::createSlab(const size_t pSize, const bool pDedicated)
+{
+    std::unique_ptr<Slab> slab(new Slab());
+    slab->mBuffer    = createBuffer<uchar>(GL_ARRAY_BUFFER, pSize, NULL, GL_DYNAMIC_DRAW);
+    slab->mSize      = pSize;
+    slab->mUsed      = 0;
+    slab->mDedicated = pDedicated;
+    slab->mFree[0]   = pSize;
+    mSlabs.push_back(std::move(slab));
+    return mSlabs.back().get();
+}
+
+void buffer_arena_impl::destroySlab(Slab* pSlab)
+{
+    glDeleteBuffers(1, &pSlab->mBuffer);
+    for (auto it = mSlabs.begin(); it != mSlabs.end(); ++it) {
+        if (it->get() == pSlab) {
+            mSlabs.erase(it);
+            break;
+        }
+    }
+}
+
+buffer_arena_impl::Block* buffer_arena_impl::allocate(const size_t pSize, GLuint* pHandle)
+{
+    CheckGL("Begin buffer_arena_impl::allocate");
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    const size_t size = alignUp(std::max(pSize, size_t(1)));
+
+    Slab*  slab   = NULL;
+    size_t offset = 0;
+    if (size > SLAB_SIZE / 4) {
+        slab = createSlab(size, true);
+    } else {
+        for (auto& s : mSlabs) {
+            if (s->mDedicated)
+                continue;
+            for (auto& range : s->mFree) {
+                if (range.second >= size) {
+                    slab   = s.get();
+                    offset = range.first;
+                    break;
+                }
+            }
+            if (slab)
+                break;
+        }
+        if (!slab)
+            slab = createSlab(SLAB_SIZE, false);
+    }
+
+    auto range = slab->mFree.find(offset);
+    const size_t remaining = range->second - size;
+    slab->mFree.erase(range);
+    if (remaining)
+        slab->mFree[offset + size] = remaining;
+    slab->mUsed += size;
+
+    Block* block   = new Block();
+    block->mHandle = pHandle;
+    block->mSlab   = slab;
+    block->mOffset = offset;
+    block->mSize   = size;
+    mBlocks.insert(block);
+
+    *pHandle = slab->mBuffer;
+    CheckGL("End buffer_arena_impl::allocate");
+    return block;
+}
+
+void buffer_arena_impl::release(Block* pBlock)
+{
+    CheckGL("Begin buffer_arena_impl::release");
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    Slab*  slab   = pBlock->mSlab;
+    size_t offset = pBlock->mOffset;
+    size_t size   = pBlock->mSize;
+
+    mBlocks.erase(pBlock);
+    delete pBlock;
+
+    slab->mUsed -= size;
+    /* merge with free ranges on either side */
+    auto next = slab->mFree.lower_bound(offset);
+    if (next != slab->mFree.end() && next->first == offset + size) {
+        size += next->second;
+        next = slab->mFree.erase(next);
+    }
+    if (next != slab->mFree.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            size  += prev->second;
+            slab->mFree.erase(prev);
+        }
+    }
+    slab->mFree[offset] = size;
+
+    /* one empty slab is kept around for the next renderables */
+    if (slab->mUsed == 0) {
+        bool spare = slab->mDedicated;
+        for (auto& s : mSlabs)
+            spare = spare || (s.get() != slab && !s->mDedicated && s->mUsed == 0);
+        if (spare)
+            destroySlab(slab);
+    }
+    CheckGL("End buffer_arena_impl::release");
+}
+
+void buffer_arena_impl::defragment()
+{
+    CheckGL("Begin buffer_arena_impl::defragment");
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    /* blocks of shared slabs in the order they are laid out */
+    std::vector<Block*> blocks;
+    size_t slabCount = 0, holes = 0;
+    for (auto& s : mSlabs) {
+        if (s->mDedicated)
+            continue;
+        ++slabCount;
+        for (auto& range : s->mFree)
+            holes += (range.first + range.second != s->mSize);
+    }
+    for (Block* b : mBlocks) {
+        if (!b->mSlab->mDedicated)
+            blocks.push_back(b);
+    }
+    std::sort(blocks.begin(), blocks.end(), [](const Block* pA, const Block* pB) {
+                  return pA->mSlab != pB->mSlab ? pA->mSlab < pB->mSlab
+                                                : pA->mOffset < pB->mOffset;
+              });
+
+    size_t packedCount = 0, fill = SLAB_SIZE;
+    for (Block* b : blocks) {
+        if (fill + b->mSize > SLAB_SIZE) {
+            ++packedCount;
+            fill = 0;
+        }
+        fill += b->mSize;
+    }
+    if (holes == 0 && packedCount >= slabCount) {
+        CheckGL("End buffer_arena_impl::defragment");
+        return;
+    }
+
+    FG_TRACE_GPU_SCOPE("buffer_arena_impl::defragment");
+    std::vector<Slab*> oldSlabs;
+    for (auto& s : mSlabs) {
+        if (!s->mDedicated)
+            oldSlabs.push_back(s.get());
+    }
+
+    /* new slabs are filled front to back, what is left
+     * at the end of each is its only free range */
+    Slab* target = NULL;
+    auto closeSlab = [](Slab* pSlab) {
+        pSlab->mFree.clear();
+        if (pSlab->mUsed < pSlab->mSize)
+            pSlab->mFree[pSlab->mUsed] = pSlab->mSize - pSlab->mUsed;
+    };
+    for (Block* b : blocks) {
+        if (!target || target->mUsed + b->mSize > SLAB_SIZE) {
+            if (target)
+                closeSlab(target);
+            target = createSlab(SLAB_SIZE, false);
+        }
+        glBindBuffer(GL_COPY_READ_BUFFER, b->mSlab->mBuffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, target->mBuffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                            b->mOffset, target->mUsed, b->mSize);
+        b->mSlab    = target;
+        b->mOffset  = target->mUsed;
+        *b->mHandle = target->mBuffer;
+        target->mUsed += b->mSize;
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    if (target)
+        closeSlab(target);
+
+    for (Slab* s : oldSlabs)
+        destroySlab(s);
+
+    ++mGeneration;
+    CheckGL("End buffer_arena_impl::defragment");
+}
+
+void buffer_arena_impl::stats(fg_buffer_arena_stats& pOut)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    pOut.mSlabCount        = (unsigned)mSlabs.size();
+    pOut.mBlockCount       = (unsigned)mBlocks.size();
+    pOut.mFreeRangeCount   = 0;
+    pOut.mSlabBytes        = 0;
+    pOut.mUsedBytes        = 0;
+    pOut.mLargestFreeRange = 0;
+    pOut.mGeneration       = mGeneration;
+    for (auto& s : mSlabs) {
+        pOut.mSlabBytes += s->mSize;
+        pOut.mUsedBytes += s->mUsed;
+        if (s->mDedicated)
+            continue;
+        pOut.mFreeRangeCount += (unsigned)s->mFree.size();
+        for (auto& range : s->mFree)
+            pOut.mLargestFreeRange = std::max<unsigned long long>(pOut.mLargestFreeRange,
+                                                                   range.second);
+    }
+}
+
+}
@@ -0,0 +1,105 @@
+/*******************************************************
+* Copyright (c) 2015-2019, ArrayFire
+* All rights reserved.
+*
+* This file is distributed under 3-clause BSD license.
+* The complete license agreement can be obtained at:
+* http://arrayfire.com/licenses/BSD-3-Clause
+********************************************************/
+
+#pragma once
+
+#include <common.hpp>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace opengl
+{
+
+/* Sub-allocates vertex storage of renderables out of a few large buffers
+ *
+ * Blocks are carved out of slabs by first fit over free ranges ordered by
+ * offset, released blocks merge with the free ranges next to them. Requests
+ * larger than a quarter of a slab get a slab of their own, which is deleted
+ * along with the block. Offsets are aligned such that blocks can be mapped
+ * and used as attribute offsets of any type.
+ *
+ * Slabs are created in the context that is current at the time, hence
+ * windows drawing renderables backed by the arena have to share it.
+ *
+ * defragment packs live blocks into as few slabs as they fit in. Blocks
+ * then live in other buffer objects at other offsets, the buffer identifier
+ * held by the owner of a block is updated in place and generation is
+ * incremented so that owners re-specify their vertex arrays.
+ */
+class buffer_arena_impl {
+    private:
+        struct Slab {
+            GLuint  mBuffer;
+            size_t  mSize;
+            size_t  mUsed;
+            bool    mDedicated;
+            /* offset to size of free ranges */
+            std::map<size_t, size_t> mFree;
+        };
+
+    public:
+        struct Block {
+            GLuint* mHandle;
+            Slab*   mSlab;
+            size_t  mOffset;
+            size_t  mSize;
+        };
+
+    private:
+        std::vector< std::unique_ptr<Slab> > mSlabs;
+        std::set<Block*>                     mBlocks;
+        std::mutex                           mMutex;
+        std::atomic<bool>                    mEnabled;
+        std::atomic<unsigned long long>      mGeneration;
+
+        buffer_arena_impl();
+        /* buffers are left to the contexts they belong to,
+         * which are already gone at exit */
+        ~buffer_arena_impl() {}
+
+        Slab* createSlab(const size_t pSize, const bool pDedicated);
+        void destroySlab(Slab* pSlab);
+
+    public:
+        static buffer_arena_impl& instance();
+
+        /* renderables created while the arena is enabled take their
+         * vertex storage from it, it is disabled by default */
+        bool enabled() const { return mEnabled; }
+        void setEnabled(const bool pEnable) { mEnabled = pEnable; }
+
+        unsigned long long generation() const { return mGeneration; }
+
+        /* Allocate pSize bytes
+         *
+         * @pHandle receives the buffer object identifier of the block
+         *          and is kept current until the block is released
+         *
+         * @return block whose mOffset is the start of the storage
+         */
+        Block* allocate(const size_t pSize, GLuint* pHandle);
+
+        void release(Block* pBlock);
+
+        /* Move live blocks into as few slabs as needed
+         *
+         * Copies are done on the GPU, the context that owns the
+         * slabs has to be current on the calling thread.
+         */
+        void defragment();
+
+        void stats(fg_buffer_arena_stats& pOut);
+};
+
+}
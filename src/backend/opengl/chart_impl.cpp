@@ -16,7 +16,9 @@
 #include <image_impl.hpp>
 #include <histogram_impl.hpp>
 #include <plot_impl.hpp>
+#include <profiler_impl.hpp>
 #include <surface_impl.hpp>
+#include <trace_impl.hpp>
 #include <window_impl.hpp>
 #include <shader_headers/chart_vs.hpp>
 #include <shader_headers/chart_fs.hpp>
@@ -162,9 +164,9 @@ AbstractChart::~AbstractChart()
     CheckGL("End AbstractChart::~AbstractChart");
 }
 
-void AbstractChart::setAxesLimits(const float pXmin, const float pXmax,
-                                  const float pYmin, const float pYmax,
-                                  const float pZmin, const float pZmax)
+void AbstractChart::setAxesLimits(const double pXmin, const double pXmax,
+                                  const double pYmin, const double pYmax,
+                                  const double pZmin, const double pZmax)
 {
     mXMax = pXmax; mXMin = pXmin;
     mYMax = pYmax; mYMin = pYmin;
@@ -177,6 +179,7 @@ void AbstractChart::setAxesLimits(const float pXmin, const float pXmax,
      * derived class
      */
     generateTickLabels();
+    ++mVersion;
 }
 
 void AbstractChart::setAxesTitles(const char* pXTitle,
@@ -187,12 +190,14 @@ void AbstractChart::setAxesTitles(const char* pXTitle,
     mYTitle = std::string(pYTitle);
     if (pZTitle)
         mZTitle = std::string(pZTitle);
+    ++mVersion;
 }
 
 void AbstractChart::setLegendPosition(const float pX, const float pY)
 {
     mLegendX = pX;
     mLegendY = pY;
+    ++mVersion;
 }
 
 float AbstractChart::xmax() const { return mXMax; }
@@ -205,6 +210,23 @@ float AbstractChart::zmin() const { return mZMin; }
 void AbstractChart::addRenderable(const std::shared_ptr<AbstractRenderable> pRenderable)
 {
     mRenderables.emplace_back(pRenderable);
+    ++mVersion;
+}
+
+unsigned long long AbstractChart::version()
+{
+    /* versions never decrease, hence their sum
+     * changes whenever any of the renderables does */
+    unsigned long long result = mVersion;
+    for (auto& renderable : mRenderables)
+        result += renderable->version();
+    return result;
+}
+
+void AbstractChart::setColorMapParams(const GLuint pTexture, const GLuint pLength)
+{
+    for (auto& renderable : mRenderables)
+        renderable->setColorMapParams(pTexture, pLength);
 }
 
 /********************* END-AbstractChart *********************/
@@ -343,10 +365,10 @@ void chart2d_impl::generateTickLabels()
     mYText.clear();
     mZText.clear();
 
-    float xstep = getTickStepSize(mXMin, mXMax);
-    float ystep = getTickStepSize(mYMin, mYMax);
-    float xmid  = (mXMax+mXMin)/2.0f;
-    float ymid  = (mYMax+mYMin)/2.0f;
+    double xstep = getTickStepSize(mXMin, mXMax);
+    double ystep = getTickStepSize(mYMin, mYMax);
+    double xmid  = (mXMax+mXMin)/2.0;
+    double ymid  = (mYMax+mYMin)/2.0;
 
     int ticksLeft = getNumTicksC2E();
 
@@ -383,6 +405,8 @@ void chart2d_impl::render(const int pWindowId,
                           const glm::mat4& pView)
 {
     CheckGL("Begin chart2d_impl::renderChart");
+    ProfileScope scope(FG_STAT_CHART, this);
+    FG_TRACE_GPU_SCOPE("chart2d_impl::render");
 
     float lgap     = mLeftMargin + mTickSize/2;
     float bgap     = mBottomMargin + mTickSize/2;
@@ -407,6 +431,7 @@ void chart2d_impl::render(const int pWindowId,
     glUniformMatrix4fv(mBorderUniformMatIndex, 1, GL_FALSE, glm::value_ptr(trans));
     glUniform4fv(mBorderUniformColorIndex, 1, GRAY);
     glDrawArrays(GL_LINES, 4+2*mTickCount, 4*mTickCount);
+    countDrawCall();
     glUseProgram(0);
     chart2d_impl::unbindResources();
 
@@ -416,6 +441,7 @@ void chart2d_impl::render(const int pWindowId,
     for (auto renderable : mRenderables) {
         renderable->setRanges(mXMin, mXMax, mYMin, mYMax, mZMin, mZMax);
         renderable->render(pWindowId, pX, pY, pVPW, pVPH, pView * trans);
+        renderable->markRendered();
     }
     glDisable(GL_SCISSOR_TEST);
 
@@ -426,6 +452,7 @@ void chart2d_impl::render(const int pWindowId,
     glUniform4fv(mBorderUniformColorIndex, 1, BLACK);
     /* Draw borders */
     glDrawArrays(GL_LINE_LOOP, 0, 4);
+    countDrawCall();
     glUseProgram(0);
 
     /* bind the sprite shader program to
@@ -438,9 +465,11 @@ void chart2d_impl::render(const int pWindowId,
     /* Draw tick marks on y axis */
     glUniform1i(mSpriteUniformTickaxisIndex, 1);
     glDrawArrays(GL_POINTS, 4, mTickCount);
+    countDrawCall();
     /* Draw tick marks on x axis */
     glUniform1i(mSpriteUniformTickaxisIndex, 0);
     glDrawArrays(GL_POINTS, 4+mTickCount, mTickCount);
+    countDrawCall();
 
     glUseProgram(0);
     glPointSize(1);
@@ -675,12 +704,12 @@ void chart3d_impl::generateTickLabels()
     mYText.clear();
     mZText.clear();
 
-    float xstep = getTickStepSize(mXMin, mXMax);
-    float ystep = getTickStepSize(mYMin, mYMax);
-    float zstep = getTickStepSize(mZMin, mZMax);
-    float xmid  = (mXMax+mXMin)/2.0f;
-    float ymid  = (mYMax+mYMin)/2.0f;
-    float zmid  = (mZMax+mZMin)/2.0f;
+    double xstep = getTickStepSize(mXMin, mXMax);
+    double ystep = getTickStepSize(mYMin, mYMax);
+    double zstep = getTickStepSize(mZMin, mZMax);
+    double xmid  = (mXMax+mXMin)/2.0;
+    double ymid  = (mYMax+mYMin)/2.0;
+    double zmid  = (mZMax+mZMin)/2.0;
 
     int ticksLeft = getNumTicksC2E();
 
@@ -725,6 +754,8 @@ void chart3d_impl::render(const int pWindowId,
     static const glm::mat4 PVM = PV * MODEL;
 
     CheckGL("Being chart3d_impl::renderChart");
+    ProfileScope scope(FG_STAT_CHART, this);
+    FG_TRACE_GPU_SCOPE("chart3d_impl::render");
 
     /* draw grid */
     chart3d_impl::bindResources(pWindowId);
@@ -732,6 +763,7 @@ void chart3d_impl::render(const int pWindowId,
     glUniformMatrix4fv(mBorderUniformMatIndex, 1, GL_FALSE, glm::value_ptr(PVM));
     glUniform4fv(mBorderUniformColorIndex, 1, GRAY);
     glDrawArrays(GL_LINES, 6+3*mTickCount, 12*mTickCount);
+    countDrawCall();
     glUseProgram(0);
     chart3d_impl::unbindResources();
 
@@ -742,6 +774,7 @@ void chart3d_impl::render(const int pWindowId,
     for (auto renderable : mRenderables) {
         renderable->setRanges(mXMin, mXMax, mYMin, mYMax, mZMin, mZMax);
         renderable->render(pWindowId, pX, pY, pVPW, pVPH, renderableMat);
+        renderable->markRendered();
     }
     glDisable(GL_SCISSOR_TEST);
 
@@ -752,6 +785,7 @@ void chart3d_impl::render(const int pWindowId,
     glUniformMatrix4fv(mBorderUniformMatIndex, 1, GL_FALSE, glm::value_ptr(PVM));
     glUniform4fv(mBorderUniformColorIndex, 1, BLACK);
     glDrawArrays(GL_LINES, 0, 6);
+    countDrawCall();
     glUseProgram(0);
 
     /* bind the sprite shader program to
@@ -765,12 +799,15 @@ void chart3d_impl::render(const int pWindowId,
     /* Draw tick marks on z axis */
     glUniform1i(mSpriteUniformTickaxisIndex, 1);
     glDrawArrays(GL_POINTS, 6, mTickCount);
+    countDrawCall();
     /* Draw tick marks on y axis */
     glUniform1i(mSpriteUniformTickaxisIndex, 0);
     glDrawArrays(GL_POINTS, 6 + mTickCount, mTickCount);
+    countDrawCall();
     /* Draw tick marks on x axis */
     glUniform1i(mSpriteUniformTickaxisIndex, 0);
     glDrawArrays(GL_POINTS, 6 + (2*mTickCount), mTickCount);
+    countDrawCall();
 
     glUseProgram(0);
     glPointSize(1);
@@ -36,13 +36,14 @@ class AbstractChart : public AbstractRenderable {
         int   mRightMargin;
         int   mTopMargin;
         int   mBottomMargin;
-        /* chart axes ranges and titles */
-        float mXMax;
-        float mXMin;
-        float mYMax;
-        float mYMin;
-        float mZMax;
-        float mZMin;
+        /* chart axes ranges and titles, ranges are kept in
+         * double precision for renderables of f64 data */
+        double mXMax;
+        double mXMin;
+        double mYMax;
+        double mYMin;
+        double mZMax;
+        double mZMin;
         std::string mXTitle;
         std::string mYTitle;
         std::string mZTitle;
@@ -67,7 +68,7 @@ class AbstractChart : public AbstractRenderable {
         std::vector< std::shared_ptr<AbstractRenderable> > mRenderables;
 
         /* rendering helper functions */
-        inline float getTickStepSize(float minval, float maxval) const {
+        inline double getTickStepSize(double minval, double maxval) const {
             return (maxval-minval)/(mTickCount-1);
         }
 
@@ -98,9 +99,9 @@ class AbstractChart : public AbstractRenderable {
                            const char* pYTitle,
                            const char* pZTitle);
 
-        void setAxesLimits(const float pXmin, const float pXmax,
-                           const float pYmin, const float pYmax,
-                           const float pZmin, const float pZmax);
+        void setAxesLimits(const double pXmin, const double pXmax,
+                           const double pYmin, const double pYmax,
+                           const double pZmin, const double pZmax);
 
         void setLegendPosition(const float pX, const float pY);
 
@@ -112,6 +113,11 @@ class AbstractChart : public AbstractRenderable {
         float zmin() const;
 
         void addRenderable(const std::shared_ptr<AbstractRenderable> pRenderable);
+
+        unsigned long long version() override;
+
+        /* color map of the window is passed on to renderables */
+        void setColorMapParams(const GLuint pTexture, const GLuint pLength) override;
 };
 
 class chart2d_impl : public AbstractChart {
@@ -8,117 +8,86 @@
 ********************************************************/
 
 #include <common.hpp>
+#include <err_opengl.hpp>
 #include <colormap_impl.hpp>
 #include <cmap.hpp>
 
-#define CREATE_UNIFORM_BUFFER(color_array, size)  \
-    createBuffer(GL_UNIFORM_BUFFER, 4*size, color_array, GL_STATIC_DRAW)
-
 namespace opengl
 {
 
-colormap_impl::colormap_impl()
-    :mDefaultMapBuffer(0), mSpecMapBuffer(0), mColorsMapBuffer(0),
-    mRedMapBuffer(0), mMoodMapBuffer(0), mHeatMapBuffer(0),
-    mBlueMapBuffer(0)
+static const float* colorMapData(const fg::ColorMap pMap, GLuint& pLength)
 {
     size_t channel_bytes = sizeof(float)*4; /* 4 is for 4 channels */
-    mDefMapLen  = (GLuint)(sizeof(cmap_default) /channel_bytes);
-    mSpecMapLen = (GLuint)(sizeof(cmap_spectrum)/channel_bytes);
-    mColsMapLen = (GLuint)(sizeof(cmap_colors)  /channel_bytes);
-    mRedMapLen  = (GLuint)(sizeof(cmap_red)     /channel_bytes);
-    mMoodMapLen = (GLuint)(sizeof(cmap_mood)    /channel_bytes);
-    mHeatMapLen = (GLuint)(sizeof(cmap_heat)    /channel_bytes);
-    mBlueMapLen = (GLuint)(sizeof(cmap_blue)    /channel_bytes);
-
-    mDefaultMapBuffer = CREATE_UNIFORM_BUFFER(cmap_default, mDefMapLen);
-    mSpecMapBuffer    = CREATE_UNIFORM_BUFFER(cmap_spectrum, mSpecMapLen);
-    mColorsMapBuffer  = CREATE_UNIFORM_BUFFER(cmap_colors, mColsMapLen);
-    mRedMapBuffer     = CREATE_UNIFORM_BUFFER(cmap_red, mRedMapLen);
-    mMoodMapBuffer    = CREATE_UNIFORM_BUFFER(cmap_mood, mMoodMapLen);
-    mHeatMapBuffer    = CREATE_UNIFORM_BUFFER(cmap_heat, mHeatMapLen);
-    mBlueMapBuffer    = CREATE_UNIFORM_BUFFER(cmap_blue, mBlueMapLen);
-}
-
-colormap_impl::~colormap_impl()
-{
-    glDeleteBuffers(1, &mDefaultMapBuffer);
-    glDeleteBuffers(1, &mSpecMapBuffer);
-    glDeleteBuffers(1, &mColorsMapBuffer);
-    glDeleteBuffers(1, &mRedMapBuffer);
-    glDeleteBuffers(1, &mMoodMapBuffer);
-    glDeleteBuffers(1, &mHeatMapBuffer);
-    glDeleteBuffers(1, &mBlueMapBuffer);
-}
-
-GLuint colormap_impl::defaultMap() const
-{
-    return mDefaultMapBuffer;
+    switch(pMap) {
+        case FG_COLOR_MAP_SPECTRUM:
+            pLength = (GLuint)(sizeof(cmap_spectrum)/channel_bytes); return cmap_spectrum;
+        case FG_COLOR_MAP_COLORS:
+            pLength = (GLuint)(sizeof(cmap_colors)  /channel_bytes); return cmap_colors;
+        case FG_COLOR_MAP_RED:
+            pLength = (GLuint)(sizeof(cmap_red)     /channel_bytes); return cmap_red;
+        case FG_COLOR_MAP_MOOD:
+            pLength = (GLuint)(sizeof(cmap_mood)    /channel_bytes); return cmap_mood;
+        case FG_COLOR_MAP_HEAT:
+            pLength = (GLuint)(sizeof(cmap_heat)    /channel_bytes); return cmap_heat;
+        case FG_COLOR_MAP_BLUE:
+            pLength = (GLuint)(sizeof(cmap_blue)    /channel_bytes); return cmap_blue;
+        default:
+            pLength = (GLuint)(sizeof(cmap_default) /channel_bytes); return cmap_default;
+    }
+}
+
+GLuint createColorMapTexture(const float* pRGBA, const size_t pLength)
+{
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    if (pRGBA == NULL || pLength == 0 || pLength > size_t(maxSize))
+        throw fg::ArgumentError("createColorMapTexture", __LINE__, 1,
+                                "Color map should have atleast one and atmost GL_MAX_TEXTURE_SIZE colors");
+
+    CheckGL("Begin createColorMapTexture");
+    GLuint tex = 0;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_1D, tex);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexImage1D(GL_TEXTURE_1D, 0, GL_RGBA32F, (GLsizei)pLength, 0, GL_RGBA, GL_FLOAT, pRGBA);
+    glBindTexture(GL_TEXTURE_1D, 0);
+    CheckGL("End createColorMapTexture");
+    return tex;
 }
 
-GLuint colormap_impl::spectrum() const
-{
-    return mSpecMapBuffer;
-}
-
-GLuint colormap_impl::colors() const
-{
-    return mColorsMapBuffer;
-}
-
-GLuint colormap_impl::red() const
-{
-    return mRedMapBuffer;
-}
-
-GLuint colormap_impl::mood() const
-{
-    return mMoodMapBuffer;
-}
-
-GLuint colormap_impl::heat() const
-{
-    return mHeatMapBuffer;
-}
-
-GLuint colormap_impl::blue() const
-{
-    return mBlueMapBuffer;
-}
-
-GLuint colormap_impl::defaultLen() const
-{
-    return mDefMapLen;
-}
-
-GLuint colormap_impl::spectrumLen() const
-{
-    return mSpecMapLen;
-}
-
-GLuint colormap_impl::colorsLen() const
-{
-    return mColsMapLen;
-}
-
-GLuint colormap_impl::redLen() const
+colormap_impl::colormap_impl()
 {
-    return mRedMapLen;
+    for (int i = 0; i < NUM_MAPS; ++i) {
+        mMaps[i] = 0;
+        colorMapData((fg::ColorMap)i, mMapLens[i]);
+    }
 }
 
-GLuint colormap_impl::moodLen() const
+colormap_impl::~colormap_impl()
 {
-    return mMoodMapLen;
+    for (int i = 0; i < NUM_MAPS; ++i) {
+        if (mMaps[i])
+            glDeleteTextures(1, &mMaps[i]);
+    }
 }
 
-GLuint colormap_impl::heatLen() const
+GLuint colormap_impl::cmap(const fg::ColorMap pMap)
 {
-    return mHeatMapLen;
+    int idx = (pMap >= 0 && pMap < NUM_MAPS) ? pMap : FG_COLOR_MAP_DEFAULT;
+    if (mMaps[idx] == 0) {
+        GLuint len = 0;
+        const float* data = colorMapData((fg::ColorMap)idx, len);
+        mMaps[idx] = createColorMapTexture(data, len);
+    }
+    return mMaps[idx];
 }
 
-GLuint colormap_impl::blueLen() const
+GLuint colormap_impl::length(const fg::ColorMap pMap) const
 {
-    return mBlueMapLen;
+    int idx = (pMap >= 0 && pMap < NUM_MAPS) ? pMap : FG_COLOR_MAP_DEFAULT;
+    return mMapLens[idx];
 }
 
 }
@@ -15,57 +15,33 @@
 namespace opengl
 {
 
+/* Create a 1D texture from @pLength RGBA colors pointed to by @pRGBA
+ *
+ * The texture uses linear filtering, hence shaders sampling it at texel
+ * centers get an interpolated color between the neighbouring entries.
+ */
+GLuint createColorMapTexture(const float* pRGBA, const size_t pLength);
+
 class colormap_impl {
     private:
+        static const int NUM_MAPS = FG_COLOR_MAP_BLUE + 1;
+
         /*
-         * READ THIS BEFORE ADDING NEW COLORMAP
-         *
-         * each of the following buffers will point
-         * to the data from floating point arrays
-         * defined in cmap.hpp header. Currently,
-         * the largest colormap is 506 colors(1520 floats).
-         * Hence the shader of internal::image_impl uses
-         * uniform array of floats with size 1536 (512 color triplets).
-         * when a new colormap is added, make sure
-         * the size of array declared in the shaders
-         * used by *_impl objects to reflect appropriate
-         * size */
-        GLuint mDefaultMapBuffer;
-        GLuint mSpecMapBuffer;
-        GLuint mColorsMapBuffer;
-        GLuint mRedMapBuffer;
-        GLuint mMoodMapBuffer;
-        GLuint mHeatMapBuffer;
-        GLuint mBlueMapBuffer;
-        /* Current color map lengths */
-        GLuint mDefMapLen;
-        GLuint mSpecMapLen;
-        GLuint mColsMapLen;
-        GLuint mRedMapLen;
-        GLuint mMoodMapLen;
-        GLuint mHeatMapLen;
-        GLuint mBlueMapLen;
+         * Each color map is a 1D texture built from the
+         * floating point arrays defined in cmap.hpp header.
+         * Textures are created on first use, hence only
+         * the maps that are actually used occupy memory.
+         */
+        GLuint mMaps[NUM_MAPS];
+        GLuint mMapLens[NUM_MAPS];
 
     public:
         /* constructors and destructors */
         colormap_impl();
         ~colormap_impl();
 
-        GLuint defaultMap() const;
-        GLuint spectrum() const;
-        GLuint colors() const;
-        GLuint red() const;
-        GLuint mood() const;
-        GLuint heat() const;
-        GLuint blue() const;
-
-        GLuint defaultLen() const;
-        GLuint spectrumLen() const;
-        GLuint colorsLen() const;
-        GLuint redLen() const;
-        GLuint moodLen() const;
-        GLuint heatLen() const;
-        GLuint blueLen() const;
+        GLuint cmap(const fg::ColorMap pMap);
+        GLuint length(const fg::ColorMap pMap) const;
 };
 
 }
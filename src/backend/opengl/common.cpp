@@ -8,10 +8,13 @@
  ********************************************************/
 
 #include <common.hpp>
+#include <trace_impl.hpp>
 #include <window_impl.hpp>
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
 #include <fstream>
@@ -38,10 +41,20 @@ GLenum dtype2gl(const fg::dtype pValue)
         case u32: return GL_UNSIGNED_INT;
         case s16: return GL_SHORT;
         case u16: return GL_UNSIGNED_SHORT;
+        case f16: return GL_HALF_FLOAT;
+        case un8: return GL_UNSIGNED_BYTE;
+        case un16: return GL_UNSIGNED_SHORT;
+        case sn16: return GL_SHORT;
+        case f64: return GL_DOUBLE;
         default:  return GL_FLOAT;
     }
 }
 
+GLboolean isNormalized(const fg::dtype pValue)
+{
+    return (pValue == un8 || pValue == un16 || pValue == sn16) ? GL_TRUE : GL_FALSE;
+}
+
 GLenum ctype2gl(const ChannelFormat pMode)
 {
     switch(pMode) {
@@ -50,13 +63,22 @@ GLenum ctype2gl(const ChannelFormat pMode)
         case FG_RGB : return GL_RGB;
         case FG_BGR : return GL_BGR;
         case FG_BGRA: return GL_BGRA;
+        /* NV12 luma plane and Bayer mosaic are single
+         * channel, YUYV pixel pairs are four channels */
+        case FG_NV12:
+        case FG_BAYER_RGGB:
+        case FG_BAYER_BGGR:
+        case FG_BAYER_GRBG:
+        case FG_BAYER_GBRG: return GL_RED;
         default     : return GL_RGBA;
     }
 }
 
 GLenum ictype2gl(const ChannelFormat pMode)
 {
-    if (pMode==FG_GRAYSCALE)
+    if (pMode==FG_GRAYSCALE || pMode==FG_NV12 ||
+        pMode==FG_BAYER_RGGB || pMode==FG_BAYER_BGGR ||
+        pMode==FG_BAYER_GRBG || pMode==FG_BAYER_GBRG)
         return GL_RED;
     else if (pMode==FG_RG)
         return GL_RG;
@@ -66,6 +88,70 @@ GLenum ictype2gl(const ChannelFormat pMode)
     return GL_RGBA;
 }
 
+GLenum ictype2gl(const ChannelFormat pMode, const fg::dtype pType)
+{
+    /* sized formats ordered by number of components */
+    static const GLenum u8Fmts[]  = {GL_R8,         GL_RG8,         GL_RGB8,         GL_RGBA8        };
+    static const GLenum s8Fmts[]  = {GL_R8_SNORM,   GL_RG8_SNORM,   GL_RGB8_SNORM,   GL_RGBA8_SNORM  };
+    static const GLenum u16Fmts[] = {GL_R16,        GL_RG16,        GL_RGB16,        GL_RGBA16       };
+    static const GLenum s16Fmts[] = {GL_R16_SNORM,  GL_RG16_SNORM,  GL_RGB16_SNORM,  GL_RGBA16_SNORM };
+    static const GLenum u32Fmts[] = {GL_R32UI,      GL_RG32UI,      GL_RGB32UI,      GL_RGBA32UI     };
+    static const GLenum s32Fmts[] = {GL_R32I,       GL_RG32I,       GL_RGB32I,       GL_RGBA32I      };
+    static const GLenum f16Fmts[] = {GL_R16F,       GL_RG16F,       GL_RGB16F,       GL_RGBA16F      };
+    static const GLenum f32Fmts[] = {GL_R32F,       GL_RG32F,       GL_RGB32F,       GL_RGBA32F      };
+
+    int idx = 3;
+    switch(ictype2gl(pMode)) {
+        case GL_RED: idx = 0; break;
+        case GL_RG : idx = 1; break;
+        case GL_RGB: idx = 2; break;
+        default    : idx = 3; break;
+    }
+
+    switch(pType) {
+        case s8:  return s8Fmts[idx];
+        case un8:
+        case u8:  return u8Fmts[idx];
+        case sn16:
+        case s16: return s16Fmts[idx];
+        case un16:
+        case u16: return u16Fmts[idx];
+        case f16: return f16Fmts[idx];
+        case s32: return s32Fmts[idx];
+        case u32: return u32Fmts[idx];
+        default:  return f32Fmts[idx];
+    }
+}
+
+GLenum ctype2gl(const ChannelFormat pMode, const fg::dtype pType)
+{
+    if (!isIntegerTexture(pType))
+        return ctype2gl(pMode);
+
+    switch(pMode) {
+        case FG_GRAYSCALE: return GL_RED_INTEGER;
+        case FG_RG  : return GL_RG_INTEGER;
+        case FG_RGB : return GL_RGB_INTEGER;
+        case FG_BGR : return GL_BGR_INTEGER;
+        case FG_BGRA: return GL_BGRA_INTEGER;
+        default     : return GL_RGBA_INTEGER;
+    }
+}
+
+bool isIntegerTexture(const fg::dtype pType)
+{
+    return (pType == s32 || pType == u32);
+}
+
+std::string addShaderDefines(const std::string& pSource, const std::string& pDefines)
+{
+    size_t pos = pSource.find("#version");
+    pos = (pos == std::string::npos ? 0 : pSource.find('\n', pos));
+    if (pos == std::string::npos)
+        return pSource + "\n" + pDefines;
+    return pSource.substr(0, pos + 1) + pDefines + "\n" + pSource.substr(pos + 1);
+}
+
 void printShaderInfoLog(GLint pShader)
 {
     int infoLogLen = 0;
@@ -171,17 +257,57 @@ Shaders loadShaders(const char* pVertexShaderSrc,
 
 GLuint initShaders(const char* pVertShaderSrc, const char* pFragShaderSrc, const char* pGeomShaderSrc)
 {
+    FG_TRACE_SCOPE("initShaders");
     Shaders shrds = loadShaders(pVertShaderSrc, pFragShaderSrc, pGeomShaderSrc);
     GLuint shaderProgram = glCreateProgram();
     attachAndLinkProgram(shaderProgram, shrds);
     return shaderProgram;
 }
 
+GLuint initFeedbackShader(const char* pVertShaderSrc, const char* pVarying)
+{
+    FG_TRACE_SCOPE("initShaders");
+    GLuint v = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(v, 1, &pVertShaderSrc, NULL);
+
+    GLint compiled;
+    glCompileShader(v);
+    glGetShaderiv(v, GL_COMPILE_STATUS, &compiled);
+    if (!compiled) {
+        std::cerr << "Vertex shader not compiled." << std::endl;
+        printShaderInfoLog(v);
+    }
+
+    GLuint shaderProgram = glCreateProgram();
+    glAttachShader(shaderProgram, v);
+    glTransformFeedbackVaryings(shaderProgram, 1, &pVarying, GL_INTERLEAVED_ATTRIBS);
+
+    glLinkProgram(shaderProgram);
+    GLint linked;
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        std::cerr << "Program did not link." << std::endl;
+        throw fg::Error("initFeedbackShader", __LINE__,
+                "OpenGL program linking failed", FG_ERR_GL_ERROR);
+    }
+    printLinkInfoLog(shaderProgram);
+    return shaderProgram;
+}
+
 float clampTo01(const float pValue)
 {
     return (pValue < 0.0f ? 0.0f : (pValue>1.0f ? 1.0f : pValue));
 }
 
+int msaaSamples()
+{
+    static const int samples = [] {
+        const char* value = std::getenv("FG_MSAA_SAMPLES");
+        return (value != NULL && *value != '\0') ? std::max(0, std::atoi(value)) : 4;
+    }();
+    return samples;
+}
+
 #ifdef OS_WIN
 #include <windows.h>
 #include <strsafe.h>
@@ -246,7 +372,47 @@ void getFontFilePaths(std::vector<std::string>& pFiles,
 }
 #endif
 
-std::string toString(const float pVal, const int pPrecision)
+static void* mapBufferWith(const GLuint pBuffer, const size_t pOffset, const size_t pSize,
+                           const bool pSynchronize, GLbitfield pAccess)
+{
+    if (!pSynchronize)
+        pAccess |= GL_MAP_UNSYNCHRONIZED_BIT;
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pBuffer);
+    void* ptr = glMapBufferRange(GL_COPY_WRITE_BUFFER, pOffset, pSize, pAccess);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    if (ptr == NULL)
+        throw fg::Error("mapBuffer", __LINE__,
+                        "Failed to map buffer object", FG_ERR_GL_ERROR);
+    return ptr;
+}
+
+void* mapBuffer(const GLuint pBuffer, const size_t pSize, const bool pSynchronize)
+{
+    return mapBufferWith(pBuffer, 0, pSize, pSynchronize,
+                         GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+}
+
+void* mapBufferRange(const GLuint pBuffer, const size_t pOffset, const size_t pSize,
+                     const bool pSynchronize)
+{
+    return mapBufferWith(pBuffer, pOffset, pSize, pSynchronize,
+                         GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+}
+
+void unmapBuffer(const GLuint pBuffer)
+{
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pBuffer);
+    GLboolean status = glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    if (status == GL_FALSE)
+        throw fg::Error("unmapBuffer", __LINE__,
+                        "Buffer contents corrupted while mapped", FG_ERR_GL_ERROR);
+}
+
+std::string toString(const double pVal, const int pPrecision)
 {
     std::ostringstream out;
     out << std::fixed << std::setprecision(pPrecision) << pVal;
@@ -330,3 +496,60 @@ glm::vec3 trackballPoint(const float pX, const float pY,
     a = 1.0f / sqrt(x*x + y*y + z*z);
     return glm::vec3(x*a,y*a,z*a);
 }
+
+namespace opengl
+{
+
+GLuint AbstractRenderable::buffer(const BufferKind pKind, size_t& pSize)
+{
+    switch(pKind) {
+        case FG_VERTEX_BUFFER: pSize = vboSize(); return vbo();
+        case FG_COLOR_BUFFER : pSize = cboSize(); return cbo();
+        case FG_ALPHA_BUFFER : pSize = aboSize(); return abo();
+        default:
+            throw fg::ArgumentError("AbstractRenderable::buffer", __LINE__, 1,
+                                    "Buffer kind not supported by renderable");
+    }
+}
+
+void* AbstractRenderable::map(const BufferKind pKind)
+{
+    checkContextCurrent("AbstractRenderable::map");
+
+    size_t size = 0;
+    GLuint buf  = buffer(pKind, size);
+
+    /* when the fence of the last draw that read this renderable
+     * has already signaled, no pending draw can see the writes */
+    bool sync = true;
+    if (mRenderFence) {
+        GLenum status = glClientWaitSync(mRenderFence, 0, 0);
+        sync = !(status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED);
+    }
+
+    void* ptr = (sharesBuffers() ? mapBufferRange(buf, offset(pKind), size, sync)
+                                 : mapBuffer(buf, size, sync));
+    mUsesMap  = true;
+    return ptr;
+}
+
+void AbstractRenderable::unmap(const BufferKind pKind)
+{
+    checkContextCurrent("AbstractRenderable::unmap");
+
+    size_t size = 0;
+    unmapBuffer(buffer(pKind, size));
+    markDirty();
+}
+
+void AbstractRenderable::markRendered()
+{
+    if (!mUsesMap)
+        return;
+
+    if (mRenderFence)
+        glDeleteSync(mRenderFence);
+    mRenderFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+}
@@ -17,6 +17,9 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/string_cast.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <string>
 #include <vector>
 #include <iterator>
 
@@ -32,6 +35,14 @@ static const glm::mat4 IDENTITY(1.0f);
  */
 float clampTo01(const float pValue);
 
+/* Number of samples per pixel of window framebuffers
+ *
+ * Read from FG_MSAA_SAMPLES environment variable, defaults to 4. Lines
+ * of plots are anti-aliased on their own, zero saves the cost of
+ * multisampling when no other geometry needs it.
+ */
+int msaaSamples();
+
 /* Convert forge type enum to OpenGL enum for GL_* type
  *
  * @pValue is the forge type enum
@@ -40,6 +51,17 @@ float clampTo01(const float pValue);
  */
 GLenum dtype2gl(const fg::dtype pValue);
 
+/* Check if integer vertex data of given type is normalized when read
+ *
+ * Used as the normalized flag of glVertexAttribPointer. Normalized types
+ * share the GL type of their plain integer counterparts.
+ *
+ * @pValue is the forge type enum
+ *
+ * @return GL_TRUE for un8, un16 and sn16, GL_FALSE otherwise
+ */
+GLboolean isNormalized(const fg::dtype pValue);
+
 /* Convert forge channel format enum to OpenGL enum to indicate color component layout
  *
  * @pValue is the forge type enum
@@ -59,6 +81,51 @@ GLenum ctype2gl(const fg::ChannelFormat pMode);
  */
 GLenum ictype2gl(const fg::ChannelFormat pMode);
 
+/* Get the sized OpenGL internal texture format for given channel layout and data type
+ *
+ * 8 and 16 bit types map to normalized formats, 32 bit integer types map to
+ * non-normalized integer formats and floats map to float formats of same width. Hence,
+ * textures of any type retain the full precision of the source data.
+ *
+ * @pMode is the forge channel format enum
+ * @pType is the forge type enum
+ *
+ * @return OpenGL sized internal format enum
+ */
+GLenum ictype2gl(const fg::ChannelFormat pMode, const fg::dtype pType);
+
+/* Get the OpenGL pixel transfer format for given channel layout and data type
+ *
+ * Same as ctype2gl(pMode) except that 32 bit integer types use the
+ * GL_*_INTEGER formats required by integer textures.
+ *
+ * @pMode is the forge channel format enum
+ * @pType is the forge type enum
+ *
+ * @return OpenGL enum indicating color component layout
+ */
+GLenum ctype2gl(const fg::ChannelFormat pMode, const fg::dtype pType);
+
+/* Check if textures of given type are non-normalized integer textures
+ *
+ * @pType is the forge type enum
+ *
+ * @return true if type is sampled with isampler* or usampler* in shaders
+ */
+bool isIntegerTexture(const fg::dtype pType);
+
+/* Insert preprocessor definitions into a GLSL shader source
+ *
+ * The definitions are placed right after the #version directive
+ * so that a single shader source can be compiled in multiple variants.
+ *
+ * @pSource is the GLSL shader source
+ * @pDefines is the string with one or more #define lines
+ *
+ * @return shader source with definitions
+ */
+std::string addShaderDefines(const std::string& pSource, const std::string& pDefines);
+
 /* Compile OpenGL GLSL vertex and fragment shader sources
  *
  * @pVertShaderSrc is the vertex shader source code string
@@ -69,6 +136,18 @@ GLenum ictype2gl(const fg::ChannelFormat pMode);
  */
 GLuint initShaders(const char* pVertShaderSrc, const char* pFragShaderSrc, const char* pGeomShaderSrc=NULL);
 
+/* Compile a GLSL vertex shader whose output is captured by transform feedback
+ *
+ * The program has no fragment stage, it is meant to be run with
+ * GL_RASTERIZER_DISCARD enabled.
+ *
+ * @pVertShaderSrc is the vertex shader source code string
+ * @pVarying is the name of the vertex shader output that is captured
+ *
+ * @return GLSL program unique identifier
+ */
+GLuint initFeedbackShader(const char* pVertShaderSrc, const char* pVarying);
+
 /* Create OpenGL buffer object
  *
  * @pTarget should be either GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER
@@ -89,6 +168,45 @@ GLuint createBuffer(GLenum pTarget, size_t pSize, const T* pPtr, GLenum pUsage)
     return retVal;
 }
 
+/* Map entire buffer object for writing
+ *
+ * The previous contents of the buffer are invalidated, so the caller
+ * is expected to overwrite the full range before unmapping it.
+ *
+ * @pBuffer is the buffer object identifier
+ * @pSize is the size of the buffer in bytes
+ * @pSynchronize when false, the driver is told not to wait on
+ *               pending draws that read from the buffer
+ *
+ * @return pointer to the write only mapping, throws on failure
+ */
+void* mapBuffer(const GLuint pBuffer, const size_t pSize, const bool pSynchronize);
+
+/* Map part of a buffer object for writing
+ *
+ * Same as mapBuffer, except that only the given range is invalidated,
+ * for buffer objects whose other parts are in use by others.
+ *
+ * @pOffset is the start of the range in bytes
+ */
+void* mapBufferRange(const GLuint pBuffer, const size_t pOffset, const size_t pSize,
+                     const bool pSynchronize);
+
+/* Unmap buffer object mapped using mapBuffer
+ *
+ * Throws if the buffer contents got corrupted while it was mapped.
+ */
+void unmapBuffer(const GLuint pBuffer);
+
+/* Throw if no window context is current on the calling thread
+ *
+ * This is the case for the user threads of windows in threaded mode,
+ * whose GL calls have to be made from tasks queued using Window::submit.
+ *
+ * @pFunction is the name of the function reported in the error
+ */
+void checkContextCurrent(const char* pFunction);
+
 #ifdef OS_WIN
 /* Get the paths to font files in Windows system directory
  *
@@ -101,14 +219,17 @@ void getFontFilePaths(std::vector<std::string>& pFiles,
                       const std::string& pExt);
 #endif
 
-/* Convert float value to string with given precision
+/* Convert floating point value to string with given precision
+ *
+ * Takes a double so that labels of axes with double precision
+ * limits keep all their digits, floats convert without loss.
  *
- * @pVal is the float value whose string representation is requested.
- * @pPrecision is the precision of the float used while converting to string.
+ * @pVal is the value whose string representation is requested.
+ * @pPrecision is the number of digits after the decimal point.
  *
- * @return is the string representation of input float value.
+ * @return is the string representation of input value.
  */
-std::string toString(const float pVal, const int pPrecision = 2);
+std::string toString(const double pVal, const int pPrecision = 2);
 
 /* Get a vertex buffer object for quad that spans the screen
  */
@@ -154,11 +275,33 @@ class AbstractRenderable {
         size_t      mABOSize;
         GLfloat     mColor[4];
         GLfloat     mRange[6];
+        /* mRange in double precision, as set by the chart */
+        GLdouble    mLimits[6];
         std::string mLegend;
         bool        mIsPVCOn;
         bool        mIsPVAOn;
+        /* fence inserted after the last draw of a renderable
+         * whose buffers are mapped by the user, used to decide
+         * whether the next map can skip synchronization */
+        GLsync      mRenderFence;
+        bool        mUsesMap;
+        /* incremented on every change that
+         * affects what the renderable draws */
+        unsigned long long mVersion;
 
     public:
+        AbstractRenderable()
+            : mRange(), mRenderFence(0), mUsesMap(false), mVersion(0) {
+            checkContextCurrent("AbstractRenderable::AbstractRenderable");
+            /* NaN compares unequal to anything, the
+             * first setRanges call always applies */
+            std::fill(mLimits, mLimits + 6, std::numeric_limits<GLdouble>::quiet_NaN());
+        }
+
+        virtual ~AbstractRenderable() {
+            if (mRenderFence) glDeleteSync(mRenderFence);
+        }
+
         /* Getter functions for OpenGL buffer objects
          * identifiers and their size in bytes
          *
@@ -173,6 +316,39 @@ class AbstractRenderable {
         size_t cboSize() const { return mCBOSize; }
         size_t aboSize() const { return mABOSize; }
 
+        /* Returns the buffer object identifier of given kind
+         * and its size in bytes
+         *
+         * Renderables that own buffers other than vertices, colors
+         * and alpha values override this method to expose them.
+         */
+        virtual GLuint buffer(const fg::BufferKind pKind, size_t& pSize);
+
+        /* Returns the offset in bytes of the buffer of given kind within
+         * its buffer object, which is not zero only for renderables that
+         * share buffer objects with others
+         */
+        virtual size_t offset(const fg::BufferKind pKind) const { return 0; }
+        virtual bool sharesBuffers() const { return false; }
+
+        /* Map buffer of given kind for writing
+         *
+         * The buffer contents are invalidated, hence the entire buffer
+         * has to be written before unmap. When the draw that last read
+         * from this renderable has finished on the GPU, the mapping
+         * is also unsynchronized.
+         */
+        void* map(const fg::BufferKind pKind);
+        void unmap(const fg::BufferKind pKind);
+
+        /* Called by the window once the renderable is drawn
+         *
+         * Inserts a fence into the command stream if buffers of this
+         * renderable have ever been mapped, renderables that are only
+         * updated through other means don't pay for it.
+         */
+        void markRendered();
+
         /* Set color for rendering
          */
         void setColor(const float pRed, const float pGreen,
@@ -181,6 +357,7 @@ class AbstractRenderable {
             mColor[1] = clampTo01(pGreen);
             mColor[2] = clampTo01(pBlue);
             mColor[3] = clampTo01(pAlpha);
+            ++mVersion;
         }
 
         /* Get renderable solid color
@@ -196,6 +373,7 @@ class AbstractRenderable {
          */
         void setLegend(const char* pLegend) {
             mLegend = std::string(pLegend);
+            ++mVersion;
         }
 
         /* Get legend string
@@ -208,18 +386,45 @@ class AbstractRenderable {
          *
          * This method is mostly used for charts and related renderables
          */
-        void setRanges(const float pMinX, const float pMaxX,
-                       const float pMinY, const float pMaxY,
-                       const float pMinZ, const float pMaxZ) {
-            mRange[0] = pMinX; mRange[1] = pMaxX;
-            mRange[2] = pMinY; mRange[3] = pMaxY;
-            mRange[4] = pMinZ; mRange[5] = pMaxZ;
+        void setRanges(const double pMinX, const double pMaxX,
+                       const double pMinY, const double pMaxY,
+                       const double pMinZ, const double pMaxZ) {
+            /* charts set ranges on every render, only
+             * an actual change makes the renderable dirty */
+            if (mLimits[0] == pMinX && mLimits[1] == pMaxX &&
+                mLimits[2] == pMinY && mLimits[3] == pMaxY &&
+                mLimits[4] == pMinZ && mLimits[5] == pMaxZ)
+                return;
+            mLimits[0] = pMinX; mLimits[1] = pMaxX;
+            mLimits[2] = pMinY; mLimits[3] = pMaxY;
+            mLimits[4] = pMinZ; mLimits[5] = pMaxZ;
+            for (int i = 0; i < 6; ++i)
+                mRange[i] = (GLfloat)mLimits[i];
+            ++mVersion;
         }
 
+        /* Inform that the contents of renderable changed
+         *
+         * Buffer contents written through OpenGL or compute interop
+         * are invisible to Forge, windows that render on demand
+         * redraw a renderable only after it is marked dirty.
+         */
+        virtual void markDirty() { ++mVersion; }
+
+        /* Returns a value that changes whenever the renderable changes
+         *
+         * Windows that render on demand compare it against the value
+         * seen during the last draw to decide whether to draw again.
+         */
+        virtual unsigned long long version() { return mVersion; }
+
         /* virtual function to set colormap, a derviced class might
          * use it or ignore it if it doesnt have a need for color maps.
+         *
+         * @pTexture is the 1D texture holding the color map
+         * @pLength is the number of colors in the color map
          */
-        virtual void setColorMapUBOParams(const GLuint pUBO, const GLuint pSize) {
+        virtual void setColorMapParams(const GLuint pTexture, const GLuint pLength) {
         }
 
         /* render is a pure virtual function.
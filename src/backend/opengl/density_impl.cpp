@@ -0,0 +1,236 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <density_impl.hpp>
+#include <err_opengl.hpp>
+#include <profiler_impl.hpp>
+#include <trace_impl.hpp>
+#include <shader_headers/density_quad_vs.hpp>
+#include <shader_headers/density_reduce_fs.hpp>
+#include <shader_headers/density_resolve_fs.hpp>
+
+namespace opengl
+{
+
+/* single channel float texture attached to a new framebuffer */
+static GLuint createCountTexture(const GLsizei pWidth, const GLsizei pHeight, GLuint& pFBO)
+{
+    GLuint tex = 0;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, pWidth, pHeight, 0, GL_RED, GL_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &pFBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, pFBO);
+    glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex, 0);
+    GLenum status = glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+        throw fg::Error("density_impl::createCountTexture", __LINE__,
+                        "Incomplete framebuffer for point counts", FG_ERR_GL_ERROR);
+    return tex;
+}
+
+void density_impl::resize(Target& pTarget, const GLsizei pWidth, const GLsizei pHeight)
+{
+    if (pTarget.mFBO && pTarget.mWidth == pWidth && pTarget.mHeight == pHeight)
+        return;
+
+    release(pTarget);
+
+    /* full viewport passes generate their vertices,
+     * core profile still needs a vertex array bound */
+    if (!pTarget.mVAO)
+        glGenVertexArrays(1, &pTarget.mVAO);
+
+    pTarget.mWidth   = pWidth;
+    pTarget.mHeight  = pHeight;
+    pTarget.mTexture = createCountTexture(pWidth, pHeight, pTarget.mFBO);
+
+    GLsizei w = pWidth;
+    GLsizei h = pHeight;
+    while (w > 1 || h > 1) {
+        w = (w + 3) / 4;
+        h = (h + 3) / 4;
+        GLuint fbo = 0;
+        GLuint tex = createCountTexture(w, h, fbo);
+        pTarget.mLevelFBOs.push_back(fbo);
+        pTarget.mLevelTextures.push_back(tex);
+        pTarget.mLevelWidths.push_back(w);
+        pTarget.mLevelHeights.push_back(h);
+    }
+}
+
+void density_impl::release(Target& pTarget)
+{
+    if (pTarget.mFBO) {
+        glDeleteFramebuffers(1, &pTarget.mFBO);
+        glDeleteTextures(1, &pTarget.mTexture);
+    }
+    if (!pTarget.mLevelFBOs.empty()) {
+        glDeleteFramebuffers((GLsizei)pTarget.mLevelFBOs.size(), pTarget.mLevelFBOs.data());
+        glDeleteTextures((GLsizei)pTarget.mLevelTextures.size(), pTarget.mLevelTextures.data());
+    }
+    pTarget.mFBO     = 0;
+    pTarget.mTexture = 0;
+    pTarget.mLevelFBOs.clear();
+    pTarget.mLevelTextures.clear();
+    pTarget.mLevelWidths.clear();
+    pTarget.mLevelHeights.clear();
+}
+
+density_impl::density_impl()
+    : mReduceProgram(0), mResolveProgram(0),
+      mReduceSrcIndex(-1), mReduceSizeIndex(-1), mResolveCMapIndex(-1), mResolveCMapLenIndex(-1),
+      mResolveCountsIndex(-1), mResolveMaxIndex(-1), mResolveOriginIndex(-1),
+      mResolveLogIndex(-1), mResolveAlphaIndex(-1), mPrevFBO(0),
+      mPrevScissor(GL_FALSE), mPrevDepth(GL_FALSE), mPrevBlend(GL_FALSE)
+{
+    CheckGL("Begin density_impl::density_impl");
+    mReduceProgram  = initShaders(glsl::density_quad_vs.c_str(), glsl::density_reduce_fs.c_str());
+    mResolveProgram = initShaders(glsl::density_quad_vs.c_str(), glsl::density_resolve_fs.c_str());
+
+    mReduceSrcIndex      = glGetUniformLocation(mReduceProgram, "src");
+    mReduceSizeIndex     = glGetUniformLocation(mReduceProgram, "srcSize");
+
+    mResolveCMapIndex    = glGetUniformLocation(mResolveProgram, "cmap");
+    mResolveCMapLenIndex = glGetUniformLocation(mResolveProgram, "cmaplen");
+    mResolveCountsIndex  = glGetUniformLocation(mResolveProgram, "counts");
+    mResolveMaxIndex     = glGetUniformLocation(mResolveProgram, "maxcount");
+    mResolveOriginIndex  = glGetUniformLocation(mResolveProgram, "origin");
+    mResolveLogIndex     = glGetUniformLocation(mResolveProgram, "uselog");
+    mResolveAlphaIndex   = glGetUniformLocation(mResolveProgram, "alpha");
+    CheckGL("End density_impl::density_impl");
+}
+
+density_impl::~density_impl()
+{
+    CheckGL("Begin density_impl::~density_impl");
+    for (auto it = mTargets.begin(); it != mTargets.end(); ++it) {
+        release(it->second);
+        glDeleteVertexArrays(1, &it->second.mVAO);
+    }
+    glDeleteProgram(mReduceProgram);
+    glDeleteProgram(mResolveProgram);
+    CheckGL("End density_impl::~density_impl");
+}
+
+void density_impl::begin(const int pWindowId)
+{
+    CheckGL("Begin density_impl::begin");
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &mPrevFBO);
+    glGetIntegerv(GL_VIEWPORT, mPrevViewport);
+    glGetIntegerv(GL_SCISSOR_BOX, mPrevScissorBox);
+    mPrevScissor = glIsEnabled(GL_SCISSOR_TEST);
+    mPrevDepth   = glIsEnabled(GL_DEPTH_TEST);
+    mPrevBlend   = glIsEnabled(GL_BLEND);
+
+    Target& target = mTargets[pWindowId];
+    resize(target, mPrevViewport[2], mPrevViewport[3]);
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target.mFBO);
+    glViewport(0, 0, target.mWidth, target.mHeight);
+    glDisable(GL_SCISSOR_TEST);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    /* points clipped away on screen are left out of the counts too,
+     * scissor box is moved into the coordinates of the target */
+    if (mPrevScissor) {
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(mPrevScissorBox[0] - mPrevViewport[0], mPrevScissorBox[1] - mPrevViewport[1],
+                  mPrevScissorBox[2], mPrevScissorBox[3]);
+    }
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    CheckGL("End density_impl::begin");
+}
+
+void density_impl::end(const int pWindowId, const GLuint pCMapTex, const GLuint pCMapLen,
+                       const bool pLogScale, const float pAlpha)
+{
+    CheckGL("Begin density_impl::end");
+    FG_TRACE_GPU_SCOPE("density_impl::end");
+    Target& target = mTargets[pWindowId];
+
+    glDisable(GL_BLEND);
+    glDisable(GL_SCISSOR_TEST);
+    glBindVertexArray(target.mVAO);
+
+    /* reduce counts to their maximum */
+    glUseProgram(mReduceProgram);
+    glUniform1i(mReduceSrcIndex, 0);
+    glActiveTexture(GL_TEXTURE0);
+
+    GLuint  src  = target.mTexture;
+    GLsizei srcW = target.mWidth;
+    GLsizei srcH = target.mHeight;
+    for (size_t l = 0; l < target.mLevelFBOs.size(); ++l) {
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target.mLevelFBOs[l]);
+        glViewport(0, 0, target.mLevelWidths[l], target.mLevelHeights[l]);
+        glBindTexture(GL_TEXTURE_2D, src);
+        glUniform2i(mReduceSizeIndex, srcW, srcH);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        countDrawCall();
+        src  = target.mLevelTextures[l];
+        srcW = target.mLevelWidths[l];
+        srcH = target.mLevelHeights[l];
+    }
+
+    /* map counts through the color map */
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mPrevFBO);
+    glViewport(mPrevViewport[0], mPrevViewport[1], mPrevViewport[2], mPrevViewport[3]);
+    if (mPrevScissor) {
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(mPrevScissorBox[0], mPrevScissorBox[1], mPrevScissorBox[2], mPrevScissorBox[3]);
+    }
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glUseProgram(mResolveProgram);
+    glUniform1i(mResolveCMapIndex, 0);
+    glUniform1f(mResolveCMapLenIndex, (GLfloat)pCMapLen);
+    glUniform1i(mResolveCountsIndex, 1);
+    glUniform1i(mResolveMaxIndex, 2);
+    glUniform2i(mResolveOriginIndex, mPrevViewport[0], mPrevViewport[1]);
+    glUniform1i(mResolveLogIndex, pLogScale);
+    glUniform1f(mResolveAlphaIndex, pAlpha);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_1D, pCMapTex);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, target.mTexture);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, src);
+
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    countDrawCall();
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindTexture(GL_TEXTURE_1D, 0);
+    glUseProgram(0);
+    glBindVertexArray(0);
+
+    if (!mPrevBlend)
+        glDisable(GL_BLEND);
+    if (mPrevDepth)
+        glEnable(GL_DEPTH_TEST);
+    CheckGL("End density_impl::end");
+}
+
+}
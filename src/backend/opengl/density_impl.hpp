@@ -0,0 +1,95 @@
+/*******************************************************
+* Copyright (c) 2015-2019, ArrayFire
+* All rights reserved.
+*
+* This file is distributed under 3-clause BSD license.
+* The complete license agreement can be obtained at:
+* http://arrayfire.com/licenses/BSD-3-Clause
+********************************************************/
+
+#pragma once
+
+#include <common.hpp>
+
+#include <map>
+#include <vector>
+
+namespace opengl
+{
+
+/* Density display of large point sets
+ *
+ * Points drawn between begin and end are counted per pixel in a float
+ * texture the size of the viewport, using additive blending. The largest
+ * count is then found on the GPU by reducing blocks of 4x4 texels to their
+ * maximum until a single texel remains. A last pass over the viewport maps
+ * counts, on a linear or logarithmic scale, through the color map of the
+ * window. Unlike point sprites, the cost of fragments does not depend on
+ * overdraw or marker size.
+ */
+class density_impl {
+    private:
+        struct Target {
+            GLuint  mFBO;
+            GLuint  mTexture;
+            GLuint  mVAO;
+            GLsizei mWidth;
+            GLsizei mHeight;
+            /* reduction levels, the last one is 1x1 */
+            std::vector<GLuint>  mLevelFBOs;
+            std::vector<GLuint>  mLevelTextures;
+            std::vector<GLsizei> mLevelWidths;
+            std::vector<GLsizei> mLevelHeights;
+
+            Target() : mFBO(0), mTexture(0), mVAO(0), mWidth(0), mHeight(0) {}
+        };
+
+        GLuint mReduceProgram;
+        GLuint mResolveProgram;
+        /* shader variable index locations */
+        GLuint mReduceSrcIndex;
+        GLuint mReduceSizeIndex;
+        GLuint mResolveCMapIndex;
+        GLuint mResolveCMapLenIndex;
+        GLuint mResolveCountsIndex;
+        GLuint mResolveMaxIndex;
+        GLuint mResolveOriginIndex;
+        GLuint mResolveLogIndex;
+        GLuint mResolveAlphaIndex;
+        /* framebuffer objects are not shared between
+         * contexts, hence a target per window */
+        std::map<int, Target> mTargets;
+        /* state of the framebuffer that counts are resolved to */
+        GLint     mPrevFBO;
+        GLint     mPrevViewport[4];
+        GLint     mPrevScissorBox[4];
+        GLboolean mPrevScissor;
+        GLboolean mPrevDepth;
+        GLboolean mPrevBlend;
+
+        void resize(Target& pTarget, const GLsizei pWidth, const GLsizei pHeight);
+        void release(Target& pTarget);
+
+    public:
+        density_impl();
+        ~density_impl();
+
+        /* Redirect drawing to the counts target of window pWindowId
+         *
+         * The target takes the size of the current viewport and is
+         * cleared. Every fragment drawn until end adds one to its pixel.
+         */
+        void begin(const int pWindowId);
+
+        /* Resolve counts onto the viewport that was current at begin
+         *
+         * @pCMapTex is the 1D texture of the color map
+         * @pCMapLen is the number of colors in the color map
+         * @pLogScale maps counts on a logarithmic scale when true
+         * @pAlpha is the opacity of pixels that have a non zero count
+         */
+        void end(const int pWindowId, const GLuint pCMapTex, const GLuint pCMapLen,
+                 const bool pLogScale, const float pAlpha);
+};
+
+}
@@ -12,9 +12,96 @@
 #include <common.hpp>
 #include <err_opengl.hpp>
 
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
 #include <iostream>
 
+/* log of the context current on calling thread,
+ * NULL unless debug output is turned on */
+static thread_local GLDebugLog* currentLog = nullptr;
+
+void GLDebugLog::record(const char* pMessage)
+{
+    const GLCheckpoint* where = mWhere.load(std::memory_order_relaxed);
+
+    std::stringstream ss;
+    ss << pMessage;
+    if (where)
+        ss << " (after " << where->mMsg << " at " << where->mFile << ":" << where->mLine << ")";
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mErrors.push_back(ss.str());
+}
+
+std::vector<std::string> GLDebugLog::take()
+{
+    std::vector<std::string> result;
+    std::lock_guard<std::mutex> lock(mMutex);
+    result.swap(mErrors);
+    return result;
+}
+
+static void APIENTRY debugCallback(GLenum pSource, GLenum pType, GLuint pId,
+                                   GLenum pSeverity, GLsizei pLength,
+                                   const GLchar* pMessage, const void* pUserParam)
+{
+    GLDebugLog* log = static_cast<GLDebugLog*>(const_cast<void*>(pUserParam));
+    log->record(pMessage);
+}
+
+bool glDebugEnabled()
+{
+    static const bool enabled = [] {
+        const char* value = std::getenv("FG_GL_DEBUG");
+        return value != NULL && *value != '\0' && std::strcmp(value, "0") != 0;
+    }();
+    return enabled;
+}
+
+bool glDebugAttach(GLDebugLog* pLog)
+{
+    if (!GLEW_KHR_debug)
+        return false;
+
+    if (pLog) {
+        /* only errors and undefined behavior are of interest,
+         * performance hints and the like are not reported */
+        glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, NULL, GL_FALSE);
+        glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_ERROR, GL_DONT_CARE, 0, NULL, GL_TRUE);
+        glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR,
+                              GL_DONT_CARE, 0, NULL, GL_TRUE);
+        glDebugMessageCallback(debugCallback, pLog);
+        glEnable(GL_DEBUG_OUTPUT);
+    } else {
+        glDisable(GL_DEBUG_OUTPUT);
+        glDebugMessageCallback(NULL, NULL);
+    }
+    return true;
+}
+
+void glDebugSetCurrent(GLDebugLog* pLog)
+{
+    currentLog = pLog;
+}
+
+void glDebugCheck(const char* pMsg, const char* pFile, int pLine)
+{
+    if (!currentLog)
+        return;
+
+    std::vector<std::string> errors = currentLog->take();
+    if (errors.empty())
+        return;
+
+    std::stringstream ss;
+    ss << "GL Error reported by " << pMsg << " at: " << pFile << ":" << pLine;
+    for (auto& error : errors)
+        ss << "\n    " << error;
+    ss << std::endl;
+    throw fg::Error(pFile, pLine, ss.str().c_str(), FG_ERR_GL_ERROR);
+}
+
 void commonErrorCheck(const char *pMsg, const char* pFile, int pLine)
 {
     GLenum x = glGetError();
@@ -27,11 +114,16 @@ void commonErrorCheck(const char *pMsg, const char* pFile, int pLine)
     }
 }
 
-void glErrorCheck(const char *pMsg, const char* pFile, int pLine)
+void glErrorCheck(const GLCheckpoint* pWhere)
 {
+    /* debug output reports errors on its own, only the place is noted */
+    if (currentLog) {
+        currentLog->pass(pWhere);
+        return;
+    }
 // Skipped in release mode
 #ifndef NDEBUG
-    commonErrorCheck(pMsg, pFile, pLine);
+    commonErrorCheck(pWhere->mMsg, pWhere->mFile, pWhere->mLine);
 #endif
 }
 
@@ -11,8 +11,72 @@
 
 #include <fg/defines.h>
 
-void glErrorCheck(const char *pMsg, const char* pFile, int pLine);
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Source location of a CheckGL call */
+struct GLCheckpoint {
+    const char* mMsg;
+    const char* mFile;
+    int         mLine;
+};
+
+/* Errors reported by the GL debug output of a context
+ *
+ * When FG_GL_DEBUG environment variable is set to a non zero value,
+ * windows ask for debug contexts and have the driver report errors through
+ * a KHR_debug callback. Debug output is left asynchronous, hence no call
+ * waits on the GL pipeline. CheckGL then only notes the last checkpoint
+ * passed on the context, which tells roughly where an error came from.
+ * Errors are collected here and thrown by glDebugCheck at frame boundaries.
+ *
+ * Without FG_GL_DEBUG, CheckGL calls glGetError in debug builds only.
+ */
+class GLDebugLog {
+    private:
+        std::atomic<const GLCheckpoint*> mWhere;
+        std::mutex                       mMutex;
+        std::vector<std::string>         mErrors;
+
+    public:
+        GLDebugLog() : mWhere(nullptr) {}
+
+        void pass(const GLCheckpoint* pWhere) { mWhere.store(pWhere, std::memory_order_relaxed); }
+
+        /* may be called on any thread by the driver */
+        void record(const char* pMessage);
+
+        /* @return errors recorded since last call, in the order received */
+        std::vector<std::string> take();
+};
+
+/* @return true if FG_GL_DEBUG asks for debug output */
+bool glDebugEnabled();
+
+/* Register debug output of the current context to pLog, which has
+ * to outlive the registration. Passing NULL unregisters it.
+ *
+ * @return false if the context does not support KHR_debug
+ */
+bool glDebugAttach(GLDebugLog* pLog);
+
+/* Log that CheckGL calls on this thread note checkpoints to */
+void glDebugSetCurrent(GLDebugLog* pLog);
+
+/* Throw errors recorded on the log of current context, if any */
+void glDebugCheck(const char* pMsg, const char* pFile, int pLine);
+
+void glErrorCheck(const GLCheckpoint* pWhere);
 void glForceErrorCheck(const char *pMsg, const char* pFile, int pLine);
 
-#define CheckGL(msg)      glErrorCheck     (msg, __FILE__, __LINE__)
+/* checkpoints are constant initialized, they cost nothing to set up */
+#define CheckGL(msg)                                                    \
+    do {                                                                \
+        static const GLCheckpoint fgCheckpoint = {msg, __FILE__, __LINE__}; \
+        glErrorCheck(&fgCheckpoint);                                    \
+    } while (0)
+
 #define ForceCheckGL(msg) glForceErrorCheck(msg, __FILE__, __LINE__)
+#define FrameCheckGL(msg) glDebugCheck     (msg, __FILE__, __LINE__)
@@ -10,6 +10,8 @@
 #include <common.hpp>
 #include <err_opengl.hpp>
 #include <font_impl.hpp>
+#include <profiler_impl.hpp>
+#include <trace_impl.hpp>
 #include <shader_headers/font_vs.hpp>
 #include <shader_headers/font_fs.hpp>
 
@@ -283,6 +285,7 @@ void font_impl::setOthro2D(int pWidth, int pHeight)
 void font_impl::loadFont(const char* const pFile)
 {
     CheckGL("Begin font_impl::loadFont");
+    FG_TRACE_SCOPE("font_impl::loadFont");
 
     /* Check if font is already loaded. If yes, check if current font load
      * request is same as earlier. If so, return from the function, otherwise,
@@ -418,6 +421,8 @@ void font_impl::render(int pWindowId,
     static const glm::mat4 I(1);
 
     CheckGL("Begin font_impl::render ");
+    ProfileScope scope(FG_STAT_TEXT, this);
+    FG_TRACE_GPU_SCOPE("font_impl::render");
     if(!mIsFontLoaded) {
         return;
     }
@@ -469,6 +474,7 @@ void font_impl::render(int pWindowId,
             glUniformMatrix4fv(mMMatIndex, 1, GL_FALSE, (GLfloat*)&TR);
 
             glDrawArrays(GL_TRIANGLE_STRIP, g->mOffset, 4);
+            countDrawCall();
 
             if (pIsVertical) {
                 loc_y += (g->mAdvanceX);
@@ -8,6 +8,7 @@
 ********************************************************/
 
 #include <common.hpp>
+#include <err_opengl.hpp>
 #include <glfw/window.hpp>
 
 #include <glm/gtc/matrix_transform.hpp>
@@ -26,7 +27,8 @@ namespace wtk
 
 Widget::Widget()
     : mWindow(NULL), mClose(false), mLastXPos(0), mLastYPos(0), mButton(-1),
-   mWidth(512), mHeight(512), mRows(1), mCols(1)
+   mPendingWidth(0), mPendingHeight(0), mResized(false),
+   mWidth(512), mHeight(512), mRows(1), mCols(1), mDirty(true)
 {
     mCellWidth  = mWidth;
     mCellHeight = mHeight;
@@ -34,7 +36,8 @@ Widget::Widget()
 }
 
 Widget::Widget(int pWidth, int pHeight, const char* pTitle, const Widget* pWindow, const bool invisible)
-    : mWindow(NULL), mClose(false), mLastXPos(0), mLastYPos(0), mButton(-1), mRows(1), mCols(1)
+    : mWindow(NULL), mClose(false), mLastXPos(0), mLastYPos(0), mButton(-1),
+      mPendingWidth(0), mPendingHeight(0), mResized(false), mRows(1), mCols(1), mDirty(true)
 {
     mFramePBO   = 0;
 
@@ -53,13 +56,15 @@ Widget::Widget(int pWidth, int pHeight, const char* pTitle, const Widget* pWindo
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    /* debug contexts report errors through KHR_debug callback */
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, glDebugEnabled() ? GL_TRUE : GL_FALSE);
 
     if (invisible)
         glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
     else
         glfwWindowHint(GLFW_VISIBLE, GL_TRUE);
 
-    glfwWindowHint(GLFW_SAMPLES, 4);
+    glfwWindowHint(GLFW_SAMPLES, msaaSamples());
     mWindow = glfwCreateWindow(pWidth, pHeight, pTitle, nullptr,
                                (pWindow!=nullptr ? pWindow->getNativeHandle(): nullptr));
 
@@ -95,11 +100,18 @@ Widget::Widget(int pWidth, int pHeight, const char* pTitle, const Widget* pWindo
         static_cast<Widget*>(glfwGetWindowUserPointer(w))->mouseButtonHandler(button, action, mods);
     };
 
+    /* contents are lost when window is exposed or restored */
+    auto refreshCallback = [](GLFWwindow* w)
+    {
+        static_cast<Widget*>(glfwGetWindowUserPointer(w))->mDirty = true;
+    };
+
     glfwSetFramebufferSizeCallback(mWindow, rsCallback);
     glfwSetWindowCloseCallback(mWindow, closeCallback);
     glfwSetKeyCallback(mWindow, kbCallback);
     glfwSetCursorPosCallback(mWindow, cursorCallback);
     glfwSetMouseButtonCallback(mWindow, mouseButtonCallback);
+    glfwSetWindowRefreshCallback(mWindow, refreshCallback);
 
     glfwGetFramebufferSize(mWindow, &mWidth, &mHeight);
     mCellWidth  = mWidth;
@@ -124,6 +136,11 @@ void Widget::makeContextCurrent() const
     glfwMakeContextCurrent(mWindow);
 }
 
+void Widget::releaseContext() const
+{
+    glfwMakeContextCurrent(NULL);
+}
+
 long long Widget::getGLContextHandle()
 {
 #ifdef OS_WIN
@@ -161,6 +178,11 @@ void Widget::setSize(unsigned pW, unsigned pH)
     glfwSetWindowSize(mWindow, pW, pH);
 }
 
+void Widget::setSwapInterval(const int pInterval)
+{
+    glfwSwapInterval(pInterval);
+}
+
 void Widget::swapBuffers()
 {
     glfwSwapBuffers(mWindow);
@@ -169,6 +191,9 @@ void Widget::swapBuffers()
     glBindBuffer(GL_PIXEL_PACK_BUFFER, mFramePBO);
     glReadPixels(0, 0, mWidth, mHeight, GL_RGBA, GL_UNSIGNED_BYTE, 0);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    /* the frame just read back was rendered at the previous size */
+    applyResize();
 }
 
 void Widget::hide()
@@ -180,6 +205,7 @@ void Widget::hide()
 void Widget::show()
 {
     mClose = false;
+    mDirty = true;
     glfwShowWindow(mWindow);
 }
 
@@ -197,11 +223,13 @@ void Widget::resetCloseFlag()
 
 void Widget::resizeHandler(int pWidth, int pHeight)
 {
-    mWidth      = pWidth;
-    mHeight     = pHeight;
-    mCellWidth  = mWidth  / mCols;
-    mCellHeight = mHeight / mRows;
-    resizePixelBuffers();
+    /* events may be handled on a thread other than the one
+     * rendering into the window, the size is applied on swap */
+    std::lock_guard<std::mutex> lock(mResizeMutex);
+    mPendingWidth  = pWidth;
+    mPendingHeight = pHeight;
+    mResized       = true;
+    mDirty         = true;
 }
 
 void Widget::keyboardHandler(int pKey, int pScancode, int pAction, int pMods)
@@ -220,6 +248,7 @@ void Widget::cursorHandler(const float pXPos, const float pYPos)
 
     int r, c;
     getViewIds(&r, &c);
+    std::lock_guard<std::mutex> lock(mViewMutex);
     glm::mat4& mvp = mViewMatrices[r+c*mRows];
 
     if (mButton == GLFW_MOUSE_BUTTON_LEFT) {
@@ -256,6 +285,9 @@ void Widget::cursorHandler(const float pXPos, const float pYPos)
         mLastPos  = curPos;
     }
 
+    if (mButton != -1)
+        mDirty = true;
+
     mLastXPos = pXPos;
     mLastYPos = pYPos;
 }
@@ -277,7 +309,9 @@ void Widget::mouseButtonHandler(int pButton, int pAction, int pMods)
     if (pButton == GLFW_MOUSE_BUTTON_MIDDLE && pMods == GLFW_MOD_CONTROL && pAction == GLFW_PRESS) {
         int r, c;
         getViewIds(&r, &c);
+        std::lock_guard<std::mutex> lock(mViewMutex);
         mViewMatrices[r+c*mRows] = glm::mat4(1);
+        mDirty = true;
     }
 }
 
@@ -286,6 +320,20 @@ void Widget::pollEvents()
     glfwPollEvents();
 }
 
+void Widget::waitEvents(const double pTimeout)
+{
+    if (pTimeout > 0)
+        glfwWaitEventsTimeout(pTimeout);
+    else
+        glfwWaitEvents();
+}
+
+bool Widget::isHidden() const
+{
+    return !glfwGetWindowAttrib(mWindow, GLFW_VISIBLE) ||
+            glfwGetWindowAttrib(mWindow, GLFW_ICONIFIED);
+}
+
 void Widget::resizePixelBuffers()
 {
     if (mFramePBO!=0)
@@ -300,4 +348,20 @@ void Widget::resizePixelBuffers()
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 }
 
+void Widget::applyResize()
+{
+    {
+        std::lock_guard<std::mutex> lock(mResizeMutex);
+        if (!mResized)
+            return;
+        mWidth   = mPendingWidth;
+        mHeight  = mPendingHeight;
+        mResized = false;
+    }
+    mCellWidth  = mWidth  / mCols;
+    mCellHeight = mHeight / mRows;
+    mDirty      = true;
+    resizePixelBuffers();
+}
+
 }
@@ -26,6 +26,9 @@
 
 #include <glm/glm.hpp>
 
+#include <atomic>
+#include <mutex>
+
 /* the short form wtk stands for
  * Windowing Tool Kit */
 namespace wtk
@@ -40,6 +43,13 @@ class Widget {
         int         mButton;
         glm::vec3   mLastPos;
 
+        /* size reported by the latest resize event, it is applied
+         * by the thread that renders into the window */
+        std::mutex  mResizeMutex;
+        int         mPendingWidth;
+        int         mPendingHeight;
+        bool        mResized;
+
         Widget();
 
         inline void getViewIds(int* pRow, int* pCol) {
@@ -53,9 +63,17 @@ class Widget {
         int mHeight;    // Framebuffer height
         int mRows;
         int mCols;
-        int mCellWidth;
-        int mCellHeight;
+        /* cell size is read by event handlers while the render thread
+         * changes it on resize or grid change */
+        std::atomic<int> mCellWidth;
+        std::atomic<int> mCellHeight;
         std::vector<glm::mat4> mViewMatrices;
+        /* guards grid layout and view matrices, event handlers change
+         * views while the render thread may change the grid */
+        mutable std::mutex mViewMutex;
+        /* set when the window has to be redrawn irrespective
+         * of its contents; resize, expose and view changes */
+        std::atomic<bool> mDirty;
 
         GLuint  mFramePBO;
 
@@ -68,6 +86,8 @@ class Widget {
 
         void makeContextCurrent() const;
 
+        void releaseContext() const;
+
         long long getGLContextHandle();
 
         long long getDisplayHandle();
@@ -80,6 +100,8 @@ class Widget {
 
         void swapBuffers();
 
+        void setSwapInterval(const int pInterval);
+
         void hide();
 
         void show();
@@ -98,7 +120,17 @@ class Widget {
 
         void pollEvents();
 
+        /* Block until an event arrives or pTimeout seconds pass,
+         * a non positive timeout waits for an event indefinitely */
+        void waitEvents(const double pTimeout);
+
+        bool isHidden() const;
+
         void resizePixelBuffers();
+
+        /* Apply the latest resize event, if any, to the framebuffer size,
+         * cell size and pixel buffers; the window context has to be current */
+        void applyResize();
 };
 
 }
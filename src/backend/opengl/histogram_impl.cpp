@@ -10,13 +10,21 @@
 #include <common.hpp>
 #include <err_opengl.hpp>
 #include <histogram_impl.hpp>
+#include <profiler_impl.hpp>
+#include <trace_impl.hpp>
 #include <shader_headers/histogram_vs.hpp>
 #include <shader_headers/histogram_fs.hpp>
+#include <shader_headers/histogram_bin_vs.hpp>
+#include <shader_headers/histogram_bin_fs.hpp>
+#include <shader_headers/histogram_resolve_fs.hpp>
+#include <shader_headers/histogram_scan_fs.hpp>
+#include <shader_headers/image_vs.hpp>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
 #include <cmath>
 
 using namespace std;
@@ -40,7 +48,7 @@ void histogram_impl::bindResources(const int pWindowId)
         // attach histogram frequencies
         glEnableVertexAttribArray(mFreqIndex);
         glBindBuffer(GL_ARRAY_BUFFER, mVBO);
-        glVertexAttribPointer(mFreqIndex, 1, mGLType, GL_FALSE, 0, 0);
+        glVertexAttribPointer(mFreqIndex, 1, mGLType, isNormalized(mDataType), 0, 0);
         glVertexAttribDivisor(mFreqIndex, 1);
         // attach histogram bar colors
         glEnableVertexAttribArray(mColorIndex);
@@ -67,12 +75,179 @@ void histogram_impl::unbindResources() const
     glBindVertexArray(0);
 }
 
+/* float counts are exact up to 2^24, a binning pass
+ * takes at most that many samples */
+static const GLuint MAX_SAMPLES_PER_PASS = 1u << 24;
+
+void histogram_impl::computeBins(const int pWindowId)
+{
+    CheckGL("Begin histogram_impl::computeBins");
+    if (mBinFBOMap.find(pWindowId) == mBinFBOMap.end()) {
+        GLuint fbo = 0;
+        glGenFramebuffers(1, &fbo);
+        mBinFBOMap[pWindowId] = fbo;
+
+        GLuint vao = 0;
+        glGenVertexArrays(1, &vao);
+        glBindVertexArray(vao);
+        glEnableVertexAttribArray(mBinValueIndex);
+        glBindBuffer(GL_ARRAY_BUFFER, mSBO);
+        glVertexAttribPointer(mBinValueIndex, 1, GL_FLOAT, GL_FALSE, 0, 0);
+        glBindVertexArray(0);
+        mBinVAOMap[pWindowId] = vao;
+    }
+
+    /* save the state that is changed by binning passes */
+    GLint prevDrawFBO = 0;
+    GLint prevReadFBO = 0;
+    GLint prevViewport[4];
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevDrawFBO);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFBO);
+    glGetIntegerv(GL_VIEWPORT, prevViewport);
+    GLboolean isScissorOn = glIsEnabled(GL_SCISSOR_TEST);
+    GLboolean isDepthOn   = glIsEnabled(GL_DEPTH_TEST);
+
+    /* every pass renders into the texture attached to color attachment
+     * zero, so that no texture is sampled while it is attached */
+    glBindFramebuffer(GL_FRAMEBUFFER, mBinFBOMap[pWindowId]);
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    glViewport(0, 0, mNBins, 1);
+    glDisable(GL_SCISSOR_TEST);
+    glDisable(GL_DEPTH_TEST);
+
+    static const GLfloat zeros[4]  = {0.0f, 0.0f, 0.0f, 0.0f};
+    static const GLuint  uzeros[4] = {0, 0, 0, 0};
+    int current = 0;
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                           GL_TEXTURE_2D, mTotalTex[current], 0);
+    glClearBufferuiv(GL_COLOR, 0, uzeros);
+
+    glUseProgram(mScanProgram);
+    glUniformMatrix4fv(mScanMatIndex, 1, GL_FALSE, glm::value_ptr(IDENTITY));
+    glUniform1i(mScanTotalsIndex, 0);
+    glUniform1i(mScanCountsIndex, 1);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, mCountTex);
+    glActiveTexture(GL_TEXTURE0);
+
+    for (GLuint first = 0; first < mNumSamples; first += MAX_SAMPLES_PER_PASS) {
+        const GLuint count = std::min(mNumSamples - first, MAX_SAMPLES_PER_PASS);
+
+        /* each sample is rendered as a point into
+         * its bin and the counts accumulate by blending */
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                               GL_TEXTURE_2D, mCountTex, 0);
+        glClearBufferfv(GL_COLOR, 0, zeros);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE);
+
+        glUseProgram(mBinProgram);
+        glUniform1f(mBinMinIndex, mSampleMin);
+        glUniform1f(mBinMaxIndex, mSampleMax);
+        glUniform1f(mBinNBinsIndex, (GLfloat)mNBins);
+        glBindVertexArray(mBinVAOMap[pWindowId]);
+        glDrawArrays(GL_POINTS, first, count);
+        countDrawCall();
+
+        glDisable(GL_BLEND);
+
+        /* add the counts of this pass to the integer totals */
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                               GL_TEXTURE_2D, mTotalTex[1 - current], 0);
+        glUseProgram(mScanProgram);
+        glUniform1i(mScanAddIndex, GL_TRUE);
+        glBindTexture(GL_TEXTURE_2D, mTotalTex[current]);
+        glBindVertexArray(screenQuadVAO(pWindowId));
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        countDrawCall();
+        current = 1 - current;
+    }
+
+    /* inclusive prefix sum of the totals in log2(bins) steps */
+    if (mCumulative) {
+        glUseProgram(mScanProgram);
+        glUniform1i(mScanAddIndex, GL_FALSE);
+        glBindVertexArray(screenQuadVAO(pWindowId));
+        for (GLuint offset = 1; offset < mNBins; offset *= 2) {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                                   GL_TEXTURE_2D, mTotalTex[1 - current], 0);
+            glUniform1i(mScanOffsetIndex, (GLint)offset);
+            glBindTexture(GL_TEXTURE_2D, mTotalTex[current]);
+            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+            countDrawCall();
+            current = 1 - current;
+        }
+    }
+
+    /* normalize the totals into frequencies */
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                           GL_TEXTURE_2D, mFreqTex, 0);
+    glUseProgram(mResolveProgram);
+    glUniformMatrix4fv(mResolveMatIndex, 1, GL_FALSE, glm::value_ptr(IDENTITY));
+    glUniform1f(mResolveScaleIndex, mNormalize ? 1.0f/mNumSamples : 1.0f);
+    glUniform1i(mResolveTotalsIndex, 0);
+    glBindTexture(GL_TEXTURE_2D, mTotalTex[current]);
+    glBindVertexArray(screenQuadVAO(pWindowId));
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    countDrawCall();
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+
+    /* read the frequencies into the histogram vertex
+     * buffer, the copy doesn't leave the GPU */
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, mVBO);
+    glReadPixels(0, 0, mNBins, 1, GL_RED, GL_FLOAT, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    /* restore the state for the bars rendering */
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevDrawFBO);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFBO);
+    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+    if (isScissorOn) glEnable(GL_SCISSOR_TEST);
+    if (isDepthOn) glEnable(GL_DEPTH_TEST);
+    CheckGL("End histogram_impl::computeBins");
+}
+
+void histogram_impl::deleteBinningResources()
+{
+    for (auto it = mBinFBOMap.begin(); it!=mBinFBOMap.end(); ++it) {
+        GLuint fbo = it->second;
+        glDeleteFramebuffers(1, &fbo);
+    }
+    for (auto it = mBinVAOMap.begin(); it!=mBinVAOMap.end(); ++it) {
+        GLuint vao = it->second;
+        glDeleteVertexArrays(1, &vao);
+    }
+    mBinFBOMap.clear();
+    mBinVAOMap.clear();
+    glDeleteBuffers(1, &mSBO);
+    glDeleteTextures(1, &mCountTex);
+    glDeleteTextures(2, mTotalTex);
+    glDeleteTextures(1, &mFreqTex);
+    glDeleteProgram(mBinProgram);
+    glDeleteProgram(mScanProgram);
+    glDeleteProgram(mResolveProgram);
+    mSBO = mCountTex = mFreqTex = mBinProgram = mScanProgram = mResolveProgram = 0;
+    mTotalTex[0] = mTotalTex[1] = 0;
+}
+
 histogram_impl::histogram_impl(const uint pNBins, const fg::dtype pDataType)
  :  mDataType(pDataType), mGLType(dtype2gl(mDataType)), mNBins(pNBins),
     mProgram(0), mYMaxIndex(-1), mNBinsIndex(-1), mMatIndex(-1), mPointIndex(-1),
     mFreqIndex(-1), mColorIndex(-1), mAlphaIndex(-1), mPVCIndex(-1), mPVAIndex(-1),
-    mBColorIndex(-1)
+    mBColorIndex(-1), mIsBinningOn(false), mNormalize(false), mCumulative(false),
+    mSBO(0), mSBOSize(0), mNumSamples(0), mSampleMin(0), mSampleMax(0),
+    mCountTex(0), mFreqTex(0), mBinProgram(0), mBinMinIndex(-1), mBinMaxIndex(-1),
+    mBinNBinsIndex(-1), mBinValueIndex(-1), mScanProgram(0), mScanMatIndex(-1),
+    mScanTotalsIndex(-1), mScanCountsIndex(-1), mScanAddIndex(-1), mScanOffsetIndex(-1),
+    mResolveProgram(0), mResolveMatIndex(-1), mResolveTotalsIndex(-1), mResolveScaleIndex(-1)
 {
+    mTotalTex[0] = mTotalTex[1] = 0;
     CheckGL("Begin histogram_impl::histogram_impl");
     mIsPVCOn = false;
     mIsPVAOn = false;
@@ -111,8 +286,10 @@ histogram_impl::histogram_impl(const uint pNBins, const fg::dtype pDataType)
         case GL_UNSIGNED_INT   : HIST_CREATE_BUFFERS(uint)  ; break;
         case GL_SHORT          : HIST_CREATE_BUFFERS(short) ; break;
         case GL_UNSIGNED_SHORT : HIST_CREATE_BUFFERS(ushort); break;
-        case GL_UNSIGNED_BYTE  : HIST_CREATE_BUFFERS(float) ; break;
-        default: fg::TypeError("histogram_impl::histogram_impl", __LINE__, 1, mDataType);
+        case GL_HALF_FLOAT     : HIST_CREATE_BUFFERS(ushort); break;
+        case GL_BYTE           : HIST_CREATE_BUFFERS(char)  ; break;
+        case GL_UNSIGNED_BYTE  : HIST_CREATE_BUFFERS(uchar) ; break;
+        default: throw fg::TypeError("histogram_impl::histogram_impl", __LINE__, 1, mDataType);
     }
 #undef HIST_CREATE_BUFFERS
 
@@ -130,14 +307,113 @@ histogram_impl::~histogram_impl()
     glDeleteBuffers(1, &mCBO);
     glDeleteBuffers(1, &mABO);
     glDeleteProgram(mProgram);
+    deleteBinningResources();
     CheckGL("End histogram_impl::~histogram_impl");
 }
 
+void histogram_impl::setSampleBinning(const uint pNumSamples,
+                                      const float pMinValue, const float pMaxValue,
+                                      const bool pNormalize, const bool pCumulative)
+{
+    CheckGL("Begin histogram_impl::setSampleBinning");
+    /* frequencies are read back as floats into vertex buffer */
+    if (mGLType != GL_FLOAT)
+        throw fg::TypeError("histogram_impl::setSampleBinning", __LINE__, 0, mDataType);
+    if (pNumSamples == 0)
+        throw fg::ArgumentError("histogram_impl::setSampleBinning", __LINE__, 1,
+                                "Number of samples should be greater than zero");
+    if (!(pMinValue < pMaxValue))
+        throw fg::ArgumentError("histogram_impl::setSampleBinning", __LINE__, 3,
+                                "Maximum value should be greater than minimum value");
+    GLint maxTexSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTexSize);
+    if (mNBins > (GLuint)maxTexSize)
+        throw fg::Error("histogram_impl::setSampleBinning", __LINE__,
+                        "Number of bins exceeds maximum texture size", FG_ERR_GL_ERROR);
+
+    mSampleMin  = pMinValue;
+    mSampleMax  = pMaxValue;
+    mNormalize  = pNormalize;
+    mCumulative = pCumulative;
+
+    if (mNumSamples != pNumSamples) {
+        /* vertex array objects reference the sample buffer,
+         * hence they are also created again */
+        deleteBinningResources();
+        mNumSamples = pNumSamples;
+    }
+
+    if (!mIsBinningOn || mSBO == 0) {
+        mSBO     = createBuffer<float>(GL_ARRAY_BUFFER, mNumSamples, NULL, GL_DYNAMIC_DRAW);
+        mSBOSize = mNumSamples*sizeof(float);
+
+        /* totals are integers, they stay exact
+         * up to 2^32 - 1 samples per bin */
+        GLuint textures[4];
+        glGenTextures(4, textures);
+        for (int i=0; i<4; ++i) {
+            const bool isTotal = (i == 1 || i == 2);
+            glBindTexture(GL_TEXTURE_2D, textures[i]);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            if (isTotal)
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, mNBins, 1, 0,
+                             GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+            else
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, mNBins, 1, 0, GL_RED, GL_FLOAT, NULL);
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        mCountTex    = textures[0];
+        mTotalTex[0] = textures[1];
+        mTotalTex[1] = textures[2];
+        mFreqTex     = textures[3];
+
+        mBinProgram     = initShaders(glsl::histogram_bin_vs.c_str(),
+                                      glsl::histogram_bin_fs.c_str());
+        mScanProgram    = initShaders(glsl::image_vs.c_str(),
+                                      glsl::histogram_scan_fs.c_str());
+        mResolveProgram = initShaders(glsl::image_vs.c_str(),
+                                      glsl::histogram_resolve_fs.c_str());
+
+        mBinMinIndex            = glGetUniformLocation(mBinProgram, "minval");
+        mBinMaxIndex            = glGetUniformLocation(mBinProgram, "maxval");
+        mBinNBinsIndex          = glGetUniformLocation(mBinProgram, "nbins" );
+        mBinValueIndex          = glGetAttribLocation (mBinProgram, "value" );
+        mScanMatIndex           = glGetUniformLocation(mScanProgram, "matrix"   );
+        mScanTotalsIndex        = glGetUniformLocation(mScanProgram, "totals"   );
+        mScanCountsIndex        = glGetUniformLocation(mScanProgram, "counts"   );
+        mScanAddIndex           = glGetUniformLocation(mScanProgram, "addCounts");
+        mScanOffsetIndex        = glGetUniformLocation(mScanProgram, "offset"   );
+        mResolveMatIndex        = glGetUniformLocation(mResolveProgram, "matrix");
+        mResolveTotalsIndex     = glGetUniformLocation(mResolveProgram, "totals");
+        mResolveScaleIndex      = glGetUniformLocation(mResolveProgram, "scale" );
+    }
+    mIsBinningOn = true;
+    CheckGL("End histogram_impl::setSampleBinning");
+}
+
+GLuint histogram_impl::buffer(const fg::BufferKind pKind, size_t& pSize)
+{
+    if (pKind == FG_SAMPLE_BUFFER) {
+        if (!mIsBinningOn)
+            throw fg::Error("histogram_impl::buffer", __LINE__,
+                            "Sample binning is not enabled", FG_ERR_INVALID_ARG);
+        pSize = sboSize();
+        return sbo();
+    }
+    return AbstractRenderable::buffer(pKind, pSize);
+}
+
 void histogram_impl::render(const int pWindowId,
                        const int pX, const int pY, const int pVPW, const int pVPH,
                        const glm::mat4& pView)
 {
     CheckGL("Begin histogram_impl::render");
+    ProfileScope scope(FG_STAT_RENDERABLE, this, mLegend);
+    FG_TRACE_GPU_SCOPE("histogram_impl::render");
+    if (mIsBinningOn)
+        computeBins(pWindowId);
+
     glDepthMask(GL_FALSE);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -156,6 +432,7 @@ void histogram_impl::render(const int pWindowId,
      * for each bin. OpenGL instanced rendering is used to do it.*/
     histogram_impl::bindResources(pWindowId);
     glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, mNBins);
+    countDrawCall();
     histogram_impl::unbindResources();
 
     glUseProgram(0);
@@ -41,15 +41,80 @@ class histogram_impl : public AbstractRenderable {
 
         std::map<int, GLuint> mVAOMap;
 
+        /* GPU binning of raw samples */
+        bool      mIsBinningOn;
+        bool      mNormalize;
+        bool      mCumulative;
+        GLuint    mSBO;
+        size_t    mSBOSize;
+        GLuint    mNumSamples;
+        GLfloat   mSampleMin;
+        GLfloat   mSampleMax;
+        /* textures of size mNBins x 1: float counts of one binning
+         * pass, exact integer totals ping-ponged across passes and
+         * resolved frequencies */
+        GLuint    mCountTex;
+        GLuint    mTotalTex[2];
+        GLuint    mFreqTex;
+        /* shader program to accumulate samples into bins
+         * and its attributes */
+        GLuint    mBinProgram;
+        GLuint    mBinMinIndex;
+        GLuint    mBinMaxIndex;
+        GLuint    mBinNBinsIndex;
+        GLuint    mBinValueIndex;
+        /* shader program that adds counts of a pass to the totals
+         * or runs a step of their prefix sum, and its attributes */
+        GLuint    mScanProgram;
+        GLuint    mScanMatIndex;
+        GLuint    mScanTotalsIndex;
+        GLuint    mScanCountsIndex;
+        GLuint    mScanAddIndex;
+        GLuint    mScanOffsetIndex;
+        /* shader program to write normalized
+         * frequencies and its attributes */
+        GLuint    mResolveProgram;
+        GLuint    mResolveMatIndex;
+        GLuint    mResolveTotalsIndex;
+        GLuint    mResolveScaleIndex;
+
+        /* frame buffer & vertex array objects are not
+         * shared across contexts, hence one per window */
+        std::map<int, GLuint> mBinFBOMap;
+        std::map<int, GLuint> mBinVAOMap;
+
         /* bind and unbind helper functions
          * for rendering resources */
         void bindResources(const int pWindowId);
         void unbindResources() const;
 
+        /* bin the samples in mSBO into frequencies
+         * stored in mVBO, mVBO is used as pixel pack
+         * buffer to read back the resolved frequencies */
+        void computeBins(const int pWindowId);
+        void deleteBinningResources();
+
     public:
         histogram_impl(const uint pNBins, const fg::dtype pDataType);
         ~histogram_impl();
 
+        /* Enable binning of raw samples on GPU
+         *
+         * @pNumSamples is the number of float samples
+         * @pMinValue is the lower limit of the binning range
+         * @pMaxValue is the upper limit of the binning range
+         * @pNormalize indicates whether frequencies are divided by sample count
+         * @pCumulative indicates whether cumulative frequencies are computed
+         */
+        void setSampleBinning(const uint pNumSamples,
+                              const float pMinValue, const float pMaxValue,
+                              const bool pNormalize, const bool pCumulative);
+
+        GLuint sbo() const { return mSBO; }
+        size_t sboSize() const { return mSBOSize; }
+
+        GLuint buffer(const fg::BufferKind pKind, size_t& pSize) override;
+
         void render(const int pWindowId,
                     const int pX, const int pY, const int pVPW, const int pVPH,
                     const glm::mat4 &pView);
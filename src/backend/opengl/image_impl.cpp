@@ -10,20 +10,72 @@
 #include <common.hpp>
 #include <err_opengl.hpp>
 #include <image_impl.hpp>
+#include <profiler_impl.hpp>
+#include <trace_impl.hpp>
 #include <window_impl.hpp>
 #include <shader_headers/image_vs.hpp>
 #include <shader_headers/image_fs.hpp>
+#include <shader_headers/image_mip_fs.hpp>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
 #include <map>
 #include <mutex>
 
 namespace opengl
 {
 
+/* factor that converts values sampled from a texture
+ * of given type to the units of source data */
+static float valueScale(const fg::dtype pType)
+{
+    switch(pType) {
+        case fg::s8:  return 127.0f;
+        case fg::u8:  return 255.0f;
+        case fg::s16: return 32767.0f;
+        case fg::u16: return 65535.0f;
+        default:  return 1.0f;
+    }
+}
+
+/* largest value representable by given type, this
+ * is the default upper limit of pixel value range */
+static float typeMax(const fg::dtype pType)
+{
+    switch(pType) {
+        case fg::s8:  return 127.0f;
+        case fg::u8:  return 255.0f;
+        case fg::s16: return 32767.0f;
+        case fg::u16: return 65535.0f;
+        case fg::s32: return 2147483647.0f;
+        case fg::u32: return 4294967295.0f;
+        default:  return 1.0f;
+    }
+}
+
+static bool isYUVFormat(const fg::ChannelFormat pFormat)
+{
+    return (pFormat == FG_NV12 || pFormat == FG_YUYV);
+}
+
+static bool isBayerFormat(const fg::ChannelFormat pFormat)
+{
+    return (pFormat == FG_BAYER_RGGB || pFormat == FG_BAYER_BGGR ||
+            pFormat == FG_BAYER_GRBG || pFormat == FG_BAYER_GBRG);
+}
+
+/* YUV to RGB conversion matrices for limited range(16-235) video
+ * data, stored column major as expected by glUniformMatrix3fv */
+static const float BT601[] = {1.164f,  1.164f, 1.164f,
+                              0.000f, -0.392f, 2.017f,
+                              1.596f, -0.813f, 0.000f};
+static const float BT709[] = {1.164f,  1.164f, 1.164f,
+                              0.000f, -0.213f, 2.112f,
+                              1.793f, -0.533f, 0.000f};
+
 void image_impl::bindResources(int pWindowId) const
 {
     glBindVertexArray(screenQuadVAO(pWindowId));
@@ -34,23 +86,68 @@ void image_impl::unbindResources() const
     glBindVertexArray(0);
 }
 
+uint image_impl::textureWidth() const
+{
+    return (mFormat == FG_YUYV ? mWidth / 2 : mWidth);
+}
+
 image_impl::image_impl(const uint pWidth, const uint pHeight,
                        const fg::ChannelFormat pFormat, const fg::dtype pDataType)
     : mWidth(pWidth), mHeight(pHeight), mFormat(pFormat),
-      mGLformat(ctype2gl(mFormat)), mGLiformat(ictype2gl(mFormat)),
+      mGLformat(ctype2gl(mFormat, pDataType)), mGLiformat(ictype2gl(mFormat, pDataType)),
       mDataType(pDataType), mGLType(dtype2gl(mDataType)), mAlpha(1.0f),
-      mKeepARatio(true), mFormatSize(1), mMatIndex(-1), mTexIndex(-1),
-      mNumCIndex(-1), mAlphaIndex(-1), mCMapLenIndex(-1), mCMapIndex(-1)
+      mKeepARatio(true), mMinValue(0.0f), mMaxValue(typeMax(pDataType)),
+      mGamma(1.0f), mLogScale(false), mYUVMatrix(FG_YUV_BT601), mFilter(FG_FILTER_NEAREST),
+      mFilterChanged(false), mMipsDirty(false), mNumLevels(1), mFormatSize(1), mUploadPBO(0), mIsDirty(true), mTrackDirty(false),
+      mMatIndex(-1), mTexIndex(-1),
+      mNumCIndex(-1), mAlphaIndex(-1), mValScaleIndex(-1), mRangeIndex(-1),
+      mGammaIndex(-1), mLogIndex(-1), mAlphaMaxIndex(-1), mUVTexIndex(-1), mYUVIndex(-1),
+      mRedPosIndex(-1), mMipProgram(0), mMipMatIndex(-1), mMipTexIndex(-1),
+      mCMapLenIndex(-1), mCMapIndex(-1),
+      mCMapTex(0), mCMapLen(0), mUserCMap(0), mUserCMapLen(0)
 {
     CheckGL("Begin image_impl::image_impl");
 
-    mProgram      = initShaders(glsl::image_vs.c_str(), glsl::image_fs.c_str());
-    mMatIndex     = glGetUniformLocation(mProgram, "matrix");
-    mCMapIndex    = glGetUniformBlockIndex(mProgram, "ColorMap");
-    mCMapLenIndex = glGetUniformLocation(mProgram, "cmaplen");
-    mTexIndex     = glGetUniformLocation(mProgram, "tex");
-    mNumCIndex    = glGetUniformLocation(mProgram, "numcomps");
-    mAlphaIndex   = glGetUniformLocation(mProgram, "alpha");
+    if (mDataType == fg::f64)
+        throw fg::TypeError("image_impl::image_impl", __LINE__, 4, mDataType);
+
+    if (isYUVFormat(mFormat)) {
+        if (mDataType != fg::u8)
+            throw fg::TypeError("image_impl::image_impl", __LINE__, 4, mDataType);
+        if (mWidth % 2 || (mFormat == FG_NV12 && mHeight % 2))
+            throw fg::DimensionError("image_impl::image_impl", __LINE__, 1,
+                                     "YUV images with subsampled chroma need even dimensions");
+    } else if (isBayerFormat(mFormat)) {
+        if (mDataType != fg::u8 && mDataType != fg::u16)
+            throw fg::TypeError("image_impl::image_impl", __LINE__, 4, mDataType);
+    }
+
+    std::string fragShader = glsl::image_fs;
+    if (isIntegerTexture(mDataType))
+        fragShader = addShaderDefines(fragShader, mDataType==fg::u32 ? "#define SAMPLER usampler2D"
+                                                                 : "#define SAMPLER isampler2D");
+    else if (mFormat == FG_NV12)
+        fragShader = addShaderDefines(fragShader, "#define NV12");
+    else if (mFormat == FG_YUYV)
+        fragShader = addShaderDefines(fragShader, "#define YUYV");
+    else if (isBayerFormat(mFormat))
+        fragShader = addShaderDefines(fragShader, "#define BAYER");
+
+    mProgram       = initShaders(glsl::image_vs.c_str(), fragShader.c_str());
+    mMatIndex      = glGetUniformLocation(mProgram, "matrix");
+    mCMapIndex     = glGetUniformLocation(mProgram, "cmap");
+    mCMapLenIndex  = glGetUniformLocation(mProgram, "cmaplen");
+    mTexIndex      = glGetUniformLocation(mProgram, "tex");
+    mNumCIndex     = glGetUniformLocation(mProgram, "numcomps");
+    mAlphaIndex    = glGetUniformLocation(mProgram, "alpha");
+    mValScaleIndex = glGetUniformLocation(mProgram, "valscale");
+    mRangeIndex    = glGetUniformLocation(mProgram, "range");
+    mGammaIndex    = glGetUniformLocation(mProgram, "gamma");
+    mLogIndex      = glGetUniformLocation(mProgram, "uselog");
+    mAlphaMaxIndex = glGetUniformLocation(mProgram, "alphamax");
+    mUVTexIndex    = glGetUniformLocation(mProgram, "uvtex");
+    mYUVIndex      = glGetUniformLocation(mProgram, "yuv2rgb");
+    mRedPosIndex   = glGetUniformLocation(mProgram, "redpos");
 
     // Initialize OpenGL Items
     glGenTextures(1, &(mTex));
@@ -60,7 +157,21 @@ image_impl::image_impl(const uint pWidth, const uint pHeight,
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 
-    glTexImage2D(GL_TEXTURE_2D, 0, mGLiformat, mWidth, mHeight, 0, mGLformat, mGLType, NULL);
+    glTexImage2D(GL_TEXTURE_2D, 0, mGLiformat, textureWidth(), mHeight, 0, mGLformat, mGLType, NULL);
+
+    while ((std::max(mWidth, mHeight) >> mNumLevels) > 0)
+        mNumLevels++;
+
+    mUVTex = 0;
+    if (mFormat == FG_NV12) {
+        glGenTextures(1, &mUVTex);
+        glBindTexture(GL_TEXTURE_2D, mUVTex);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RG8, mWidth/2, mHeight/2, 0, GL_RG, GL_UNSIGNED_BYTE, NULL);
+    }
 
     CheckGL("Before PBO Initialization");
     glGenBuffers(1, &mPBO);
@@ -71,6 +182,7 @@ image_impl::image_impl(const uint pWidth, const uint pHeight,
         case GL_UNSIGNED_INT:   typeSize = sizeof(uint  ); break;
         case GL_SHORT:          typeSize = sizeof(short ); break;
         case GL_UNSIGNED_SHORT: typeSize = sizeof(ushort); break;
+        case GL_HALF_FLOAT:     typeSize = sizeof(ushort); break;
         case GL_BYTE:           typeSize = sizeof(char  ); break;
         case GL_UNSIGNED_BYTE:  typeSize = sizeof(uchar ); break;
         default: typeSize = sizeof(float); break;
@@ -82,9 +194,25 @@ image_impl::image_impl(const uint pWidth, const uint pHeight,
         case FG_BGR:       mFormatSize = 3;   break;
         case FG_RGBA:      mFormatSize = 4;   break;
         case FG_BGRA:      mFormatSize = 4;   break;
+        case FG_NV12:
+        case FG_YUYV:
+        case FG_BAYER_RGGB:
+        case FG_BAYER_BGGR:
+        case FG_BAYER_GRBG:
+        case FG_BAYER_GBRG: mFormatSize = 3;  break;
         default: mFormatSize = 1; break;
     }
-    mPBOsize = mWidth * mHeight * mFormatSize * typeSize;
+    switch(mFormat) {
+        /* full resolution luma followed by quarter resolution U, V pairs */
+        case FG_NV12: mPBOsize = mWidth * mHeight * 3 / 2; break;
+        /* one Y and either of U or V per pixel */
+        case FG_YUYV: mPBOsize = mWidth * mHeight * 2;     break;
+        case FG_BAYER_RGGB:
+        case FG_BAYER_BGGR:
+        case FG_BAYER_GRBG:
+        case FG_BAYER_GBRG: mPBOsize = mWidth * mHeight * typeSize; break;
+        default: mPBOsize = mWidth * mHeight * mFormatSize * typeSize; break;
+    }
     glBufferData(GL_PIXEL_UNPACK_BUFFER, mPBOsize, NULL, GL_STREAM_COPY);
 
     glBindTexture(GL_TEXTURE_2D, 0);
@@ -97,25 +225,132 @@ image_impl::~image_impl()
 {
     CheckGL("Begin image_impl::~image_impl");
     glDeleteBuffers(1, &mPBO);
+    if (mUploadPBO)
+        glDeleteBuffers(1, &mUploadPBO);
     glDeleteTextures(1, &mTex);
+    if (mUVTex)
+        glDeleteTextures(1, &mUVTex);
+    for (auto it = mMipFBOMap.begin(); it != mMipFBOMap.end(); ++it) {
+        GLuint fbo = it->second;
+        glDeleteFramebuffers(1, &fbo);
+    }
+    if (mMipProgram)
+        glDeleteProgram(mMipProgram);
+    if (mUserCMap)
+        glDeleteTextures(1, &mUserCMap);
     glDeleteProgram(mProgram);
     CheckGL("End image_impl::~image_impl");
 }
 
-void image_impl::setColorMapUBOParams(const GLuint pUBO, const GLuint pSize)
+void image_impl::setColorMapParams(const GLuint pTexture, const GLuint pLength)
 {
-    mColorMapUBO = pUBO;
-    mUBOSize = pSize;
+    mCMapTex = pTexture;
+    mCMapLen = pLength;
+}
+
+void image_impl::setColorMap(const float* pRGBA, const size_t pLength)
+{
+    if (mUserCMap) {
+        glDeleteTextures(1, &mUserCMap);
+        mUserCMap    = 0;
+        mUserCMapLen = 0;
+    }
+    /* null color map reverts to the color map of window */
+    if (pRGBA != NULL) {
+        mUserCMap    = createColorMapTexture(pRGBA, pLength);
+        mUserCMapLen = (GLuint)pLength;
+    }
+    ++mVersion;
 }
 
 void image_impl::setAlpha(const float pAlpha)
 {
     mAlpha = pAlpha;
+    ++mVersion;
 }
 
 void image_impl::keepAspectRatio(const bool pKeep)
 {
-    mKeepARatio = pKeep;
+    if (mKeepARatio != pKeep) {
+        mKeepARatio = pKeep;
+        ++mVersion;
+    }
+}
+
+void image_impl::setValueRange(const float pMin, const float pMax,
+                               const float pGamma, const bool pLogScale)
+{
+    if (!(pMax > pMin))
+        throw fg::ArgumentError("image_impl::setValueRange", __LINE__, 2,
+                                "Upper limit of value range should be greater than lower limit");
+    if (!(pGamma > 0.0f))
+        throw fg::ArgumentError("image_impl::setValueRange", __LINE__, 3,
+                                "Gamma should be a positive value");
+    mMinValue = pMin;
+    mMaxValue = pMax;
+    mGamma    = pGamma;
+    mLogScale = pLogScale;
+    ++mVersion;
+}
+
+void image_impl::setFilter(const fg::FilterMode pFilter)
+{
+    const bool hadMipmaps = usesMipmaps();
+    mFilter        = pFilter;
+    mFilterChanged = true;
+    /* mip chain is out of date when it wasn't being maintained */
+    if (usesMipmaps() && !hadMipmaps)
+        mMipsDirty = true;
+    ++mVersion;
+}
+
+void image_impl::setYUVMatrix(const fg::YUVMatrix pMatrix)
+{
+    mYUVMatrix = pMatrix;
+    ++mVersion;
+}
+
+void image_impl::markDirty()
+{
+    if (!mTrackDirty) {
+        /* uploads read from a copy of mPBO in this buffer, user
+         * can fill mPBO for next frame while they are in flight */
+        glGenBuffers(1, &mUploadPBO);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, mUploadPBO);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, mPBOsize, NULL, GL_STREAM_COPY);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        mTrackDirty = true;
+    }
+    mIsDirty = true;
+    ++mVersion;
+}
+
+unsigned long long image_impl::version()
+{
+    /* without dirty tracking pixels may change
+     * behind our back, hence always out of date */
+    if (!mTrackDirty)
+        ++mVersion;
+    return mVersion;
+}
+
+void* image_impl::map()
+{
+    checkContextCurrent("image_impl::map");
+
+    /* once dirty tracking is on, mPBO is read only by the copy into
+     * mUploadPBO, texture uploads read the copy. Invalidating mPBO
+     * lets the driver hand out fresh storage instead of waiting on
+     * the copy. Without dirty tracking, mPBO is uploaded directly */
+    return mapBuffer(mPBO, mPBOsize, true);
+}
+
+void image_impl::unmap()
+{
+    checkContextCurrent("image_impl::unmap");
+
+    unmapBuffer(mPBO);
+    markDirty();
 }
 
 uint image_impl::width() const { return mWidth; }
@@ -130,11 +365,180 @@ uint image_impl::pbo() const { return mPBO; }
 
 uint image_impl::size() const { return (uint)mPBOsize; }
 
+void image_impl::applyFilter()
+{
+    /* integer textures can only be sampled with nearest filters */
+    const bool isInt = isIntegerTexture(mDataType);
+    GLint magFilter = GL_NEAREST;
+    GLint minFilter = GL_NEAREST;
+    if (usesMipmaps()) {
+        magFilter = (isInt ? GL_NEAREST : GL_LINEAR);
+        minFilter = (isInt ? GL_NEAREST_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR);
+    } else if (mFilter == FG_FILTER_LINEAR && !isInt) {
+        magFilter = GL_LINEAR;
+        minFilter = GL_LINEAR;
+    }
+    GLfloat anisotropy = 1.0f;
+    if (mFilter == FG_FILTER_ANISOTROPIC && !isInt && GLEW_EXT_texture_filter_anisotropic)
+        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &anisotropy);
+
+    GLuint texs[] = {mTex, mUVTex};
+    for (int i = 0; i < 2; ++i) {
+        if (texs[i] == 0)
+            continue;
+        glBindTexture(GL_TEXTURE_2D, texs[i]);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+        if (GLEW_EXT_texture_filter_anisotropic)
+            glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, anisotropy);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void image_impl::generateMipmaps(const int pWindowId)
+{
+    CheckGL("Begin image_impl::generateMipmaps");
+    if (!isIntegerTexture(mDataType)) {
+        glBindTexture(GL_TEXTURE_2D, mTex);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        if (mUVTex) {
+            glBindTexture(GL_TEXTURE_2D, mUVTex);
+            glGenerateMipmap(GL_TEXTURE_2D);
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        CheckGL("End image_impl::generateMipmaps");
+        return;
+    }
+
+    /* integer textures are not filterable, hence glGenerateMipmap
+     * can't be used. Each level is rendered from the previous one
+     * with a 2x2 box filter instead. */
+    if (mMipProgram == 0) {
+        std::string fragShader = addShaderDefines(glsl::image_mip_fs,
+                mDataType==fg::u32 ? "#define SAMPLER usampler2D\n#define TEXEL uvec4"
+                                   : "#define SAMPLER isampler2D\n#define TEXEL ivec4");
+        mMipProgram  = initShaders(glsl::image_vs.c_str(), fragShader.c_str());
+        mMipMatIndex = glGetUniformLocation(mMipProgram, "matrix");
+        mMipTexIndex = glGetUniformLocation(mMipProgram, "tex");
+
+        glBindTexture(GL_TEXTURE_2D, mTex);
+        for (GLuint l = 1; l < mNumLevels; ++l) {
+            glTexImage2D(GL_TEXTURE_2D, l, mGLiformat,
+                         std::max(1u, mWidth >> l), std::max(1u, mHeight >> l), 0,
+                         mGLformat, mGLType, NULL);
+        }
+    }
+
+    if (mMipFBOMap.find(pWindowId) == mMipFBOMap.end()) {
+        GLuint fbo = 0;
+        glGenFramebuffers(1, &fbo);
+        mMipFBOMap[pWindowId] = fbo;
+    }
+
+    GLint prevFBO = 0;
+    GLint prevViewport[4];
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevFBO);
+    glGetIntegerv(GL_VIEWPORT, prevViewport);
+    GLboolean isScissorOn = glIsEnabled(GL_SCISSOR_TEST);
+    GLboolean isDepthOn   = glIsEnabled(GL_DEPTH_TEST);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mMipFBOMap[pWindowId]);
+    glDisable(GL_SCISSOR_TEST);
+    glDisable(GL_DEPTH_TEST);
+
+    glUseProgram(mMipProgram);
+    glUniformMatrix4fv(mMipMatIndex, 1, GL_FALSE, glm::value_ptr(IDENTITY));
+    glActiveTexture(GL_TEXTURE0);
+    glUniform1i(mMipTexIndex, 0);
+    glBindTexture(GL_TEXTURE_2D, mTex);
+    bindResources(pWindowId);
+    for (GLuint l = 1; l < mNumLevels; ++l) {
+        /* restrict sampling to source level so that
+         * target level is not part of a feedback loop */
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, l-1);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, l-1);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mTex, l);
+        glViewport(0, 0, std::max(1u, mWidth >> l), std::max(1u, mHeight >> l));
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        countDrawCall();
+    }
+    unbindResources();
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mNumLevels-1);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, prevFBO);
+    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+    if (isScissorOn) glEnable(GL_SCISSOR_TEST);
+    if (isDepthOn) glEnable(GL_DEPTH_TEST);
+    CheckGL("End image_impl::generateMipmaps");
+}
+
+bool image_impl::usesMipmaps() const
+{
+    /* YUYV and Bayer textures are not images by themselves, hence
+     * they can't be mipmapped. Three channel integer textures are
+     * not color renderable, so their levels can't be generated */
+    return (mFilter == FG_FILTER_TRILINEAR || mFilter == FG_FILTER_ANISOTROPIC) &&
+           mFormat != FG_YUYV && !isBayerFormat(mFormat) &&
+           !(isIntegerTexture(mDataType) && ictype2gl(mFormat) == GL_RGB);
+}
+
+void image_impl::updateTexture(const int pWindowId)
+{
+    ProfileScope scope(FG_STAT_UPLOAD, this);
+    if (mIsDirty) {
+        countUploadBytes(mPBOsize);
+        GLuint source = mPBO;
+        if (mTrackDirty) {
+            /* the copy is all that writes to mPBO have to wait for */
+            glBindBuffer(GL_COPY_READ_BUFFER, mPBO);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, mUploadPBO);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, mPBOsize);
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            source = mUploadPBO;
+        }
+        // bind PBO to load data into texture
+        glBindTexture(GL_TEXTURE_2D, mTex);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, source);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, textureWidth(), mHeight, mGLformat, mGLType, 0);
+        if (mFormat == FG_NV12) {
+            /* chroma plane follows the luma plane in PBO */
+            glBindTexture(GL_TEXTURE_2D, mUVTex);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, mWidth/2, mHeight/2, GL_RG, GL_UNSIGNED_BYTE,
+                            (const GLvoid*)(size_t(mWidth) * mHeight));
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        /* nothing is uploaded until the image is marked dirty again */
+        if (mTrackDirty)
+            mIsDirty = false;
+        mMipsDirty = usesMipmaps();
+    }
+    if (mFilterChanged) {
+        applyFilter();
+        mFilterChanged = false;
+    }
+    if (mMipsDirty) {
+        generateMipmaps(pWindowId);
+        mMipsDirty = false;
+    }
+}
+
 void image_impl::render(const int pWindowId,
                         const int pX, const int pY, const int pVPW, const int pVPH,
                         const glm::mat4 &pView)
 {
     CheckGL("Begin image_impl::render");
+    ProfileScope scope(FG_STAT_RENDERABLE, this, mLegend);
+    FG_TRACE_GPU_SCOPE("image_impl::render");
+
+    updateTexture(pWindowId);
 
     float xscale = 1.f;
     float yscale = 1.f;
@@ -162,30 +566,56 @@ void image_impl::render(const int pWindowId,
 
     glUniform1i(mNumCIndex, mFormatSize);
     glUniform1f(mAlphaIndex, mAlpha);
+    glUniform1f(mValScaleIndex, valueScale(mDataType));
+    glUniform2f(mRangeIndex, mMinValue, mMaxValue);
+    glUniform1f(mGammaIndex, mGamma);
+    glUniform1i(mLogIndex, mLogScale);
+    glUniform1f(mAlphaMaxIndex, typeMax(mDataType));
+    if (isYUVFormat(mFormat)) {
+        glUniformMatrix3fv(mYUVIndex, 1, GL_FALSE,
+                           (mYUVMatrix == FG_YUV_BT709 ? BT709 : BT601));
+    } else if (isBayerFormat(mFormat)) {
+        switch(mFormat) {
+            case FG_BAYER_BGGR: glUniform2i(mRedPosIndex, 1, 1); break;
+            case FG_BAYER_GRBG: glUniform2i(mRedPosIndex, 1, 0); break;
+            case FG_BAYER_GBRG: glUniform2i(mRedPosIndex, 0, 1); break;
+            default:            glUniform2i(mRedPosIndex, 0, 0); break;
+        }
+    }
 
-    // load texture from PBO
     glActiveTexture(GL_TEXTURE0);
     glUniform1i(mTexIndex, 0);
     glBindTexture(GL_TEXTURE_2D, mTex);
-    // bind PBO to load data into texture
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, mPBO);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, mWidth, mHeight, mGLformat, mGLType, 0);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
     glUniformMatrix4fv(mMatIndex, 1, GL_FALSE, glm::value_ptr(strans));
 
-    glUniform1f(mCMapLenIndex, (GLfloat)mUBOSize);
-    glBindBufferBase(GL_UNIFORM_BUFFER, 0, mColorMapUBO);
-    glUniformBlockBinding(mProgram, mCMapIndex, 0);
+    GLuint cmapTex = mUserCMap ? mUserCMap    : mCMapTex;
+    GLuint cmapLen = mUserCMap ? mUserCMapLen : mCMapLen;
+    glUniform1f(mCMapLenIndex, (GLfloat)cmapLen);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_1D, cmapTex);
+    glUniform1i(mCMapIndex, 1);
+    if (mFormat == FG_NV12) {
+        glActiveTexture(GL_TEXTURE2);
+        glBindTexture(GL_TEXTURE_2D, mUVTex);
+        glUniform1i(mUVTexIndex, 2);
+    }
+    glActiveTexture(GL_TEXTURE0);
 
     // Draw to screen
     bindResources(pWindowId);
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    countDrawCall();
     unbindResources();
 
     glBindTexture(GL_TEXTURE_2D, 0);
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_1D, 0);
+    if (mFormat == FG_NV12) {
+        glActiveTexture(GL_TEXTURE2);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    glActiveTexture(GL_TEXTURE0);
 
     // ubind the shader program
     glUseProgram(0);
@@ -11,6 +11,7 @@
 
 #include <common.hpp>
 
+#include <map>
 #include <memory>
 
 namespace opengl
@@ -27,35 +28,93 @@ class image_impl : public AbstractRenderable {
         GLenum mGLType;
         float  mAlpha;
         bool   mKeepARatio;
+        /* range of pixel values, in units of source data,
+         * that is mapped onto the color map */
+        float  mMinValue;
+        float  mMaxValue;
+        float  mGamma;
+        bool   mLogScale;
+        fg::YUVMatrix mYUVMatrix;
+        /* texture filtering, mip levels are regenerated
+         * after uploads when mipmapping is in use */
+        fg::FilterMode mFilter;
+        bool   mFilterChanged;
+        bool   mMipsDirty;
+        GLuint mNumLevels;
         size_t mFormatSize;
         /* internal resources for interop */
         size_t mPBOsize;
+        /* mPBO is the buffer filled by user, its identifier never
+         * changes. Once dirty tracking is on, its contents are copied
+         * to mUploadPBO and uploaded from there, hence the user can
+         * fill mPBO for the next frame while the upload is in flight */
         GLuint mPBO;
+        GLuint mUploadPBO;
+        /* until markDirty is first called, texture is uploaded from
+         * mPBO directly on every render. From then on mTrackDirty stays
+         * set and mPBO is copied to mUploadPBO and uploaded from there
+         * only on the first render after each markDirty, see mIsDirty */
+        bool   mIsDirty;
+        bool   mTrackDirty;
         GLuint mTex;
+        /* chroma plane of NV12 images */
+        GLuint mUVTex;
         GLuint mProgram;
         GLuint mMatIndex;
         GLuint mTexIndex;
         GLuint mNumCIndex;
         GLuint mAlphaIndex;
+        GLuint mValScaleIndex;
+        GLuint mRangeIndex;
+        GLuint mGammaIndex;
+        GLuint mLogIndex;
+        GLuint mAlphaMaxIndex;
+        GLuint mUVTexIndex;
+        GLuint mYUVIndex;
+        GLuint mRedPosIndex;
+        /* box filter program used to build mip levels of integer textures */
+        GLuint mMipProgram;
+        GLuint mMipMatIndex;
+        GLuint mMipTexIndex;
+        std::map<int, GLuint> mMipFBOMap;
         GLuint mCMapLenIndex;
         GLuint mCMapIndex;
-        /* color map details */
-        GLuint mColorMapUBO;
-        GLuint mUBOSize;
+        /* color map details, mUserCMap when set
+         * overrides the color map of window */
+        GLuint mCMapTex;
+        GLuint mCMapLen;
+        GLuint mUserCMap;
+        GLuint mUserCMapLen;
 
         /* helper functions to bind and unbind
          * resources for render quad primitive */
         void bindResources(int pWindowId) const;
         void unbindResources() const;
+        /* width of texture holding image pixels, YUYV
+         * texels hold two pixels each */
+        uint textureWidth() const;
+        bool usesMipmaps() const;
+        void applyFilter();
+        void generateMipmaps(const int pWindowId);
+        void updateTexture(const int pWindowId);
 
     public:
         image_impl(const uint pWidth, const uint pHeight,
                    const fg::ChannelFormat pFormat, const fg::dtype pDataType);
         ~image_impl();
 
-        void setColorMapUBOParams(const GLuint pUBO, const GLuint pSize);
+        void setColorMapParams(const GLuint pTexture, const GLuint pLength);
+        void setColorMap(const float* pRGBA, const size_t pLength);
         void setAlpha(const float pAlpha);
         void keepAspectRatio(const bool pKeep=true);
+        void setValueRange(const float pMin, const float pMax,
+                           const float pGamma, const bool pLogScale);
+        void setFilter(const fg::FilterMode pFilter);
+        void setYUVMatrix(const fg::YUVMatrix pMatrix);
+        void markDirty() override;
+        unsigned long long version() override;
+        void* map();
+        void unmap();
 
         uint width() const;
         uint height() const;
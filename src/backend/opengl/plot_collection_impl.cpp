@@ -0,0 +1,304 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <err_opengl.hpp>
+#include <plot_collection_impl.hpp>
+#include <plot_impl.hpp>
+#include <profiler_impl.hpp>
+#include <trace_impl.hpp>
+#include <shader_headers/plot_collection_vs.hpp>
+#include <shader_headers/histogram_fs.hpp>
+#include <shader_headers/marker_fs.hpp>
+#include <shader_headers/plot3_fs.hpp>
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cmath>
+
+using namespace std;
+
+namespace opengl
+{
+
+/* distinct colors for consecutive series, hues are
+ * spaced by the golden ratio so that neighbours differ */
+static void seriesColor(const uint pSeries, float pRGB[3])
+{
+    const float h = std::fmod(pSeries * 0.618034f, 1.0f) * 6.0f;
+    const float s = 0.75f, v = 0.85f;
+    const int   i = (int)h % 6;
+    const float f = h - std::floor(h);
+    const float p = v * (1 - s), q = v * (1 - s * f), t = v * (1 - s * (1 - f));
+    const float rgb[6][3] = {{v, t, p}, {q, v, p}, {p, v, t},
+                             {p, q, v}, {t, p, v}, {v, p, q}};
+    pRGB[0] = rgb[i][0];
+    pRGB[1] = rgb[i][1];
+    pRGB[2] = rgb[i][2];
+}
+
+void plot_collection_impl::bindResources(const int pWindowId)
+{
+    if (mVAOMap.find(pWindowId) == mVAOMap.end()) {
+        GLuint vao = 0;
+        /* create a vertex array object
+         * with appropriate bindings */
+        glGenVertexArrays(1, &vao);
+        glBindVertexArray(vao);
+        // attach vertices, colors are fetched per series
+        glEnableVertexAttribArray(mLinePointIndex);
+        glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+        glVertexAttribPointer(mLinePointIndex, mDimension, mGLType, isNormalized(mDataType), 0, 0);
+        glBindVertexArray(0);
+        /* store the vertex array object corresponding to
+         * the window instance in the map */
+        mVAOMap[pWindowId] = vao;
+    }
+
+    glBindVertexArray(mVAOMap[pWindowId]);
+}
+
+void plot_collection_impl::unbindResources() const
+{
+    glBindVertexArray(0);
+}
+
+void plot_collection_impl::setSeriesUniforms(const GLuint pMatIndex, const GLuint pLengthIndex,
+                                             const GLuint pColorsIndex, const GLuint pAlphasIndex,
+                                             const glm::mat4& pTransform)
+{
+    glUniformMatrix4fv(pMatIndex, 1, GL_FALSE, glm::value_ptr(pTransform));
+    glUniform1i(pLengthIndex, mSeriesLength);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, mColorTex);
+    glUniform1i(pColorsIndex, 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_BUFFER, mAlphaTex);
+    glUniform1i(pAlphasIndex, 1);
+}
+
+plot_collection_impl::plot_collection_impl(const uint pNumSeries, const uint pNumPoints,
+                                           const fg::dtype pDataType, const fg::ChartType pChartType,
+                                           const fg::PlotType pPlotType, const fg::MarkerType pMarkerType)
+    : mDimension(pChartType == FG_CHART_2D ? 2 : 3), mMarkerSize(12),
+      mNumSeries(pNumSeries), mSeriesLength(pNumPoints), mDataType(pDataType),
+      mGLType(dtype2gl(mDataType)), mMarkerType(pMarkerType), mPlotType(pPlotType),
+      mLineProgram(0), mMarkerProgram(0), mColorTex(0), mAlphaTex(0),
+      mLineMatIndex(-1), mLineLengthIndex(-1), mLineColorsIndex(-1), mLineAlphasIndex(-1),
+      mLinePVCOnIndex(-1), mLinePVAOnIndex(-1), mLineRangeIndex(-1), mLinePointIndex(-1),
+      mMarkerMatIndex(-1), mMarkerLengthIndex(-1), mMarkerColorsIndex(-1), mMarkerAlphasIndex(-1),
+      mMarkerPVCOnIndex(-1), mMarkerPVAOnIndex(-1), mMarkerTypeIndex(-1), mMarkerPSizeIndex(-1)
+{
+    CheckGL("Begin plot_collection_impl::plot_collection_impl");
+    if (pNumSeries == 0 || pNumPoints == 0)
+        throw fg::ArgumentError("plot_collection_impl::plot_collection_impl", __LINE__, 1,
+                                "Collection needs at least one series of one point");
+
+    mIsPVCOn = true;
+    mIsPVAOn = false;
+
+    mLegend  = std::string("");
+
+    if (mDimension == 2) {
+        mLineProgram    = initShaders(glsl::plot_collection_vs.c_str(), glsl::histogram_fs.c_str());
+    } else {
+        mLineProgram    = initShaders(glsl::plot_collection_vs.c_str(), glsl::plot3_fs.c_str());
+        mLineRangeIndex = glGetUniformLocation(mLineProgram, "minmaxs");
+    }
+    mMarkerProgram = initShaders(glsl::plot_collection_vs.c_str(), glsl::marker_fs.c_str());
+
+    mLineMatIndex      = glGetUniformLocation(mLineProgram, "transform");
+    mLineLengthIndex   = glGetUniformLocation(mLineProgram, "seriesLength");
+    mLineColorsIndex   = glGetUniformLocation(mLineProgram, "colors");
+    mLineAlphasIndex   = glGetUniformLocation(mLineProgram, "alphas");
+    mLinePVCOnIndex    = glGetUniformLocation(mLineProgram, "isPVCOn");
+    mLinePVAOnIndex    = glGetUniformLocation(mLineProgram, "isPVAOn");
+    mLinePointIndex    = glGetAttribLocation (mLineProgram, "point");
+
+    mMarkerMatIndex    = glGetUniformLocation(mMarkerProgram, "transform");
+    mMarkerLengthIndex = glGetUniformLocation(mMarkerProgram, "seriesLength");
+    mMarkerColorsIndex = glGetUniformLocation(mMarkerProgram, "colors");
+    mMarkerAlphasIndex = glGetUniformLocation(mMarkerProgram, "alphas");
+    mMarkerPVCOnIndex  = glGetUniformLocation(mMarkerProgram, "isPVCOn");
+    mMarkerPVAOnIndex  = glGetUniformLocation(mMarkerProgram, "isPVAOn");
+    mMarkerTypeIndex   = glGetUniformLocation(mMarkerProgram, "marker_type");
+    mMarkerPSizeIndex  = glGetUniformLocation(mMarkerProgram, "psize");
+
+    mVBOSize = (size_t)mDimension * mNumSeries * mSeriesLength;
+
+#define COLLECTION_CREATE_BUFFERS(type)   \
+        mVBO = createBuffer<type>(GL_ARRAY_BUFFER, mVBOSize, NULL, GL_DYNAMIC_DRAW);    \
+        mVBOSize *= sizeof(type);
+
+    switch(mGLType) {
+        case GL_FLOAT          : COLLECTION_CREATE_BUFFERS(float) ; break;
+        case GL_INT            : COLLECTION_CREATE_BUFFERS(int)   ; break;
+        case GL_UNSIGNED_INT   : COLLECTION_CREATE_BUFFERS(uint)  ; break;
+        case GL_SHORT          : COLLECTION_CREATE_BUFFERS(short) ; break;
+        case GL_UNSIGNED_SHORT : COLLECTION_CREATE_BUFFERS(ushort); break;
+        case GL_HALF_FLOAT     : COLLECTION_CREATE_BUFFERS(ushort); break;
+        case GL_BYTE           : COLLECTION_CREATE_BUFFERS(char)  ; break;
+        case GL_UNSIGNED_BYTE  : COLLECTION_CREATE_BUFFERS(uchar) ; break;
+        default: throw fg::TypeError("plot_collection_impl::plot_collection_impl",
+                                     __LINE__, 3, mDataType);
+    }
+#undef COLLECTION_CREATE_BUFFERS
+
+    std::vector<float> colors(3 * mNumSeries);
+    std::vector<float> alphas(mNumSeries, 1.0f);
+    for (uint i = 0; i < mNumSeries; ++i)
+        seriesColor(i, &colors[3 * i]);
+    setColor(colors[0], colors[1], colors[2], 1.0f);
+
+    mCBOSize = colors.size() * sizeof(float);
+    mABOSize = alphas.size() * sizeof(float);
+    mCBO = createBuffer<float>(GL_TEXTURE_BUFFER, colors.size(), colors.data(), GL_DYNAMIC_DRAW);
+    mABO = createBuffer<float>(GL_TEXTURE_BUFFER, alphas.size(), alphas.data(), GL_DYNAMIC_DRAW);
+
+    glGenTextures(1, &mColorTex);
+    glBindTexture(GL_TEXTURE_BUFFER, mColorTex);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, mCBO);
+    glGenTextures(1, &mAlphaTex);
+    glBindTexture(GL_TEXTURE_BUFFER, mAlphaTex);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, mABO);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    mFirsts.resize(mNumSeries);
+    mCounts.resize(mNumSeries, mSeriesLength);
+    for (uint i = 0; i < mNumSeries; ++i)
+        mFirsts[i] = i * mSeriesLength;
+
+    CheckGL("End plot_collection_impl::plot_collection_impl");
+}
+
+plot_collection_impl::~plot_collection_impl()
+{
+    CheckGL("Begin plot_collection_impl::~plot_collection_impl");
+    for (auto it = mVAOMap.begin(); it!=mVAOMap.end(); ++it) {
+        GLuint vao = it->second;
+        glDeleteVertexArrays(1, &vao);
+    }
+    glDeleteTextures(1, &mColorTex);
+    glDeleteTextures(1, &mAlphaTex);
+    glDeleteBuffers(1, &mVBO);
+    glDeleteBuffers(1, &mCBO);
+    glDeleteBuffers(1, &mABO);
+    glDeleteProgram(mLineProgram);
+    glDeleteProgram(mMarkerProgram);
+    CheckGL("End plot_collection_impl::~plot_collection_impl");
+}
+
+void plot_collection_impl::setMarkerSize(const float pMarkerSize)
+{
+    mMarkerSize = pMarkerSize;
+    ++mVersion;
+}
+
+void plot_collection_impl::setSeriesPoints(const uint pSeries, const uint pNumPoints)
+{
+    if (pSeries >= mNumSeries)
+        throw fg::ArgumentError("plot_collection_impl::setSeriesPoints", __LINE__, 1,
+                                "Series index out of range");
+    if (pNumPoints > mSeriesLength)
+        throw fg::ArgumentError("plot_collection_impl::setSeriesPoints", __LINE__, 2,
+                                "Series can not have more points than the collection was created with");
+    mCounts[pSeries] = pNumPoints;
+    ++mVersion;
+}
+
+void plot_collection_impl::setSeriesColor(const uint pSeries,
+                                          const float pRed, const float pGreen,
+                                          const float pBlue, const float pAlpha)
+{
+    CheckGL("Begin plot_collection_impl::setSeriesColor");
+    if (pSeries >= mNumSeries)
+        throw fg::ArgumentError("plot_collection_impl::setSeriesColor", __LINE__, 1,
+                                "Series index out of range");
+
+    const float rgb[3] = {clampTo01(pRed), clampTo01(pGreen), clampTo01(pBlue)};
+    const float alpha  = clampTo01(pAlpha);
+
+    glBindBuffer(GL_TEXTURE_BUFFER, mCBO);
+    glBufferSubData(GL_TEXTURE_BUFFER, 3 * pSeries * sizeof(float), sizeof(rgb), rgb);
+    glBindBuffer(GL_TEXTURE_BUFFER, mABO);
+    glBufferSubData(GL_TEXTURE_BUFFER, pSeries * sizeof(float), sizeof(float), &alpha);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    if (alpha < 1.0f)
+        mIsPVAOn = true;
+    ++mVersion;
+    CheckGL("End plot_collection_impl::setSeriesColor");
+}
+
+void plot_collection_impl::render(const int pWindowId,
+                                  const int pX, const int pY, const int pVPW, const int pVPH,
+                                  const glm::mat4& pView)
+{
+    CheckGL("Begin plot_collection_impl::render");
+    ProfileScope scope(FG_STAT_RENDERABLE, this, mLegend);
+    FG_TRACE_GPU_SCOPE("plot_collection_impl::render");
+    if (mIsPVAOn) {
+        glDepthMask(GL_FALSE);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    glm::mat4 viewModelMatrix = (mDimension == 2 ? plot2dTransform(pView, mRange)
+                                                 : plotTransform(pView, mRange));
+
+    if (mPlotType == FG_PLOT_LINE) {
+        glUseProgram(mLineProgram);
+
+        setSeriesUniforms(mLineMatIndex, mLineLengthIndex, mLineColorsIndex,
+                          mLineAlphasIndex, viewModelMatrix);
+        glUniform1i(mLinePVCOnIndex, GL_TRUE);
+        glUniform1i(mLinePVAOnIndex, mIsPVAOn);
+        if (mDimension == 3)
+            glUniform2fv(mLineRangeIndex, 3, mRange);
+
+        bindResources(pWindowId);
+        glMultiDrawArrays(GL_LINE_STRIP, mFirsts.data(), mCounts.data(), mNumSeries);
+        countDrawCall();
+        unbindResources();
+
+        glUseProgram(0);
+    }
+
+    if (mMarkerType != FG_MARKER_NONE) {
+        glEnable(GL_PROGRAM_POINT_SIZE);
+        glUseProgram(mMarkerProgram);
+
+        setSeriesUniforms(mMarkerMatIndex, mMarkerLengthIndex, mMarkerColorsIndex,
+                          mMarkerAlphasIndex, viewModelMatrix);
+        glUniform1i(mMarkerPVCOnIndex, GL_TRUE);
+        glUniform1i(mMarkerPVAOnIndex, mIsPVAOn);
+        glUniform1i(mMarkerTypeIndex, mMarkerType);
+        glUniform1f(mMarkerPSizeIndex, mMarkerSize);
+
+        bindResources(pWindowId);
+        glMultiDrawArrays(GL_POINTS, mFirsts.data(), mCounts.data(), mNumSeries);
+        countDrawCall();
+        unbindResources();
+
+        glUseProgram(0);
+        glDisable(GL_PROGRAM_POINT_SIZE);
+    }
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    if (mIsPVAOn) {
+        glDisable(GL_BLEND);
+        glDepthMask(GL_TRUE);
+    }
+    CheckGL("End plot_collection_impl::render");
+}
+
+}
@@ -0,0 +1,101 @@
+/*******************************************************
+* Copyright (c) 2015-2019, ArrayFire
+* All rights reserved.
+*
+* This file is distributed under 3-clause BSD license.
+* The complete license agreement can be obtained at:
+* http://arrayfire.com/licenses/BSD-3-Clause
+********************************************************/
+
+#pragma once
+
+#include <fg/defines.h>
+#include <common.hpp>
+
+#include <glm/glm.hpp>
+
+#include <map>
+#include <vector>
+
+namespace opengl
+{
+
+/* Many plots of the same kind drawn as a single renderable
+ *
+ * Vertices of all series live in one buffer, series i takes the points
+ * [i*mSeriesLength, i*mSeriesLength + mCounts[i]). Colors and alpha values
+ * are given per series, three floats and one float respectively, and are
+ * read by the vertex shader from buffer textures. Lines and markers take
+ * one glMultiDrawArrays call each, hence the cost of a frame on the CPU
+ * does not depend on the number of series.
+ */
+class plot_collection_impl : public AbstractRenderable {
+    private:
+        GLuint    mDimension;
+        GLfloat   mMarkerSize;
+        GLuint    mNumSeries;
+        GLuint    mSeriesLength;
+        fg::dtype mDataType;
+        GLenum    mGLType;
+        fg::MarkerType mMarkerType;
+        fg::PlotType   mPlotType;
+        /* arguments of glMultiDrawArrays */
+        std::vector<GLint>   mFirsts;
+        std::vector<GLsizei> mCounts;
+        /* OpenGL Objects */
+        GLuint    mLineProgram;
+        GLuint    mMarkerProgram;
+        GLuint    mColorTex;
+        GLuint    mAlphaTex;
+        /* shader variable index locations */
+        GLuint    mLineMatIndex;
+        GLuint    mLineLengthIndex;
+        GLuint    mLineColorsIndex;
+        GLuint    mLineAlphasIndex;
+        GLuint    mLinePVCOnIndex;
+        GLuint    mLinePVAOnIndex;
+        GLuint    mLineRangeIndex;
+        GLuint    mLinePointIndex;
+
+        GLuint    mMarkerMatIndex;
+        GLuint    mMarkerLengthIndex;
+        GLuint    mMarkerColorsIndex;
+        GLuint    mMarkerAlphasIndex;
+        GLuint    mMarkerPVCOnIndex;
+        GLuint    mMarkerPVAOnIndex;
+        GLuint    mMarkerTypeIndex;
+        GLuint    mMarkerPSizeIndex;
+
+        std::map<int, GLuint> mVAOMap;
+
+        void bindResources(const int pWindowId);
+        void unbindResources() const;
+
+        void setSeriesUniforms(const GLuint pMatIndex, const GLuint pLengthIndex,
+                               const GLuint pColorsIndex, const GLuint pAlphasIndex,
+                               const glm::mat4& pTransform);
+
+    public:
+        plot_collection_impl(const uint pNumSeries, const uint pNumPoints,
+                             const fg::dtype pDataType, const fg::ChartType pChartType,
+                             const fg::PlotType pPlotType, const fg::MarkerType pMarkerType);
+        ~plot_collection_impl();
+
+        uint numSeries() const { return mNumSeries; }
+        uint seriesLength() const { return mSeriesLength; }
+
+        void setMarkerSize(const float pMarkerSize);
+
+        /* set number of points drawn from series pSeries */
+        void setSeriesPoints(const uint pSeries, const uint pNumPoints);
+
+        void setSeriesColor(const uint pSeries,
+                            const float pRed, const float pGreen,
+                            const float pBlue, const float pAlpha);
+
+        void render(const int pWindowId,
+                    const int pX, const int pY, const int pVPW, const int pVPH,
+                    const glm::mat4 &pView) override;
+};
+
+}
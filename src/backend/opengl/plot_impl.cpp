@@ -9,50 +9,111 @@
 
 #include <err_opengl.hpp>
 #include <plot_impl.hpp>
+#include <profiler_impl.hpp>
+#include <trace_impl.hpp>
 #include <shader_headers/marker2d_vs.hpp>
 #include <shader_headers/marker_fs.hpp>
-#include <shader_headers/histogram_fs.hpp>
+#include <shader_headers/density_fs.hpp>
+#include <shader_headers/line_vs.hpp>
+#include <shader_headers/line_fs.hpp>
 #include <shader_headers/plot3_vs.hpp>
-#include <shader_headers/plot3_fs.hpp>
+#include <shader_headers/relative_points_vs.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 
 using namespace std;
 
 namespace opengl
 {
 
+int plot_impl::vaoKey(const int pWindowId) const
+{
+    return (pWindowId << 1) | (mIsInterleaved ? 1 : 0);
+}
+
+void plot_impl::deleteVertexArrays()
+{
+    std::map<int, GLuint>* maps[] = {&mVAOMap, &mSegmentVAOMap, &mJoinVAOMap, &mRelativeVAOMap};
+    for (std::map<int, GLuint>* vaoMap : maps) {
+        for (auto it = vaoMap->begin(); it!=vaoMap->end(); ++it) {
+            GLuint vao = it->second;
+            glDeleteVertexArrays(1, &vao);
+        }
+        vaoMap->clear();
+    }
+}
+
+void plot_impl::deleteVertexArrays(const int pWindowId)
+{
+    /* vertex arrays aren't shared between contexts, only those of
+     * the window whose context is current can be deleted */
+    const int keys[] = {pWindowId << 1, (pWindowId << 1) | 1};
+    std::map<int, GLuint>* maps[] = {&mVAOMap, &mSegmentVAOMap, &mJoinVAOMap, &mRelativeVAOMap};
+    for (std::map<int, GLuint>* vaoMap : maps) {
+        for (const int key : keys) {
+            auto it = vaoMap->find(key);
+            if (it == vaoMap->end())
+                continue;
+            GLuint vao = it->second;
+            glDeleteVertexArrays(1, &vao);
+            vaoMap->erase(it);
+        }
+    }
+}
+
 void plot_impl::bindResources(const int pWindowId)
 {
-    if (mVAOMap.find(pWindowId) == mVAOMap.end()) {
+    const int key = vaoKey(pWindowId);
+
+    if (mVAOMap.find(key) == mVAOMap.end()) {
         GLuint vao = 0;
         /* create a vertex array object
          * with appropriate bindings */
         glGenVertexArrays(1, &vao);
         glBindVertexArray(vao);
         // attach vertices
-        glEnableVertexAttribArray(mPlotPointIndex);
-        glBindBuffer(GL_ARRAY_BUFFER, mVBO);
-        glVertexAttribPointer(mPlotPointIndex, mDimension, mGLType, GL_FALSE, 0, 0);
-        // attach colors
-        glEnableVertexAttribArray(mPlotColorIndex);
-        glBindBuffer(GL_ARRAY_BUFFER, mCBO);
-        glVertexAttribPointer(mPlotColorIndex, 3, GL_FLOAT, GL_FALSE, 0, 0);
-        // attach alphas
-        glEnableVertexAttribArray(mPlotAlphaIndex);
-        glBindBuffer(GL_ARRAY_BUFFER, mABO);
-        glVertexAttribPointer(mPlotAlphaIndex, 1, GL_FLOAT, GL_FALSE, 0, 0);
-        // attach radii
+        glEnableVertexAttribArray(mMarkerPointIndex);
+        glBindBuffer(GL_ARRAY_BUFFER, pointBuffer());
+        glVertexAttribPointer(mMarkerPointIndex, mDimension, pointType(), isNormalized(mDataType),
+                              pointStride(), (void*)pointOffset());
+        glEnableVertexAttribArray(mMarkerColorIndex);
+        glEnableVertexAttribArray(mMarkerAlphaIndex);
         glEnableVertexAttribArray(mMarkerRadiiIndex);
-        glBindBuffer(GL_ARRAY_BUFFER, mRBO);
-        glVertexAttribPointer(mMarkerRadiiIndex, 1, GL_FLOAT, GL_FALSE, 0, 0);
+        if (mIsInterleaved) {
+            /* rgba8 color follows the position, radius follows the color */
+            const size_t colorOffset = mInterleavedStride - 4 - sizeof(float);
+            glBindBuffer(GL_ARRAY_BUFFER, mInterleavedVBO);
+            glVertexAttribPointer(mMarkerColorIndex, 3, GL_UNSIGNED_BYTE, GL_TRUE,
+                                  mInterleavedStride, (void*)colorOffset);
+            glVertexAttribPointer(mMarkerAlphaIndex, 1, GL_UNSIGNED_BYTE, GL_TRUE,
+                                  mInterleavedStride, (void*)(colorOffset + 3));
+            glVertexAttribPointer(mMarkerRadiiIndex, 1, GL_FLOAT, GL_FALSE,
+                                  mInterleavedStride, (void*)(colorOffset + 4));
+        } else {
+            // attach colors
+            glBindBuffer(GL_ARRAY_BUFFER, mCBO);
+            glVertexAttribPointer(mMarkerColorIndex, 3, GL_FLOAT, GL_FALSE, 0,
+                                  (void*)offset(FG_COLOR_BUFFER));
+            // attach alphas
+            glBindBuffer(GL_ARRAY_BUFFER, mABO);
+            glVertexAttribPointer(mMarkerAlphaIndex, 1, GL_FLOAT, GL_FALSE, 0,
+                                  (void*)offset(FG_ALPHA_BUFFER));
+            // attach radii
+            glBindBuffer(GL_ARRAY_BUFFER, mRBO);
+            glVertexAttribPointer(mMarkerRadiiIndex, 1, GL_FLOAT, GL_FALSE, 0,
+                                  (void*)offset(FG_RADIUS_BUFFER));
+        }
         glBindVertexArray(0);
         /* store the vertex array object corresponding to
          * the window instance in the map */
-        mVAOMap[pWindowId] = vao;
+        mVAOMap[key] = vao;
     }
 
-    glBindVertexArray(mVAOMap[pWindowId]);
+    glBindVertexArray(mVAOMap[key]);
 }
 
 void plot_impl::unbindResources() const
@@ -60,64 +121,255 @@ void plot_impl::unbindResources() const
     glBindVertexArray(0);
 }
 
-glm::mat4 plot_impl::computeTransformMat(const glm::mat4 pView)
+void plot_impl::bindLineResources(const int pWindowId, const bool pJoin)
+{
+    std::map<int, GLuint>& vaoMap = (pJoin ? mJoinVAOMap : mSegmentVAOMap);
+    const int key = vaoKey(pWindowId);
+
+    if (vaoMap.find(key) == vaoMap.end()) {
+        const GLsizei stride = pointStride();
+        const size_t  start  = pointOffset();
+        const int nPoints    = (pJoin ? 3 : 2);
+        GLuint vao = 0;
+        /* instance i reads points i, i+1 and, for joins, i+2 */
+        glGenVertexArrays(1, &vao);
+        glBindVertexArray(vao);
+        // attach vertices
+        glBindBuffer(GL_ARRAY_BUFFER, pointBuffer());
+        for (int i = 0; i < nPoints; ++i) {
+            glEnableVertexAttribArray(mPlotPointIndex[i]);
+            glVertexAttribPointer(mPlotPointIndex[i], mDimension, pointType(), isNormalized(mDataType),
+                                  stride, (void*)(start + i * stride));
+            glVertexAttribDivisor(mPlotPointIndex[i], 1);
+        }
+        if (mIsInterleaved) {
+            const size_t colorOffset = mInterleavedStride - 4 - sizeof(float);
+            glBindBuffer(GL_ARRAY_BUFFER, mInterleavedVBO);
+            for (int i = 0; i < 2; ++i) {
+                const size_t offset = colorOffset + i * mInterleavedStride;
+                glEnableVertexAttribArray(mPlotColorIndex[i]);
+                glVertexAttribPointer(mPlotColorIndex[i], 3, GL_UNSIGNED_BYTE, GL_TRUE,
+                                      mInterleavedStride, (void*)offset);
+                glVertexAttribDivisor(mPlotColorIndex[i], 1);
+                glEnableVertexAttribArray(mPlotAlphaIndex[i]);
+                glVertexAttribPointer(mPlotAlphaIndex[i], 1, GL_UNSIGNED_BYTE, GL_TRUE,
+                                      mInterleavedStride, (void*)(offset + 3));
+                glVertexAttribDivisor(mPlotAlphaIndex[i], 1);
+            }
+        } else {
+            // attach colors
+            glBindBuffer(GL_ARRAY_BUFFER, mCBO);
+            for (int i = 0; i < 2; ++i) {
+                glEnableVertexAttribArray(mPlotColorIndex[i]);
+                glVertexAttribPointer(mPlotColorIndex[i], 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float),
+                                      (void*)(offset(FG_COLOR_BUFFER) + i * 3 * sizeof(float)));
+                glVertexAttribDivisor(mPlotColorIndex[i], 1);
+            }
+            // attach alphas
+            glBindBuffer(GL_ARRAY_BUFFER, mABO);
+            for (int i = 0; i < 2; ++i) {
+                glEnableVertexAttribArray(mPlotAlphaIndex[i]);
+                glVertexAttribPointer(mPlotAlphaIndex[i], 1, GL_FLOAT, GL_FALSE, sizeof(float),
+                                      (void*)(offset(FG_ALPHA_BUFFER) + i * sizeof(float)));
+                glVertexAttribDivisor(mPlotAlphaIndex[i], 1);
+            }
+        }
+        glBindVertexArray(0);
+        vaoMap[key] = vao;
+    }
+
+    glBindVertexArray(vaoMap[key]);
+}
+
+GLuint plot_impl::pointBuffer() const
+{
+    if (mDataType == fg::f64)
+        return mRelativeVBO;
+    return mIsInterleaved ? mInterleavedVBO : mVBO;
+}
+
+GLenum plot_impl::pointType() const
+{
+    return mDataType == fg::f64 ? GL_FLOAT : mGLType;
+}
+
+GLsizei plot_impl::pointStride() const
+{
+    /* relative points are tightly packed floats */
+    if (mDataType == fg::f64)
+        return (GLsizei)(mDimension * sizeof(float));
+    if (mIsInterleaved)
+        return mInterleavedStride;
+    return (GLsizei)(mNumPoints > 0 ? mVBOSize / mNumPoints : 0);
+}
+
+size_t plot_impl::pointOffset() const
+{
+    if (mDataType == fg::f64 || mIsInterleaved)
+        return 0;
+    return offset(FG_VERTEX_BUFFER);
+}
+
+const GLfloat* plot_impl::drawRange() const
+{
+    return mDataType == fg::f64 ? mRelativeRange : mRange;
+}
+
+/* Split a double into three floats holding the top 24, next 24 and last 5
+ * bits of its significand, the same way relative_points_vs splits points */
+static void splitDouble(GLfloat pParts[3], const GLdouble pValue)
+{
+    uint64_t bits;
+    memcpy(&bits, &pValue, sizeof(bits));
+    const int exponent = int((bits >> 52) & 0x7FF) - 1075;
+    if (exponent == -1075) {
+        pParts[0] = pParts[1] = pParts[2] = 0.0f;
+        return;
+    }
+    const uint64_t significand = (bits & ((1ull << 52) - 1)) | (1ull << 52);
+    const float    sign        = (bits >> 63) ? -1.0f : 1.0f;
+    pParts[0] = sign * std::ldexp((float)(significand >> 29), exponent + 29);
+    pParts[1] = sign * std::ldexp((float)((significand >> 5) & 0xFFFFFF), exponent + 5);
+    pParts[2] = sign * std::ldexp((float)(significand & 0x1F), exponent);
+}
+
+void plot_impl::updateRelativePoints(const int pWindowId)
+{
+    /* relative points are exact to float precision of their distance
+     * from origin, keeping origin within a few view spans of the center
+     * keeps the error far below a pixel at any zoom level */
+    for (GLuint i = 0; i < 3; ++i) {
+        const GLdouble lo     = mLimits[2*i];
+        const GLdouble hi     = mLimits[2*i+1];
+        const GLdouble center = (lo + hi) / 2.0;
+        if (i < mDimension && !(std::abs(center - mOrigin[i]) <= 4.0 * std::abs(hi - lo))) {
+            mOrigin[i]     = center;
+            mRelativeDirty = true;
+        }
+        const GLdouble origin = (i < mDimension ? mOrigin[i] : 0.0);
+        mRelativeRange[2*i]   = (GLfloat)(lo - origin);
+        mRelativeRange[2*i+1] = (GLfloat)(hi - origin);
+    }
+
+    if (!mRelativeDirty)
+        return;
+
+    CheckGL("Begin plot_impl::updateRelativePoints");
+    FG_TRACE_GPU_SCOPE("plot_impl::updateRelativePoints");
+    const int key = vaoKey(pWindowId);
+    if (mRelativeVAOMap.find(key) == mRelativeVAOMap.end()) {
+        const GLsizei stride = (mIsInterleaved ? mInterleavedStride
+                                               : (GLsizei)(mDimension * sizeof(double)));
+        const size_t  start  = (mIsInterleaved ? 0 : offset(FG_VERTEX_BUFFER));
+        GLuint vao = 0;
+        glGenVertexArrays(1, &vao);
+        glBindVertexArray(vao);
+        /* doubles are read as their 32 bit words */
+        glBindBuffer(GL_ARRAY_BUFFER, mIsInterleaved ? mInterleavedVBO : mVBO);
+        glEnableVertexAttribArray(mRelativeXYIndex);
+        glVertexAttribIPointer(mRelativeXYIndex, 4, GL_UNSIGNED_INT, stride, (void*)start);
+        if (mDimension == 3) {
+            glEnableVertexAttribArray(mRelativeZIndex);
+            glVertexAttribIPointer(mRelativeZIndex, 2, GL_UNSIGNED_INT, stride,
+                                   (void*)(start + 2 * sizeof(double)));
+        }
+        glBindVertexArray(0);
+        mRelativeVAOMap[key] = vao;
+    }
+
+    GLfloat origin[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    for (GLuint i = 0; i < mDimension; ++i)
+        splitDouble(origin + 3*i, mOrigin[i]);
+
+    glUseProgram(mRelativeProgram);
+    glUniform3fv(mRelativeOriginIndex, 3, origin);
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, mRelativeVBO);
+    glBindVertexArray(mRelativeVAOMap[key]);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, mNumPoints);
+    glEndTransformFeedback();
+    countDrawCall();
+    glBindVertexArray(0);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glDisable(GL_RASTERIZER_DISCARD);
+    glUseProgram(0);
+
+    mRelativeDirty = false;
+    CheckGL("End plot_impl::updateRelativePoints");
+}
+
+glm::mat4 plotTransform(const glm::mat4& pView, const float pRange[6])
 {
     static const glm::mat4 MODEL = glm::rotate(glm::mat4(1.0f), -glm::radians(90.f), glm::vec3(0,1,0)) *
                                    glm::rotate(glm::mat4(1.0f), -glm::radians(90.f), glm::vec3(1,0,0));
 
-    float xRange = mRange[1] - mRange[0];
-    float yRange = mRange[3] - mRange[2];
-    float zRange = mRange[5] - mRange[4];
+    float xRange = pRange[1] - pRange[0];
+    float yRange = pRange[3] - pRange[2];
+    float zRange = pRange[5] - pRange[4];
 
     float xDataScale = std::abs(xRange) < 1.0e-3 ? 0.0f : 2/(xRange);
     float yDataScale = std::abs(yRange) < 1.0e-3 ? 0.0f : 2/(yRange);
     float zDataScale = std::abs(zRange) < 1.0e-3 ? 0.0f : 2/(zRange);
 
-    float xDataOffset = (-mRange[0] * xDataScale);
-    float yDataOffset = (-mRange[2] * yDataScale);
-    float zDataOffset = (-mRange[4] * zDataScale);
+    float xDataOffset = (-pRange[0] * xDataScale);
+    float yDataOffset = (-pRange[2] * yDataScale);
+    float zDataOffset = (-pRange[4] * zDataScale);
 
     glm::vec3 scaleVector(xDataScale, -1.0f * yDataScale, zDataScale);
 
-    glm::vec3 shiftVector(-(mRange[0]+mRange[1])/2.0f,
-                          -(mRange[2]+mRange[3])/2.0f,
-                          -(mRange[4]+mRange[5])/2.0f);
+    glm::vec3 shiftVector(-(pRange[0]+pRange[1])/2.0f,
+                          -(pRange[2]+pRange[3])/2.0f,
+                          -(pRange[4]+pRange[5])/2.0f);
     shiftVector += glm::vec3(-1 + xDataOffset, -1 + yDataOffset, -1 + zDataOffset);
 
     return pView * glm::translate(glm::scale(MODEL, scaleVector), shiftVector);
 }
 
+glm::mat4 plot_impl::computeTransformMat(const glm::mat4 pView)
+{
+    return plotTransform(pView, drawRange());
+}
+
 void plot_impl::bindDimSpecificUniforms()
 {
-    glUniform2fv(mPlotRangeIndex, 3, mRange);
+    glUniform2fv(mPlotRangeIndex, 3, drawRange());
 }
 
 plot_impl::plot_impl(const uint pNumPoints, const fg::dtype pDataType,
                      const fg::PlotType pPlotType, const fg::MarkerType pMarkerType, const int pD)
-    : mDimension(pD), mMarkerSize(12), mNumPoints(pNumPoints), mDataType(pDataType),
+    : mDimension(pD), mMarkerSize(12), mLineWidth(1), mLineJoin(FG_LINE_JOIN_MITER),
+    mDensityScale(FG_DENSITY_NONE), mNumPoints(pNumPoints), mDataType(pDataType),
     mGLType(dtype2gl(mDataType)), mMarkerType(pMarkerType), mPlotType(pPlotType), mIsPVROn(false),
-    mPlotProgram(-1), mMarkerProgram(-1), mRBO(-1), mPlotMatIndex(-1), mPlotPVCOnIndex(-1),
-    mPlotPVAOnIndex(-1), mPlotUColorIndex(-1), mPlotRangeIndex(-1), mPlotPointIndex(-1),
-    mPlotColorIndex(-1), mPlotAlphaIndex(-1), mMarkerPVCOnIndex(-1), mMarkerPVAOnIndex(-1),
+    mPlotProgram(-1), mMarkerProgram(-1), mRBO(-1),
+    mDensityProgram(0), mCMapTex(0), mCMapLen(0), mRelativeVBO(0), mRelativeProgram(0),
+    mRelativeDirty(true), mInterleavedVBO(0), mInterleavedSize(0), mInterleavedStride(0),
+    mIsInterleaved(false), mPlotMatIndex(-1), mPlotPVCOnIndex(-1),
+    mPlotPVAOnIndex(-1), mPlotUColorIndex(-1), mPlotRangeIndex(-1), mPlotViewportIndex(-1),
+    mPlotWidthIndex(-1), mPlotRoundIndex(-1), mPlotJoinIndex(-1), mPlotHeightIndex(-1),
+    mMarkerPVCOnIndex(-1), mMarkerPVAOnIndex(-1),
     mMarkerTypeIndex(-1), mMarkerColIndex(-1), mMarkerMatIndex(-1), mMarkerPointIndex(-1),
-    mMarkerColorIndex(-1), mMarkerAlphaIndex(-1), mMarkerRadiiIndex(-1)
+    mMarkerColorIndex(-1), mMarkerAlphaIndex(-1), mMarkerRadiiIndex(-1),
+    mDensityMatIndex(-1), mDensityPVROnIndex(-1), mDensityPSizeIndex(-1), mDensityRangeIndex(-1),
+    mRelativeOriginIndex(-1), mRelativeXYIndex(-1), mRelativeZIndex(-1)
 {
     CheckGL("Begin plot_impl::plot_impl");
+    /* NaN, so that the first render picks an origin */
+    mOrigin[0] = mOrigin[1] = mOrigin[2] = std::numeric_limits<GLdouble>::quiet_NaN();
+    mBlocks[0] = mBlocks[1] = mBlocks[2] = mBlocks[3] = NULL;
     mIsPVCOn = false;
     mIsPVAOn = false;
 
     setColor(0, 1, 0, 1);
     mLegend  = std::string("");
 
+    mPlotProgram = initShaders(glsl::line_vs.c_str(), glsl::line_fs.c_str());
+
     if (mDimension==2) {
-        mPlotProgram     = initShaders(glsl::marker2d_vs.c_str(), glsl::histogram_fs.c_str());
         mMarkerProgram   = initShaders(glsl::marker2d_vs.c_str(), glsl::marker_fs.c_str());
-        mPlotUColorIndex = glGetUniformLocation(mPlotProgram, "barColor");
         mVBOSize = 2*mNumPoints;
     } else {
-        mPlotProgram     = initShaders(glsl::plot3_vs.c_str(), glsl::plot3_fs.c_str());
         mMarkerProgram   = initShaders(glsl::plot3_vs.c_str(), glsl::marker_fs.c_str());
-        mPlotRangeIndex  = glGetUniformLocation(mPlotProgram, "minmaxs");
         mVBOSize = 3*mNumPoints;
     }
 
@@ -128,9 +380,20 @@ plot_impl::plot_impl(const uint pNumPoints, const fg::dtype pDataType,
     mPlotMatIndex    = glGetUniformLocation(mPlotProgram, "transform");
     mPlotPVCOnIndex  = glGetUniformLocation(mPlotProgram, "isPVCOn");
     mPlotPVAOnIndex  = glGetUniformLocation(mPlotProgram, "isPVAOn");
-    mPlotPointIndex  = glGetAttribLocation (mPlotProgram, "point");
-    mPlotColorIndex  = glGetAttribLocation (mPlotProgram, "color");
-    mPlotAlphaIndex  = glGetAttribLocation (mPlotProgram, "alpha");
+    mPlotUColorIndex = glGetUniformLocation(mPlotProgram, "lineColor");
+    mPlotRangeIndex  = glGetUniformLocation(mPlotProgram, "minmaxs");
+    mPlotViewportIndex = glGetUniformLocation(mPlotProgram, "viewport");
+    mPlotWidthIndex  = glGetUniformLocation(mPlotProgram, "lineWidth");
+    mPlotRoundIndex  = glGetUniformLocation(mPlotProgram, "isRound");
+    mPlotJoinIndex   = glGetUniformLocation(mPlotProgram, "isJoin");
+    mPlotHeightIndex = glGetUniformLocation(mPlotProgram, "isHeightColored");
+    mPlotPointIndex[0] = glGetAttribLocation(mPlotProgram, "p0");
+    mPlotPointIndex[1] = glGetAttribLocation(mPlotProgram, "p1");
+    mPlotPointIndex[2] = glGetAttribLocation(mPlotProgram, "p2");
+    mPlotColorIndex[0] = glGetAttribLocation(mPlotProgram, "c0");
+    mPlotColorIndex[1] = glGetAttribLocation(mPlotProgram, "c1");
+    mPlotAlphaIndex[0] = glGetAttribLocation(mPlotProgram, "a0");
+    mPlotAlphaIndex[1] = glGetAttribLocation(mPlotProgram, "a1");
 
     mMarkerMatIndex   = glGetUniformLocation(mMarkerProgram, "transform");
     mMarkerPVCOnIndex = glGetUniformLocation(mMarkerProgram, "isPVCOn");
@@ -145,10 +408,6 @@ plot_impl::plot_impl(const uint pNumPoints, const fg::dtype pDataType,
     mMarkerRadiiIndex = glGetAttribLocation (mMarkerProgram, "pointsize");
 
 #define PLOT_CREATE_BUFFERS(type)   \
-        mVBO = createBuffer<type>(GL_ARRAY_BUFFER, mVBOSize, NULL, GL_DYNAMIC_DRAW);    \
-        mCBO = createBuffer<float>(GL_ARRAY_BUFFER, mCBOSize, NULL, GL_DYNAMIC_DRAW);   \
-        mABO = createBuffer<float>(GL_ARRAY_BUFFER, mABOSize, NULL, GL_DYNAMIC_DRAW);   \
-        mRBO = createBuffer<float>(GL_ARRAY_BUFFER, mRBOSize, NULL, GL_DYNAMIC_DRAW);   \
         mVBOSize *= sizeof(type);   \
         mCBOSize *= sizeof(float);  \
         mABOSize *= sizeof(float);  \
@@ -160,31 +419,147 @@ plot_impl::plot_impl(const uint pNumPoints, const fg::dtype pDataType,
             case GL_UNSIGNED_INT   : PLOT_CREATE_BUFFERS(uint)  ; break;
             case GL_SHORT          : PLOT_CREATE_BUFFERS(short) ; break;
             case GL_UNSIGNED_SHORT : PLOT_CREATE_BUFFERS(ushort); break;
-            case GL_UNSIGNED_BYTE  : PLOT_CREATE_BUFFERS(float) ; break;
-            default: fg::TypeError("plot_impl::plot_impl", __LINE__, 1, mDataType);
+            case GL_HALF_FLOAT     : PLOT_CREATE_BUFFERS(ushort); break;
+            case GL_BYTE           : PLOT_CREATE_BUFFERS(char)  ; break;
+            case GL_UNSIGNED_BYTE  : PLOT_CREATE_BUFFERS(uchar) ; break;
+            case GL_DOUBLE         : PLOT_CREATE_BUFFERS(double); break;
+            default: throw fg::TypeError("plot_impl::plot_impl", __LINE__, 1, mDataType);
         }
 #undef PLOT_CREATE_BUFFERS
+
+        buffer_arena_impl& arena = buffer_arena_impl::instance();
+        if (arena.enabled()) {
+            mBlocks[0] = arena.allocate(mVBOSize, &mVBO);
+            mBlocks[1] = arena.allocate(mCBOSize, &mCBO);
+            mBlocks[2] = arena.allocate(mABOSize, &mABO);
+            mBlocks[3] = arena.allocate(mRBOSize, &mRBO);
+        } else {
+            mVBO = createBuffer<uchar>(GL_ARRAY_BUFFER, mVBOSize, NULL, GL_DYNAMIC_DRAW);
+            mCBO = createBuffer<uchar>(GL_ARRAY_BUFFER, mCBOSize, NULL, GL_DYNAMIC_DRAW);
+            mABO = createBuffer<uchar>(GL_ARRAY_BUFFER, mABOSize, NULL, GL_DYNAMIC_DRAW);
+            mRBO = createBuffer<uchar>(GL_ARRAY_BUFFER, mRBOSize, NULL, GL_DYNAMIC_DRAW);
+        }
+
+        /* positions of the interleaved layout are padded to keep the
+         * rgba8 color and float radius that follow them four byte aligned */
+        mInterleavedStride = (GLsizei)(((mVBOSize / std::max(mNumPoints, 1u) + 3) & ~size_t(3))
+                                       + 4 + sizeof(float));
+        mInterleavedSize   = mInterleavedStride * mNumPoints;
+
+        if (mDataType == fg::f64) {
+            mRelativeProgram = initFeedbackShader(mDimension == 3 ? addShaderDefines(glsl::relative_points_vs,
+                                                                                     "#define DIM3").c_str()
+                                                                  : glsl::relative_points_vs.c_str(),
+                                                  "relative");
+            mRelativeOriginIndex = glGetUniformLocation(mRelativeProgram, "origin");
+            mRelativeXYIndex     = glGetAttribLocation (mRelativeProgram, "pointXY");
+            mRelativeZIndex      = glGetAttribLocation (mRelativeProgram, "pointZ");
+            mRelativeVBO = createBuffer<float>(GL_ARRAY_BUFFER, mDimension * mNumPoints, NULL, GL_DYNAMIC_COPY);
+        }
         CheckGL("End plot_impl::plot_impl");
 }
 
 plot_impl::~plot_impl()
 {
     CheckGL("Begin plot_impl::~plot_impl");
-    for (auto it = mVAOMap.begin(); it!=mVAOMap.end(); ++it) {
-        GLuint vao = it->second;
-        glDeleteVertexArrays(1, &vao);
+    deleteVertexArrays();
+    if (mRelativeVBO)
+        glDeleteBuffers(1, &mRelativeVBO);
+    if (mRelativeProgram)
+        glDeleteProgram(mRelativeProgram);
+    if (mInterleavedVBO)
+        glDeleteBuffers(1, &mInterleavedVBO);
+    if (mBlocks[0]) {
+        for (int i = 0; i < 4; ++i)
+            buffer_arena_impl::instance().release(mBlocks[i]);
+    } else {
+        glDeleteBuffers(1, &mVBO);
+        glDeleteBuffers(1, &mCBO);
+        glDeleteBuffers(1, &mABO);
+        glDeleteBuffers(1, &mRBO);
     }
-    glDeleteBuffers(1, &mVBO);
-    glDeleteBuffers(1, &mCBO);
-    glDeleteBuffers(1, &mABO);
     glDeleteProgram(mPlotProgram);
     glDeleteProgram(mMarkerProgram);
+    if (mDensityProgram)
+        glDeleteProgram(mDensityProgram);
+    mDensity.reset();
     CheckGL("End plot_impl::~plot_impl");
 }
 
 void plot_impl::setMarkerSize(const float pMarkerSize)
 {
     mMarkerSize = pMarkerSize;
+    ++mVersion;
+}
+
+void plot_impl::setLineWidth(const float pLineWidth)
+{
+    if (pLineWidth <= 0.0f)
+        throw fg::ArgumentError("plot_impl::setLineWidth", __LINE__, 1,
+                                "Line width has to be positive");
+    mLineWidth = pLineWidth;
+    ++mVersion;
+}
+
+void plot_impl::setLineJoin(const fg::LineJoin pLineJoin)
+{
+    mLineJoin = pLineJoin;
+    ++mVersion;
+}
+
+void plot_impl::setDensity(const fg::DensityScale pScale)
+{
+    mDensityScale = pScale;
+    ++mVersion;
+}
+
+void plot_impl::markDirty()
+{
+    mRelativeDirty = true;
+    AbstractRenderable::markDirty();
+}
+
+void plot_impl::setColorMapParams(const GLuint pTexture, const GLuint pLength)
+{
+    mCMapTex = pTexture;
+    mCMapLen = pLength;
+}
+
+void plot_impl::renderDensity(const int pWindowId, const glm::mat4& pTransform)
+{
+    if (!mDensity) {
+        std::string fragShader = glsl::density_fs;
+        if (mDimension == 3)
+            fragShader = addShaderDefines(fragShader, "#define BOUNDED");
+        /* same vertex shader as markers, so that
+         * their vertex arrays can be used as is */
+        mDensityProgram    = initShaders(mDimension == 2 ? glsl::marker2d_vs.c_str()
+                                                         : glsl::plot3_vs.c_str(),
+                                         fragShader.c_str());
+        mDensityMatIndex   = glGetUniformLocation(mDensityProgram, "transform");
+        mDensityPVROnIndex = glGetUniformLocation(mDensityProgram, "isPVROn");
+        mDensityPSizeIndex = glGetUniformLocation(mDensityProgram, "psize");
+        mDensityRangeIndex = glGetUniformLocation(mDensityProgram, "minmaxs");
+        mDensity.reset(new density_impl());
+    }
+
+    mDensity->begin(pWindowId);
+
+    glUseProgram(mDensityProgram);
+    glUniformMatrix4fv(mDensityMatIndex, 1, GL_FALSE, glm::value_ptr(pTransform));
+    glUniform1i(mDensityPVROnIndex, GL_FALSE);
+    glUniform1f(mDensityPSizeIndex, 1.0f);
+    if (mDimension == 3)
+        glUniform2fv(mDensityRangeIndex, 3, drawRange());
+
+    plot_impl::bindResources(pWindowId);
+    glDrawArrays(GL_POINTS, 0, mNumPoints);
+    countDrawCall();
+    plot_impl::unbindResources();
+
+    glUseProgram(0);
+
+    mDensity->end(pWindowId, mCMapTex, mCMapLen, mDensityScale == FG_DENSITY_LOG, mColor[3]);
 }
 
 GLuint plot_impl::markers()
@@ -198,35 +573,130 @@ size_t plot_impl::markersSizes() const
     return mRBOSize;
 }
 
+GLuint plot_impl::interleaved()
+{
+    if (!mIsInterleaved) {
+        CheckGL("Begin plot_impl::interleaved");
+        mInterleavedVBO = createBuffer<uchar>(GL_ARRAY_BUFFER, mInterleavedSize, NULL, GL_DYNAMIC_DRAW);
+        mIsInterleaved = true;
+        mIsPVCOn = true;
+        mIsPVAOn = true;
+        mIsPVROn = true;
+        markDirty();
+        CheckGL("End plot_impl::interleaved");
+    }
+    return mInterleavedVBO;
+}
+
+size_t plot_impl::interleavedSize() const
+{
+    return mInterleavedSize;
+}
+
+size_t plot_impl::offset(const fg::BufferKind pKind) const
+{
+    if (pKind <= FG_RADIUS_BUFFER && mBlocks[pKind])
+        return mBlocks[pKind]->mOffset;
+    return 0;
+}
+
+bool plot_impl::sharesBuffers() const
+{
+    return mBlocks[0] != NULL;
+}
+
+GLuint plot_impl::buffer(const fg::BufferKind pKind, size_t& pSize)
+{
+    if (pKind == FG_RADIUS_BUFFER) {
+        pSize = markersSizes();
+        return markers();
+    }
+    if (pKind == FG_INTERLEAVED_BUFFER) {
+        pSize = interleavedSize();
+        return interleaved();
+    }
+    return AbstractRenderable::buffer(pKind, pSize);
+}
+
 void plot_impl::render(const int pWindowId,
                        const int pX, const int pY, const int pVPW, const int pVPH,
                        const glm::mat4& pView)
 {
     CheckGL("Begin plot_impl::render");
+    ProfileScope scope(FG_STAT_RENDERABLE, this, mLegend);
+    FG_TRACE_GPU_SCOPE("plot_impl::render");
     if (mIsPVAOn) {
         glDepthMask(GL_FALSE);
         glEnable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     }
 
+    /* buffers moved by defragmentation of the arena since
+     * vertex arrays of this window were specified */
+    if (mBlocks[0]) {
+        const unsigned long long generation = buffer_arena_impl::instance().generation();
+        auto it = mArenaGenerationMap.find(pWindowId);
+        if (it == mArenaGenerationMap.end()) {
+            mArenaGenerationMap[pWindowId] = generation;
+        } else if (it->second != generation) {
+            deleteVertexArrays(pWindowId);
+            it->second = generation;
+        }
+    }
+
+    if (mDataType == fg::f64)
+        updateRelativePoints(pWindowId);
+
     glm::mat4 viewModelMatrix = this->computeTransformMat(pView);
 
-    if (mPlotType == FG_PLOT_LINE) {
+    if (mPlotType == FG_PLOT_LINE && mNumPoints > 1) {
+        /* edges of strokes are smoothed by coverage
+         * written to alpha, no multisampling needed */
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        if (!mIsPVAOn) {
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        }
+        /* quads of adjacent segments and join wedges overlap,
+         * depth writes would cut the blended edges of later ones */
+        GLboolean depthMask = GL_TRUE;
+        glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+        glDepthMask(GL_FALSE);
         glUseProgram(mPlotProgram);
 
         this->bindDimSpecificUniforms();
         glUniformMatrix4fv(mPlotMatIndex, 1, GL_FALSE, glm::value_ptr(viewModelMatrix));
         glUniform1i(mPlotPVCOnIndex, mIsPVCOn);
         glUniform1i(mPlotPVAOnIndex, mIsPVAOn);
-
-        plot_impl::bindResources(pWindowId);
-        glDrawArrays(GL_LINE_STRIP, 0, mNumPoints);
+        glUniform1i(mPlotHeightIndex, mDimension == 3);
+        glUniform2f(mPlotViewportIndex, (GLfloat)viewport[2], (GLfloat)viewport[3]);
+        glUniform1f(mPlotWidthIndex, mLineWidth);
+        glUniform1i(mPlotRoundIndex, mLineJoin == FG_LINE_JOIN_ROUND);
+
+        glUniform1i(mPlotJoinIndex, GL_FALSE);
+        plot_impl::bindLineResources(pWindowId, false);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, mNumPoints - 1);
+        countDrawCall();
+
+        /* round joins come from the round caps of segments */
+        if (mLineJoin == FG_LINE_JOIN_MITER && mNumPoints > 2) {
+            glUniform1i(mPlotJoinIndex, GL_TRUE);
+            plot_impl::bindLineResources(pWindowId, true);
+            glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, mNumPoints - 2);
+            countDrawCall();
+        }
         plot_impl::unbindResources();
 
         glUseProgram(0);
+        glDepthMask(depthMask);
+        if (!mIsPVAOn)
+            glDisable(GL_BLEND);
     }
 
-    if (mMarkerType != FG_MARKER_NONE) {
+    if (mMarkerType != FG_MARKER_NONE && mDensityScale != FG_DENSITY_NONE) {
+        renderDensity(pWindowId, viewModelMatrix);
+    } else if (mMarkerType != FG_MARKER_NONE) {
         glEnable(GL_PROGRAM_POINT_SIZE);
         glUseProgram(mMarkerProgram);
 
@@ -240,6 +710,7 @@ void plot_impl::render(const int pWindowId,
 
         plot_impl::bindResources(pWindowId);
         glDrawArrays(GL_POINTS, 0, mNumPoints);
+        countDrawCall();
         plot_impl::unbindResources();
 
         glUseProgram(0);
@@ -253,20 +724,25 @@ void plot_impl::render(const int pWindowId,
     CheckGL("End plot_impl::render");
 }
 
-glm::mat4 plot2d_impl::computeTransformMat(const glm::mat4 pView)
+glm::mat4 plot2dTransform(const glm::mat4& pView, const float pRange[6])
 {
-    float xRange = mRange[1] - mRange[0];
-    float yRange = mRange[3] - mRange[2];
+    float xRange = pRange[1] - pRange[0];
+    float yRange = pRange[3] - pRange[2];
 
     float xDataScale = std::abs(xRange) < 1.0e-3 ? 1.0f : 2/(xRange);
     float yDataScale = std::abs(yRange) < 1.0e-3 ? 1.0f : 2/(yRange);
 
-    glm::vec3 shiftVector(-(mRange[0]+mRange[1])/2.0f, -(mRange[2]+mRange[3])/2.0f, 0.0f);
+    glm::vec3 shiftVector(-(pRange[0]+pRange[1])/2.0f, -(pRange[2]+pRange[3])/2.0f, 0.0f);
     glm::vec3 scaleVector(xDataScale, yDataScale, 1);
 
     return pView * glm::translate(glm::scale(IDENTITY, scaleVector), shiftVector);
 }
 
+glm::mat4 plot2d_impl::computeTransformMat(const glm::mat4 pView)
+{
+    return plot2dTransform(pView, drawRange());
+}
+
 void plot2d_impl::bindDimSpecificUniforms()
 {
     glUniform4fv(mPlotUColorIndex, 1, mColor);
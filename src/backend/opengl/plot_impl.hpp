@@ -10,7 +10,9 @@
 #pragma once
 
 #include <fg/defines.h>
+#include <buffer_arena_impl.hpp>
 #include <common.hpp>
+#include <density_impl.hpp>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -22,10 +24,20 @@
 namespace opengl
 {
 
+/* Model view matrix that maps axes ranges of a 3d chart, given as
+ * min, max pairs of x, y and z, to the view of the chart */
+glm::mat4 plotTransform(const glm::mat4& pView, const float pRange[6]);
+
+/* Model view matrix that maps x and y axes ranges of a 2d chart */
+glm::mat4 plot2dTransform(const glm::mat4& pView, const float pRange[6]);
+
 class plot_impl : public AbstractRenderable {
     protected:
         GLuint    mDimension;
         GLfloat   mMarkerSize;
+        GLfloat   mLineWidth;
+        fg::LineJoin   mLineJoin;
+        fg::DensityScale mDensityScale;
         /* plot points characteristics */
         GLuint    mNumPoints;
         fg::dtype mDataType;
@@ -38,15 +50,47 @@ class plot_impl : public AbstractRenderable {
         GLuint    mMarkerProgram;
         GLuint    mRBO;
         size_t    mRBOSize;
+        /* markers of density mode are counted per pixel,
+         * resources are created on first use */
+        GLuint    mDensityProgram;
+        std::unique_ptr<density_impl> mDensity;
+        GLuint    mCMapTex;
+        GLuint    mCMapLen;
+        /* f64 points are converted on the GPU into floats relative to an
+         * origin near the center of the chart, which moves only when the
+         * view gets far from it. Everything else draws from mRelativeVBO */
+        GLuint    mRelativeVBO;
+        GLuint    mRelativeProgram;
+        GLdouble  mOrigin[3];
+        GLfloat   mRelativeRange[6];
+        bool      mRelativeDirty;
+        /* positions, rgba8 colors and radii of every vertex in a single
+         * buffer, which replaces the separate buffers once requested */
+        GLuint    mInterleavedVBO;
+        size_t    mInterleavedSize;
+        GLsizei   mInterleavedStride;
+        bool      mIsInterleaved;
+        /* blocks holding mVBO, mCBO, mABO and mRBO, in the order of
+         * fg::BufferKind, when the plot was created with the buffer arena
+         * enabled. Vertex arrays of a window are re-specified, while its
+         * context is current, once the arena has moved them since the
+         * generation recorded for that window */
+        buffer_arena_impl::Block* mBlocks[4];
+        std::map<int, unsigned long long> mArenaGenerationMap;
         /* shader variable index locations */
         GLuint    mPlotMatIndex;
         GLuint    mPlotPVCOnIndex;
         GLuint    mPlotPVAOnIndex;
         GLuint    mPlotUColorIndex;
         GLuint    mPlotRangeIndex;
-        GLuint    mPlotPointIndex;
-        GLuint    mPlotColorIndex;
-        GLuint    mPlotAlphaIndex;
+        GLuint    mPlotViewportIndex;
+        GLuint    mPlotWidthIndex;
+        GLuint    mPlotRoundIndex;
+        GLuint    mPlotJoinIndex;
+        GLuint    mPlotHeightIndex;
+        GLuint    mPlotPointIndex[3];
+        GLuint    mPlotColorIndex[2];
+        GLuint    mPlotAlphaIndex[2];
 
         GLuint    mMarkerPVCOnIndex;
         GLuint    mMarkerPVAOnIndex;
@@ -60,13 +104,51 @@ class plot_impl : public AbstractRenderable {
         GLuint    mMarkerAlphaIndex;
         GLuint    mMarkerRadiiIndex;
 
+        GLuint    mDensityMatIndex;
+        GLuint    mDensityPVROnIndex;
+        GLuint    mDensityPSizeIndex;
+        GLuint    mDensityRangeIndex;
+
+        GLuint    mRelativeOriginIndex;
+        GLuint    mRelativeXYIndex;
+        GLuint    mRelativeZIndex;
+
         std::map<int, GLuint> mVAOMap;
+        std::map<int, GLuint> mSegmentVAOMap;
+        std::map<int, GLuint> mJoinVAOMap;
+        std::map<int, GLuint> mRelativeVAOMap;
+
+        /* vertex arrays of either layout are kept apart, as
+         * the layout can change after they were created */
+        int vaoKey(const int pWindowId) const;
+        void deleteVertexArrays();
+        void deleteVertexArrays(const int pWindowId);
 
         /* bind and unbind helper functions
          * for rendering resources */
         void bindResources(const int pWindowId);
         void unbindResources() const;
 
+        /* Lines are drawn as one screen space quad per segment, instanced
+         * over segments with consecutive points of the vertex buffer as
+         * per instance attributes. Miter joins take a second instanced
+         * draw that fills the outer side of every inner point. */
+        void bindLineResources(const int pWindowId, const bool pJoin);
+
+        void renderDensity(const int pWindowId, const glm::mat4& pTransform);
+
+        /* buffer, type and axes ranges that drawing uses,
+         * which differ from the user's for f64 points */
+        GLuint  pointBuffer() const;
+        GLenum  pointType() const;
+        GLsizei pointStride() const;
+        size_t  pointOffset() const;
+        const GLfloat* drawRange() const;
+
+        /* moves origin if needed and converts f64 points
+         * when either they or the origin changed */
+        void updateRelativePoints(const int pWindowId);
+
         virtual glm::mat4 computeTransformMat(const glm::mat4 pView);
 
         virtual void bindDimSpecificUniforms(); // has to be called only after shaders are bound
@@ -79,9 +161,26 @@ class plot_impl : public AbstractRenderable {
 
         void setMarkerSize(const float pMarkerSize);
 
+        void setLineWidth(const float pLineWidth);
+
+        void setLineJoin(const fg::LineJoin pLineJoin);
+
+        void setDensity(const fg::DensityScale pScale);
+
+        void setColorMapParams(const GLuint pTexture, const GLuint pLength) override;
+
+        void markDirty() override;
+
         GLuint markers();
         size_t markersSizes() const;
 
+        GLuint interleaved();
+        size_t interleavedSize() const;
+
+        GLuint buffer(const fg::BufferKind pKind, size_t& pSize) override;
+        size_t offset(const fg::BufferKind pKind) const override;
+        bool sharesBuffers() const override;
+
         virtual void render(const int pWindowId,
                             const int pX, const int pY, const int pVPW, const int pVPH,
                             const glm::mat4 &pView);
@@ -0,0 +1,269 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <common.hpp>
+#include <profiler_impl.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace opengl
+{
+
+static thread_local profiler_impl* currentProfiler = nullptr;
+
+const size_t profiler_impl::FRAMES_IN_FLIGHT;
+
+profiler_impl::profiler_impl()
+    : mEnabled(false), mCurrent(0), mRecording(false), mOpen(-1),
+      mFrameCount(0), mUploadedBytes(0)
+{
+    for (size_t i = 0; i < FRAMES_IN_FLIGHT; ++i) {
+        mFrames[i].mPending = false;
+        mFrames[i].mQueries[0] = mFrames[i].mQueries[1] = 0;
+    }
+    std::memset(&mStats, 0, sizeof(mStats));
+}
+
+profiler_impl::~profiler_impl()
+{
+    for (size_t i = 0; i < FRAMES_IN_FLIGHT; ++i)
+        recycle(mFrames[i]);
+    if (!mFreeQueries.empty())
+        glDeleteQueries((GLsizei)mFreeQueries.size(), mFreeQueries.data());
+    if (currentProfiler == this)
+        currentProfiler = nullptr;
+}
+
+profiler_impl* profiler_impl::current()
+{
+    return currentProfiler;
+}
+
+void profiler_impl::setCurrent(profiler_impl* pProfiler)
+{
+    currentProfiler = pProfiler;
+}
+
+GLuint profiler_impl::query()
+{
+    if (mFreeQueries.empty()) {
+        mFreeQueries.resize(64);
+        glGenQueries((GLsizei)mFreeQueries.size(), mFreeQueries.data());
+    }
+    GLuint result = mFreeQueries.back();
+    mFreeQueries.pop_back();
+    return result;
+}
+
+void profiler_impl::recycle(Frame& pFrame)
+{
+    for (auto& section : pFrame.mSections) {
+        mFreeQueries.push_back(section.mQueries[0]);
+        mFreeQueries.push_back(section.mQueries[1]);
+    }
+    pFrame.mSections.clear();
+    if (pFrame.mQueries[0]) {
+        mFreeQueries.push_back(pFrame.mQueries[0]);
+        mFreeQueries.push_back(pFrame.mQueries[1]);
+        pFrame.mQueries[0] = pFrame.mQueries[1] = 0;
+    }
+    pFrame.mPending = false;
+}
+
+void profiler_impl::setEnabled(const bool pEnabled)
+{
+    if (!pEnabled) {
+        /* a frame being recorded is dropped */
+        mRecording = false;
+        mOpen      = -1;
+        for (size_t i = 0; i < FRAMES_IN_FLIGHT; ++i)
+            recycle(mFrames[i]);
+    }
+    mEnabled = pEnabled;
+}
+
+void profiler_impl::beginFrame()
+{
+    if (!mEnabled || mRecording)
+        return;
+
+    Frame& frame = mFrames[mCurrent];
+    recycle(frame);
+    frame.mIndex         = mFrameCount++;
+    frame.mDrawCalls     = 0;
+    frame.mUploadedBytes = 0;
+    frame.mQueries[0]    = query();
+    frame.mQueries[1]    = query();
+    glQueryCounter(frame.mQueries[0], GL_TIMESTAMP);
+
+    mFrameStart = Clock::now();
+    mRecording  = true;
+    mOpen       = -1;
+}
+
+int profiler_impl::begin(const fg_stat_kind pKind, const void* pObject, const std::string& pName)
+{
+    beginFrame();
+
+    Frame& frame = mFrames[mCurrent];
+    Section section;
+    section.mKind       = pKind;
+    section.mObject     = pObject;
+    section.mName       = pName;
+    section.mParent     = mOpen;
+    section.mQueries[0] = query();
+    section.mQueries[1] = query();
+    section.mCPUTime    = 0.0;
+    section.mDrawCalls  = 0;
+    glQueryCounter(section.mQueries[0], GL_TIMESTAMP);
+    section.mStart      = Clock::now();
+    frame.mSections.push_back(section);
+
+    mOpen = (int)frame.mSections.size() - 1;
+    return mOpen;
+}
+
+void profiler_impl::end(const int pSection)
+{
+    if (!mRecording)
+        return;
+
+    Section& section = mFrames[mCurrent].mSections[pSection];
+    glQueryCounter(section.mQueries[1], GL_TIMESTAMP);
+    section.mCPUTime = std::chrono::duration<double, std::milli>(Clock::now() - section.mStart).count();
+    mOpen = section.mParent;
+}
+
+void profiler_impl::countDrawCall()
+{
+    if (!mRecording)
+        return;
+
+    Frame& frame = mFrames[mCurrent];
+    if (mOpen >= 0)
+        frame.mSections[mOpen].mDrawCalls++;
+    else
+        frame.mDrawCalls++;
+}
+
+void profiler_impl::addUploadBytes(const size_t pBytes)
+{
+    mUploadedBytes += pBytes;
+}
+
+void profiler_impl::endFrame()
+{
+    if (!mRecording)
+        return;
+
+    Frame& frame = mFrames[mCurrent];
+    glQueryCounter(frame.mQueries[1], GL_TIMESTAMP);
+    frame.mCPUTime       = std::chrono::duration<double, std::milli>(Clock::now() - mFrameStart).count();
+    frame.mUploadedBytes = mUploadedBytes.exchange(0);
+    frame.mPending       = true;
+    mRecording = false;
+    mOpen      = -1;
+
+    /* visit frames from the oldest, the first one with results
+     * not yet available means later ones are not ready either */
+    for (size_t i = 1; i <= FRAMES_IN_FLIGHT; ++i) {
+        Frame& older = mFrames[(mCurrent + i) % FRAMES_IN_FLIGHT];
+        if (!older.mPending)
+            continue;
+        GLuint available = 0;
+        glGetQueryObjectuiv(older.mQueries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+        resolve(older);
+        recycle(older);
+    }
+
+    /* GPU is too far behind when the next slot is still in flight,
+     * its results are dropped rather than waited upon */
+    mCurrent = (mCurrent + 1) % FRAMES_IN_FLIGHT;
+    if (mFrames[mCurrent].mPending)
+        recycle(mFrames[mCurrent]);
+}
+
+void profiler_impl::resolve(Frame& pFrame)
+{
+    fg_frame_stats stats;
+    std::memset(&stats, 0, sizeof(stats));
+    stats.mFrame         = pFrame.mIndex;
+    stats.mUploadedBytes = pFrame.mUploadedBytes;
+
+    GLuint64 start = 0, stop = 0;
+    glGetQueryObjectui64v(pFrame.mQueries[0], GL_QUERY_RESULT, &start);
+    glGetQueryObjectui64v(pFrame.mQueries[1], GL_QUERY_RESULT, &stop);
+    stats.mCPUTime[FG_STAT_FRAME]   = pFrame.mCPUTime;
+    stats.mGPUTime[FG_STAT_FRAME]   = (stop - start) * 1e-6;
+    stats.mDrawCalls[FG_STAT_FRAME] = pFrame.mDrawCalls;
+
+    /* children always follow their parent, hence going backwards
+     * the total of a section is known before its parent is visited */
+    std::vector<Section>& sections = pFrame.mSections;
+    std::vector<double> gpu(sections.size()), gpuChildren(sections.size(), 0.0);
+    std::vector<double> cpuChildren(sections.size(), 0.0);
+    for (size_t i = 0; i < sections.size(); ++i) {
+        glGetQueryObjectui64v(sections[i].mQueries[0], GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(sections[i].mQueries[1], GL_QUERY_RESULT, &stop);
+        gpu[i] = (stop - start) * 1e-6;
+    }
+    for (size_t i = sections.size(); i-- > 0;) {
+        if (sections[i].mParent >= 0) {
+            gpuChildren[sections[i].mParent] += gpu[i];
+            cpuChildren[sections[i].mParent] += sections[i].mCPUTime;
+        }
+    }
+
+    for (size_t i = 0; i < sections.size(); ++i) {
+        const Section& section = sections[i];
+        const double cpuSelf = std::max(0.0, section.mCPUTime - cpuChildren[i]);
+        const double gpuSelf = std::max(0.0, gpu[i] - gpuChildren[i]);
+
+        stats.mCPUTime[section.mKind]   += cpuSelf;
+        stats.mGPUTime[section.mKind]   += gpuSelf;
+        stats.mDrawCalls[section.mKind] += section.mDrawCalls;
+        stats.mDrawCalls[FG_STAT_FRAME] += section.mDrawCalls;
+    }
+
+    /* per renderable breakdown in the order they were drawn,
+     * a renderable drawn in several cells is reported once */
+    std::vector<const void*> objects;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        const Section& section = sections[i];
+        if (section.mKind != FG_STAT_RENDERABLE)
+            continue;
+        size_t r = std::find(objects.begin(), objects.end(), section.mObject) - objects.begin();
+        if (r == objects.size()) {
+            if (r == FG_MAX_STAT_RENDERABLES)
+                continue;
+            objects.push_back(section.mObject);
+            std::strncpy(stats.mRenderables[r].mName, section.mName.c_str(),
+                         FG_STAT_NAME_LENGTH - 1);
+        }
+        fg_renderable_stats& entry = stats.mRenderables[r];
+        entry.mCPUTime   += std::max(0.0, section.mCPUTime - cpuChildren[i]);
+        entry.mGPUTime   += std::max(0.0, gpu[i] - gpuChildren[i]);
+        entry.mDrawCalls += section.mDrawCalls;
+    }
+    stats.mRenderableCount = (unsigned)objects.size();
+
+    std::lock_guard<std::mutex> lock(mStatsMutex);
+    mStats = stats;
+}
+
+fg_frame_stats profiler_impl::stats() const
+{
+    std::lock_guard<std::mutex> lock(mStatsMutex);
+    return mStats;
+}
+
+}
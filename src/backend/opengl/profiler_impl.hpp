@@ -0,0 +1,146 @@
+/*******************************************************
+* Copyright (c) 2015-2019, ArrayFire
+* All rights reserved.
+*
+* This file is distributed under 3-clause BSD license.
+* The complete license agreement can be obtained at:
+* http://arrayfire.com/licenses/BSD-3-Clause
+********************************************************/
+
+#pragma once
+
+#include <common.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace opengl
+{
+
+/* Measures CPU and GPU time spent on frames of a window
+ *
+ * Work done for a frame is split into nested sections, each section is
+ * charged only for the time not spent in its children. GPU time is taken
+ * from timestamp queries whose results are read a few frames later, once
+ * they are available, hence profiling never stalls the pipeline.
+ *
+ * A profiler is used only on the thread its window context is current on,
+ * except for stats and addUploadBytes which can be called from any thread.
+ */
+class profiler_impl {
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        static const size_t FRAMES_IN_FLIGHT = 4;
+
+        struct Section {
+            fg_stat_kind      mKind;
+            const void*       mObject;
+            std::string       mName;
+            int               mParent;
+            GLuint            mQueries[2];
+            Clock::time_point mStart;
+            double            mCPUTime;
+            unsigned          mDrawCalls;
+        };
+
+        struct Frame {
+            unsigned long long   mIndex;
+            std::vector<Section> mSections;
+            GLuint               mQueries[2];
+            double               mCPUTime;
+            unsigned             mDrawCalls;
+            unsigned long long   mUploadedBytes;
+            bool                 mPending;
+        };
+
+        bool                mEnabled;
+        Frame               mFrames[FRAMES_IN_FLIGHT];
+        size_t              mCurrent;
+        bool                mRecording;
+        Clock::time_point   mFrameStart;
+        /* innermost open section of current frame, -1 if none */
+        int                 mOpen;
+        unsigned long long  mFrameCount;
+        std::vector<GLuint> mFreeQueries;
+        std::atomic<unsigned long long> mUploadedBytes;
+
+        fg_frame_stats      mStats;
+        mutable std::mutex  mStatsMutex;
+
+        GLuint query();
+        void recycle(Frame& pFrame);
+        void resolve(Frame& pFrame);
+
+    public:
+        profiler_impl();
+        ~profiler_impl();
+
+        void setEnabled(const bool pEnabled);
+        bool enabled() const { return mEnabled; }
+
+        /* start recording a frame, if not started already */
+        void beginFrame();
+
+        /* @return identifier of the section to be passed to end */
+        int begin(const fg_stat_kind pKind, const void* pObject, const std::string& pName);
+        void end(const int pSection);
+
+        void countDrawCall();
+        void addUploadBytes(const size_t pBytes);
+
+        /* close the frame being recorded and collect
+         * results of earlier frames that are available */
+        void endFrame();
+
+        /* statistics of the most recent frame with available results */
+        fg_frame_stats stats() const;
+
+        /* profiler of the window whose context is current on calling thread */
+        static profiler_impl* current();
+        static void setCurrent(profiler_impl* pProfiler);
+};
+
+/* Charges the time spent in the enclosing scope to a kind of work */
+class ProfileScope {
+    private:
+        profiler_impl* mProfiler;
+        int            mSection;
+
+        ProfileScope(const ProfileScope&);
+        ProfileScope& operator=(const ProfileScope&);
+
+    public:
+        ProfileScope(const fg_stat_kind pKind, const void* pObject=nullptr,
+                     const std::string& pName=std::string())
+            : mProfiler(profiler_impl::current()), mSection(-1)
+        {
+            if (mProfiler && mProfiler->enabled())
+                mSection = mProfiler->begin(pKind, pObject, pName);
+        }
+
+        ~ProfileScope()
+        {
+            if (mSection >= 0)
+                mProfiler->end(mSection);
+        }
+};
+
+inline void countDrawCall()
+{
+    profiler_impl* profiler = profiler_impl::current();
+    if (profiler && profiler->enabled())
+        profiler->countDrawCall();
+}
+
+inline void countUploadBytes(const size_t pBytes)
+{
+    profiler_impl* profiler = profiler_impl::current();
+    if (profiler && profiler->enabled())
+        profiler->addUploadBytes(pBytes);
+}
+
+}
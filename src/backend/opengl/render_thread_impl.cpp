@@ -0,0 +1,112 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <common.hpp>
+#include <render_thread_impl.hpp>
+#include <window_impl.hpp>
+
+namespace opengl
+{
+
+const size_t render_thread_impl::QUEUE_SIZE;
+
+render_thread_impl::render_thread_impl(const window_impl* pWindow)
+    : mWindow(pWindow), mQueue(QUEUE_SIZE), mCompleted(0),
+      mSleeping(false), mStop(false)
+{
+    /* a context can be current on only one thread at a time */
+    ReleaseContext(mWindow);
+    mThread = std::thread(&render_thread_impl::run, this);
+}
+
+render_thread_impl::~render_thread_impl()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWakeUp.notify_one();
+    if (mThread.joinable())
+        mThread.join();
+}
+
+void render_thread_impl::run()
+{
+    MakeContextCurrent(mWindow);
+
+    Command command;
+    bool pending = false;
+    while (true) {
+        if (!pending)
+            pending = mQueue.pop(command);
+
+        if (pending) {
+            try {
+                command();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (!mError)
+                    mError = std::current_exception();
+            }
+            command = nullptr;
+            pending = false;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                ++mCompleted;
+            }
+            mDone.notify_all();
+            continue;
+        }
+
+        /* queue looked empty, sleep until a producer wakes us up. The
+         * fences pair with the ones in enqueue, so either the producer
+         * sees mSleeping set or the pop below sees the new command */
+        std::unique_lock<std::mutex> lock(mMutex);
+        mSleeping.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        mWakeUp.wait(lock, [&] { return (pending = mQueue.pop(command)) || mStop; });
+        mSleeping.store(false);
+        if (!pending)
+            break;
+    }
+
+    mWindow->get()->releaseContext();
+}
+
+unsigned long long render_thread_impl::enqueue(Command&& pCommand)
+{
+    size_t ticket = 0;
+    while (!mQueue.push(std::move(pCommand), ticket))
+        std::this_thread::yield();
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (mSleeping.load()) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mWakeUp.notify_one();
+    }
+    return ticket + 1;
+}
+
+void render_thread_impl::wait(const unsigned long long pId)
+{
+    if (onRenderThread())
+        throw fg::Error("render_thread_impl::wait", __LINE__,
+                        "Render thread can not wait on its own commands",
+                        FG_ERR_INVALID_ARG);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDone.wait(lock, [&] { return mCompleted.load() >= pId; });
+    if (mError) {
+        std::exception_ptr error = mError;
+        mError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+}
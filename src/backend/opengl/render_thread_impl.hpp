@@ -0,0 +1,74 @@
+/*******************************************************
+* Copyright (c) 2015-2019, ArrayFire
+* All rights reserved.
+*
+* This file is distributed under 3-clause BSD license.
+* The complete license agreement can be obtained at:
+* http://arrayfire.com/licenses/BSD-3-Clause
+********************************************************/
+
+#pragma once
+
+#include <command_queue.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace opengl
+{
+
+class window_impl;
+
+/* Executes window commands on a thread owned by Forge
+ *
+ * The context of the window stays current on the render thread for
+ * its whole lifetime. Commands are pushed by any thread into a lock free
+ * queue and are executed in the order of the tickets they are given.
+ * Window events are still processed by the thread that created the window.
+ */
+class render_thread_impl {
+    private:
+        static const size_t QUEUE_SIZE = 64;
+
+        typedef std::function<void()> Command;
+
+        const window_impl*    mWindow;
+        CommandQueue<Command> mQueue;
+        /* number of commands executed so far */
+        std::atomic<unsigned long long> mCompleted;
+        std::atomic<bool>     mSleeping;
+        bool                  mStop;
+        /* first exception thrown by a command, rethrown
+         * on the next call to wait */
+        std::exception_ptr    mError;
+        std::mutex              mMutex;
+        std::condition_variable mWakeUp;
+        std::condition_variable mDone;
+        std::thread             mThread;
+
+        void run();
+
+    public:
+        render_thread_impl(const window_impl* pWindow);
+        ~render_thread_impl();
+
+        /* Queue command for execution on render thread
+         *
+         * Blocks only when the queue is full, which limits
+         * the number of frames producers can run ahead.
+         *
+         * @return identifier to be passed to wait
+         */
+        unsigned long long enqueue(Command&& pCommand);
+
+        /* Block until the command with given identifier has executed */
+        void wait(const unsigned long long pId);
+
+        bool onRenderThread() const { return std::this_thread::get_id() == mThread.get_id(); }
+};
+
+}
@@ -0,0 +1,151 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <common.hpp>
+#include <err_opengl.hpp>
+#include <scheduler_impl.hpp>
+
+#include <algorithm>
+#include <functional>
+
+namespace opengl
+{
+
+scheduler_impl::scheduler_impl()
+    : mSorted(true)
+{
+}
+
+scheduler_impl::~scheduler_impl()
+{
+    resetSwapIntervals();
+}
+
+void scheduler_impl::resetSwapIntervals()
+{
+    /* windows drawn on their own afterwards
+     * should be synchronized to vertical refresh */
+    for (auto& entry : mEntries) {
+        window_impl* window = entry.mWindow.get();
+        if (!window->mRenderThread && window->mSwapInterval == 0)
+            window->setSwapInterval(1);
+    }
+}
+
+void scheduler_impl::add(const std::shared_ptr<window_impl>& pWindow,
+                         const std::shared_ptr<AbstractRenderable>& pRenderable)
+{
+    Entry entry;
+    entry.mWindow     = pWindow;
+    entry.mRenderable = pRenderable;
+    entry.mColId      = -1;
+    entry.mRowId      = -1;
+    entry.mHasTitle   = false;
+    mEntries.push_back(entry);
+    mSorted = false;
+}
+
+void scheduler_impl::add(const std::shared_ptr<window_impl>& pWindow,
+                         const int pColId, const int pRowId,
+                         const std::shared_ptr<AbstractRenderable>& pRenderable,
+                         const char* pTitle)
+{
+    if (pColId < 0 || pRowId < 0)
+        throw fg::ArgumentError("scheduler_impl::add", __LINE__, 2,
+                                "Cell indices can not be negative");
+    Entry entry;
+    entry.mWindow     = pWindow;
+    entry.mRenderable = pRenderable;
+    entry.mColId      = pColId;
+    entry.mRowId      = pRowId;
+    entry.mHasTitle   = pTitle != NULL;
+    entry.mTitle      = entry.mHasTitle ? pTitle : "";
+    mEntries.push_back(entry);
+    mSorted = false;
+}
+
+void scheduler_impl::clear()
+{
+    resetSwapIntervals();
+    mEntries.clear();
+    mSorted = true;
+}
+
+void scheduler_impl::draw()
+{
+    CheckGL("Begin scheduler_impl::draw");
+    if (!mSorted) {
+        /* windows that share a context are visited one after the other,
+         * entries of a window keep the order in which they were added */
+        std::stable_sort(mEntries.begin(), mEntries.end(),
+                         [](const Entry& pLeft, const Entry& pRight) {
+                             GLEWContext* lcxt = pLeft.mWindow->glewContext();
+                             GLEWContext* rcxt = pRight.mWindow->glewContext();
+                             if (lcxt != rcxt)
+                                 return std::less<GLEWContext*>()(lcxt, rcxt);
+                             return pLeft.mWindow->getID() < pRight.mWindow->getID();
+                         });
+        mSorted = true;
+    }
+
+    /* only the window presented last waits for vsync */
+    window_impl* last = nullptr;
+    for (auto& entry : mEntries) {
+        if (!entry.mWindow->mRenderThread)
+            last = entry.mWindow.get();
+    }
+
+    window_impl* polled = nullptr;
+    size_t begin = 0;
+    while (begin < mEntries.size()) {
+        window_impl* window = mEntries[begin].mWindow.get();
+        size_t end = begin;
+        while (end < mEntries.size() && mEntries[end].mWindow.get() == window)
+            ++end;
+
+        if (window->mRenderThread) {
+            /* threaded windows present on their own thread */
+            bool cells = false;
+            for (size_t i = begin; i < end; ++i) {
+                const Entry& entry = mEntries[i];
+                if (entry.mColId < 0) {
+                    window->drawAsync(entry.mRenderable);
+                } else {
+                    window->drawAsync(entry.mColId, entry.mRowId, entry.mRenderable,
+                                      entry.mHasTitle ? entry.mTitle.c_str() : NULL);
+                    cells = true;
+                }
+            }
+            if (cells)
+                window->swapBuffersAsync();
+        } else {
+            window->setSwapInterval(window == last ? 1 : 0);
+            for (size_t i = begin; i < end; ++i) {
+                const Entry& entry = mEntries[i];
+                if (entry.mColId < 0) {
+                    window->renderFrame(entry.mRenderable, window->cellView(0, 0));
+                } else {
+                    window->renderCell(entry.mColId, entry.mRowId, entry.mRenderable,
+                                       entry.mHasTitle ? entry.mTitle.c_str() : NULL,
+                                       window->cellView(entry.mColId, entry.mRowId));
+                }
+            }
+            window->present();
+            polled = window;
+        }
+        begin = end;
+    }
+
+    /* events of all windows are processed by a single poll */
+    if (polled)
+        polled->pollEvents();
+    CheckGL("End scheduler_impl::draw");
+}
+
+}
@@ -0,0 +1,64 @@
+/*******************************************************
+* Copyright (c) 2015-2019, ArrayFire
+* All rights reserved.
+*
+* This file is distributed under 3-clause BSD license.
+* The complete license agreement can be obtained at:
+* http://arrayfire.com/licenses/BSD-3-Clause
+********************************************************/
+
+#pragma once
+
+#include <common.hpp>
+#include <window_impl.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace opengl
+{
+
+/* Draws a set of windows as one frame
+ *
+ * Windows are visited once per frame, grouped by the GLEW context they
+ * share, and each window is presented right after it is rendered. Only
+ * the window presented last waits for vertical sync, the rest swap with
+ * an interval of zero. Hence a frame costs one context switch per window
+ * and one vsync wait overall instead of one per window.
+ */
+class scheduler_impl {
+    private:
+        struct Entry {
+            std::shared_ptr<window_impl>        mWindow;
+            std::shared_ptr<AbstractRenderable> mRenderable;
+            /* cell of grid layout, negative for whole window */
+            int         mColId;
+            int         mRowId;
+            bool        mHasTitle;
+            std::string mTitle;
+        };
+
+        std::vector<Entry> mEntries;
+        bool               mSorted;
+
+        void resetSwapIntervals();
+
+    public:
+        scheduler_impl();
+        ~scheduler_impl();
+
+        void add(const std::shared_ptr<window_impl>& pWindow,
+                 const std::shared_ptr<AbstractRenderable>& pRenderable);
+
+        void add(const std::shared_ptr<window_impl>& pWindow,
+                 const int pColId, const int pRowId,
+                 const std::shared_ptr<AbstractRenderable>& pRenderable,
+                 const char* pTitle);
+
+        void clear();
+
+        void draw();
+};
+
+}
@@ -8,6 +8,7 @@
 ********************************************************/
 
 #include <common.hpp>
+#include <err_opengl.hpp>
 #include <sdl/window.hpp>
 
 #include <glm/gtc/matrix_transform.hpp>
@@ -31,7 +32,8 @@ namespace wtk
 
 Widget::Widget()
     : mWindow(nullptr), mClose(false), mLastXPos(0), mLastYPos(0), mButton(-1),
-    mWidth(512), mHeight(512), mRows(1), mCols(1)
+    mPendingWidth(0), mPendingHeight(0), mResized(false),
+    mWidth(512), mHeight(512), mRows(1), mCols(1), mDirty(true)
 {
     mCellWidth  = mWidth;
     mCellHeight = mHeight;
@@ -39,7 +41,8 @@ Widget::Widget()
 }
 
 Widget::Widget(int pWidth, int pHeight, const char* pTitle, const Widget* pWindow, const bool invisible)
-    : mWindow(nullptr), mClose(false), mLastXPos(0), mLastYPos(0), mButton(-1), mRows(1), mCols(1)
+    : mWindow(nullptr), mClose(false), mLastXPos(0), mLastYPos(0), mButton(-1),
+      mPendingWidth(0), mPendingHeight(0), mResized(false), mRows(1), mCols(1), mDirty(true)
 {
     mFramePBO   = 0;
 
@@ -53,6 +56,10 @@ Widget::Widget(int pWidth, int pHeight, const char* pTitle, const Widget* pWindo
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
     SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
     SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
+    SDL_GL_SetAttribute(SDL_GL_MULTISAMPLEBUFFERS, msaaSamples() > 0 ? 1 : 0);
+    SDL_GL_SetAttribute(SDL_GL_MULTISAMPLESAMPLES, msaaSamples());
+    /* debug contexts report errors through KHR_debug callback */
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, glDebugEnabled() ? SDL_GL_CONTEXT_DEBUG_FLAG : 0);
 
     if (pWindow != nullptr) {
         pWindow->makeContextCurrent();
@@ -106,6 +113,11 @@ void Widget::makeContextCurrent() const
     SDL_GL_MakeCurrent(mWindow, mContext);
 }
 
+void Widget::releaseContext() const
+{
+    SDL_GL_MakeCurrent(mWindow, NULL);
+}
+
 long long Widget::getGLContextHandle()
 {
 #ifdef OS_WIN
@@ -141,6 +153,11 @@ void Widget::setSize(unsigned pW, unsigned pH)
     SDL_SetWindowSize(mWindow, pW, pH);
 }
 
+void Widget::setSwapInterval(const int pInterval)
+{
+    SDL_GL_SetSwapInterval(pInterval);
+}
+
 void Widget::swapBuffers()
 {
     SDL_GL_SwapWindow(mWindow);
@@ -149,6 +166,9 @@ void Widget::swapBuffers()
     glBindBuffer(GL_PIXEL_PACK_BUFFER, mFramePBO);
     glReadPixels(0, 0, mWidth, mHeight, GL_RGBA, GL_UNSIGNED_BYTE, 0);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    /* the frame just read back was rendered at the previous size */
+    applyResize();
 }
 
 void Widget::hide()
@@ -160,6 +180,7 @@ void Widget::hide()
 void Widget::show()
 {
     mClose = false;
+    mDirty = true;
     SDL_ShowWindow(mWindow);
 }
 
@@ -190,12 +211,19 @@ void Widget::pollEvents()
                 case SDL_WINDOWEVENT_CLOSE:
                     mClose = true;
                     break;
-                case SDL_WINDOWEVENT_RESIZED:
-                    mWidth      = evnt.window.data1;
-                    mHeight     = evnt.window.data2;
-                    mCellWidth  = mWidth  / mCols;
-                    mCellHeight = mHeight / mRows;
-                    resizePixelBuffers();
+                case SDL_WINDOWEVENT_RESIZED: {
+                    /* events may be handled on a thread other than the one
+                     * rendering into the window, the size is applied on swap */
+                    std::lock_guard<std::mutex> lock(mResizeMutex);
+                    mPendingWidth  = evnt.window.data1;
+                    mPendingHeight = evnt.window.data2;
+                    mResized       = true;
+                    mDirty         = true;
+                    break;
+                }
+                case SDL_WINDOWEVENT_EXPOSED:
+                case SDL_WINDOWEVENT_RESTORED:
+                    mDirty = true;
                     break;
             }
         }
@@ -217,8 +245,10 @@ void Widget::pollEvents()
             if(evnt.button.button == SDL_BUTTON_MIDDLE && mMod == SDLK_LALT) {
                 int r, c;
                 getViewIds(&r, &c);
+                std::lock_guard<std::mutex> lock(mViewMutex);
                 glm::mat4& mvp = mMVPs[r+c*mRows];
                 mvp = glm::mat4(1.0f);
+                mDirty = true;
             }
         }
 
@@ -228,6 +258,7 @@ void Widget::pollEvents()
 
             int r, c;
             getViewIds(&r, &c);
+            std::lock_guard<std::mutex> lock(mViewMutex);
             glm::mat4& mvp = mMVPs[r+c*mRows];
 
             if(evnt.motion.state == SDL_BUTTON_LMASK &&
@@ -262,12 +293,30 @@ void Widget::pollEvents()
                 mLastPos  = curPos;
             }
 
+            if (evnt.motion.state != 0)
+                mDirty = true;
+
             mLastXPos = evnt.motion.x;
             mLastYPos = evnt.motion.y;
         }
     }
 }
 
+void Widget::waitEvents(const double pTimeout)
+{
+    /* a null event leaves the event in queue for pollEvents */
+    if (pTimeout > 0)
+        SDL_WaitEventTimeout(NULL, (int)(pTimeout * 1000));
+    else
+        SDL_WaitEvent(NULL);
+}
+
+bool Widget::isHidden() const
+{
+    return (SDL_GetWindowFlags(mWindow) &
+            (SDL_WINDOW_HIDDEN | SDL_WINDOW_MINIMIZED)) != 0;
+}
+
 void Widget::resizePixelBuffers()
 {
     if (mFramePBO!=0)
@@ -282,4 +331,20 @@ void Widget::resizePixelBuffers()
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 }
 
+void Widget::applyResize()
+{
+    {
+        std::lock_guard<std::mutex> lock(mResizeMutex);
+        if (!mResized)
+            return;
+        mWidth   = mPendingWidth;
+        mHeight  = mPendingHeight;
+        mResized = false;
+    }
+    mCellWidth  = mWidth  / mCols;
+    mCellHeight = mHeight / mRows;
+    mDirty      = true;
+    resizePixelBuffers();
+}
+
 }
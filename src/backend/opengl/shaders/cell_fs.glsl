@@ -0,0 +1,13 @@
+#version 330
+
+/* copies the cached rendering of a grid cell,
+ * offset is the window position of the cell */
+uniform sampler2D tex;
+uniform ivec2 offset;
+
+out vec4 outputColor;
+
+void main(void)
+{
+    outputColor = texelFetch(tex, ivec2(gl_FragCoord.xy) - offset, 0);
+}
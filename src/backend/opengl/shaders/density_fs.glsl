@@ -0,0 +1,22 @@
+#version 330
+
+/* 3d plots define BOUNDED to drop points
+ * outside of the axes ranges of the chart */
+#ifdef BOUNDED
+uniform vec2 minmaxs[3];
+
+in vec4 hpoint;
+#endif
+
+out vec4 outColor;
+
+void main(void)
+{
+#ifdef BOUNDED
+   if (hpoint.x > minmaxs[0].y || hpoint.x < minmaxs[0].x ||
+       hpoint.y > minmaxs[1].y || hpoint.y < minmaxs[1].x || hpoint.z < minmaxs[2].x)
+       discard;
+#endif
+   // blending adds up the points that land on a pixel
+   outColor = vec4(1.0, 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,8 @@
+#version 330
+
+void main(void)
+{
+   // single triangle covering the whole viewport
+   vec2 pos    = vec2((gl_VertexID & 1) * 4 - 1, (gl_VertexID >> 1) * 4 - 1);
+   gl_Position = vec4(pos, 0.0, 1.0);
+}
@@ -0,0 +1,20 @@
+#version 330
+
+uniform sampler2D src;
+uniform ivec2 srcSize;
+
+out vec4 outColor;
+
+void main(void)
+{
+   // every texel holds the maximum of a 4x4 block of the source
+   ivec2 base = ivec2(gl_FragCoord.xy) * 4;
+   float m    = 0.0;
+   for (int y = 0; y < 4; ++y) {
+      for (int x = 0; x < 4; ++x) {
+         ivec2 pos = min(base + ivec2(x, y), srcSize - 1);
+         m = max(m, texelFetch(src, pos, 0).r);
+      }
+   }
+   outColor = vec4(m, 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,31 @@
+#version 330
+
+uniform sampler1D cmap;
+uniform float cmaplen;
+uniform sampler2D counts;
+uniform sampler2D maxcount;
+uniform ivec2 origin;
+uniform bool uselog;
+uniform float alpha;
+
+/* ratio of the slopes of log mapping at the
+ * lower and upper ends of the count range */
+const float LOG_CONTRAST = 1000.0;
+
+out vec4 outColor;
+
+void main(void)
+{
+   float c = texelFetch(counts, ivec2(gl_FragCoord.xy) - origin, 0).r;
+   if (c <= 0.0)
+      discard;
+
+   float m = max(texelFetch(maxcount, ivec2(0, 0), 0).r, 1.0);
+   float v = clamp(c / m, 0.0, 1.0);
+   if (uselog)
+      v = log(1.0 + LOG_CONTRAST * v) / log(1.0 + LOG_CONTRAST);
+
+   /* map [0, 1] onto the centers of first and last texels */
+   float fidx = (clamp(v, 0.0, 1.0) * (cmaplen-1) + 0.5) / cmaplen;
+   outColor   = vec4(texture(cmap, fidx).rgb, alpha);
+}
@@ -0,0 +1,9 @@
+#version 330
+
+out vec4 outputColor;
+
+void main(void)
+{
+    // each sample adds one to its bin using additive blending
+    outputColor = vec4(1, 0, 0, 1);
+}
@@ -0,0 +1,21 @@
+#version 330
+
+uniform float minval;
+uniform float maxval;
+uniform float nbins;
+
+in float value;
+
+void main(void)
+{
+    float binId = floor(nbins * (value - minval) / (maxval - minval));
+    // samples equal to the upper limit belong to the last bin
+    binId = min(binId, nbins - 1.0);
+    // samples outside [minval, maxval] (and NaNs) are placed
+    // outside the clip volume so that they are discarded
+    float xcurr = 2.0;
+    if (value >= minval && value <= maxval) {
+        xcurr = -1.0 + (2.0 * binId + 1.0) / nbins;
+    }
+    gl_Position = vec4(xcurr, 0, 0, 1);
+}
@@ -0,0 +1,12 @@
+#version 330
+
+uniform usampler2D totals;
+uniform float scale;
+
+out vec4 outputColor;
+
+void main(void)
+{
+    uint total = texelFetch(totals, ivec2(int(gl_FragCoord.x), 0), 0).r;
+    outputColor = vec4(scale * float(total), 0, 0, 1);
+}
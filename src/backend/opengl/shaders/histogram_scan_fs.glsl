@@ -0,0 +1,22 @@
+#version 330
+
+uniform usampler2D totals;
+uniform sampler2D counts;
+uniform bool addCounts;
+uniform int offset;
+
+out uint outputTotal;
+
+void main(void)
+{
+    int binId = int(gl_FragCoord.x);
+    uint total = texelFetch(totals, ivec2(binId, 0), 0).r;
+    if (addCounts) {
+        // a pass bins at most 2^24 samples, hence its float counts are exact
+        total += uint(texelFetch(counts, ivec2(binId, 0), 0).r);
+    } else if (binId >= offset) {
+        // one step of an inclusive prefix sum, offset doubles every step
+        total += texelFetch(totals, ivec2(binId - offset, 0), 0).r;
+    }
+    outputTotal = total;
+}
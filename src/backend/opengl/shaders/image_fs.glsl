@@ -1,23 +1,103 @@
 #version 330
 
-const int size = 259;
-
-layout(std140) uniform ColorMap
-{
-    vec4 ch[size];
-};
+/* integer textures are sampled by defining
+ * SAMPLER as isampler2D or usampler2D */
+#ifndef SAMPLER
+#define SAMPLER sampler2D
+#endif
 
+uniform sampler1D cmap;
 uniform float cmaplen;
-uniform sampler2D tex;
+uniform SAMPLER tex;
 uniform int numcomps;
 uniform float alpha;
+/* sampled values multiplied by valscale are in
+ * units of the source data, range is [min, max]
+ * in those units and alphamax is the value of
+ * an opaque pixel */
+uniform float valscale;
+uniform vec2 range;
+uniform float gamma;
+uniform bool uselog;
+uniform float alphamax;
+
+/* ratio of the slopes of log mapping at the
+ * lower and upper ends of the value range */
+const float LOG_CONTRAST = 1000.0;
+
+#if defined(NV12) || defined(YUYV)
+/* columns are the contribution of Y, U & V to RGB */
+uniform mat3 yuv2rgb;
+const vec3 yuvoffset = vec3(16.0, 128.0, 128.0) / 255.0;
+#endif
+
+#ifdef NV12
+uniform sampler2D uvtex;
+#endif
+
+#ifdef BAYER
+/* location of red pixel in the 2x2 mosaic pattern */
+uniform ivec2 redpos;
+
+float bayer(ivec2 pPos, ivec2 pMax)
+{
+    return texelFetch(tex, clamp(pPos, ivec2(0), pMax), 0).r;
+}
+#endif
 
 in vec2 texcoord;
 out vec4 fragColor;
 
+vec4 fetchPixel()
+{
+#if defined(NV12)
+    float luma = texture(tex, texcoord).r;
+    vec2 chroma = texture(uvtex, texcoord).rg;
+    return vec4(yuv2rgb * (vec3(luma, chroma) - yuvoffset), 1.0);
+#elif defined(YUYV)
+    /* each texel holds two horizontally adjacent pixels */
+    ivec2 tsize = textureSize(tex, 0);
+    ivec2 pos   = clamp(ivec2(texcoord * vec2(2 * tsize.x, tsize.y)),
+                        ivec2(0), ivec2(2 * tsize.x - 1, tsize.y - 1));
+    vec4 texel  = texelFetch(tex, ivec2(pos.x / 2, pos.y), 0);
+    float luma  = (pos.x % 2 == 0 ? texel.r : texel.b);
+    return vec4(yuv2rgb * (vec3(luma, texel.g, texel.a) - yuvoffset), 1.0);
+#elif defined(BAYER)
+    /* bilinear demosaicing, missing colors of a pixel
+     * are the average of nearest pixels of that color */
+    ivec2 tmax = textureSize(tex, 0) - 1;
+    ivec2 pos  = clamp(ivec2(texcoord * vec2(tmax + 1)), ivec2(0), tmax);
+    float c    = bayer(pos, tmax);
+    float hor  = (bayer(pos + ivec2(-1, 0), tmax) + bayer(pos + ivec2(1, 0), tmax)) * 0.5;
+    float ver  = (bayer(pos + ivec2(0, -1), tmax) + bayer(pos + ivec2(0, 1), tmax)) * 0.5;
+    float crs  = (hor + ver) * 0.5;
+    float dgn  = (bayer(pos + ivec2(-1, -1), tmax) + bayer(pos + ivec2(1, -1), tmax) +
+                  bayer(pos + ivec2(-1,  1), tmax) + bayer(pos + ivec2(1,  1), tmax)) * 0.25;
+    bvec2 red  = equal(pos % 2, redpos);
+    if (red.x && red.y)
+        return vec4(c, crs, dgn, 1.0);
+    else if (!red.x && !red.y)
+        return vec4(dgn, crs, c, 1.0);
+    else if (red.y)
+        return vec4(hor, c, ver, 1.0);
+    else
+        return vec4(ver, c, hor, 1.0);
+#else
+    return vec4(texture(tex, texcoord));
+#endif
+}
+
 void main()
 {
-    vec4 tcolor = texture(tex, texcoord);
+    vec4 raw = fetchPixel() * valscale;
+    /* normalized first so that the log mapping
+     * doesn't depend on the units of the data */
+    vec3 vals = clamp((raw.rgb - range.x) / (range.y - range.x), 0.0, 1.0);
+    if (uselog)
+        vals = log(1.0 + LOG_CONTRAST * vals) / log(1.0 + LOG_CONTRAST);
+    vals = pow(vals, vec3(gamma));
+    vec4 tcolor = vec4(vals, clamp(raw.a / alphamax, 0.0, 1.0));
+
     vec4 clrs = vec4(1, 0, 0, 1);
     if(numcomps == 1)
         clrs = vec4(tcolor.r, tcolor.r, tcolor.r, alpha);
@@ -29,11 +109,11 @@ void main()
         clrs = tcolor;
     float aval = clrs.a;
 
-    vec4 fidx  = (cmaplen-1) * clrs;
-    ivec4 idx  = ivec4(fidx.x, fidx.y, fidx.z, fidx.w);
-    float r_ch = ch[idx.x].r;
-    float g_ch = ch[idx.y].g;
-    float b_ch = ch[idx.z].b;
+    /* map [0, 1] onto the centers of first and last texels */
+    vec4 fidx  = (clamp(clrs, 0.0, 1.0) * (cmaplen-1) + 0.5) / cmaplen;
+    float r_ch = texture(cmap, fidx.x).r;
+    float g_ch = texture(cmap, fidx.y).g;
+    float b_ch = texture(cmap, fidx.z).b;
 
     fragColor = vec4(r_ch, g_ch , b_ch, aval);
 }
@@ -0,0 +1,28 @@
+#version 330
+
+/* box filter that computes a mip level of an integer
+ * texture from the previous level, SAMPLER and TEXEL
+ * are defined as isampler2D & ivec4 or usampler2D & uvec4 */
+#ifndef SAMPLER
+#define SAMPLER isampler2D
+#define TEXEL ivec4
+#endif
+
+uniform SAMPLER tex;
+
+out TEXEL fragColor;
+
+void main()
+{
+    /* texture base level is set to the source level */
+    ivec2 smax = textureSize(tex, 0) - 1;
+    ivec2 pos  = ivec2(gl_FragCoord.xy) * 2;
+
+    /* average in floating point to avoid integer overflow */
+    vec4 sum = vec4(texelFetch(tex, min(pos              , smax), 0)) +
+               vec4(texelFetch(tex, min(pos + ivec2(1, 0), smax), 0)) +
+               vec4(texelFetch(tex, min(pos + ivec2(0, 1), smax), 0)) +
+               vec4(texelFetch(tex, min(pos + ivec2(1, 1), smax), 0));
+
+    fragColor = TEXEL(round(sum * 0.25));
+}
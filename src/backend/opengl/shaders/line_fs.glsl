@@ -0,0 +1,53 @@
+#version 330
+
+uniform vec2 minmaxs[3];
+uniform bool isPVCOn;
+uniform bool isPVAOn;
+uniform bool isHeightColored;
+uniform bool isJoin;
+uniform vec4 lineColor;
+uniform float lineWidth;
+
+in vec4 hpoint;
+in vec4 pervcol;
+noperspective in vec2 stroke;
+flat in float strokeLength;
+
+out vec4 outColor;
+
+vec3 hsv2rgb(vec3 c)
+{
+   vec4 K = vec4(1.0, 2.0 / 3.0, 1.0 / 3.0, 3.0);
+   vec3 p = abs(fract(c.xxx + K.xyz) * 6.0 - K.www);
+   return c.z * mix(K.xxx, clamp(p - K.xxx, 0.0, 1.0), c.y);
+}
+
+void main(void)
+{
+   // distance in pixels from the center of the stroke, segments
+   // reach past their end points only when they have round caps
+   float dist;
+   if (isJoin) {
+      dist = max(stroke.x, stroke.y);
+   } else {
+      float along = max(max(-stroke.x, stroke.x - strokeLength), 0.0);
+      dist = length(vec2(along, stroke.y));
+   }
+   float coverage = clamp(0.5 * lineWidth + 0.5 - dist, 0.0, 1.0);
+
+   if (coverage <= 0.0)
+      discard;
+
+   vec3 color = isPVCOn ? pervcol.xyz : lineColor.xyz;
+
+   if (isHeightColored) {
+      bool nin_bounds = (hpoint.x > minmaxs[0].y || hpoint.x < minmaxs[0].x ||
+          hpoint.y > minmaxs[1].y || hpoint.y < minmaxs[1].x || hpoint.z < minmaxs[2].x);
+      if (nin_bounds)
+         discard;
+      float height = (minmaxs[2].y- hpoint.z)/(minmaxs[2].y-minmaxs[2].x);
+      color = isPVCOn ? pervcol.xyz : hsv2rgb(vec3(height, 1, 1));
+   }
+
+   outColor = vec4(color, (isPVAOn ? pervcol.w : 1.0) * coverage);
+}
@@ -0,0 +1,93 @@
+#version 330
+
+uniform mat4 transform;
+uniform vec2 viewport;
+uniform float lineWidth;
+uniform bool isRound;
+uniform bool isJoin;
+
+/* segment pass: segment from p0 to p1
+ * join pass: join at p1 of segments p0-p1 and p1-p2 */
+in vec3 p0;
+in vec3 p1;
+in vec3 p2;
+in vec3 c0;
+in vec3 c1;
+in float a0;
+in float a1;
+
+out vec4 hpoint;
+out vec4 pervcol;
+noperspective out vec2 stroke;
+flat out float strokeLength;
+
+const float MITER_LIMIT = 4.0;
+
+vec2 toScreen(vec4 clip)
+{
+   return clip.xy / clip.w * 0.5 * viewport;
+}
+
+vec4 toClip(vec2 screen, vec4 clip)
+{
+   return vec4(screen / (0.5 * viewport) * clip.w, clip.zw);
+}
+
+vec2 direction(vec2 from, vec2 to)
+{
+   vec2 d = to - from;
+   return dot(d, d) > 1.0e-12 ? normalize(d) : vec2(1, 0);
+}
+
+void main(void)
+{
+   // one pixel beyond the stroke edge is covered for anti-aliasing
+   float halfWidth = 0.5 * lineWidth + 1.0;
+
+   vec4 clip0 = transform * vec4(p0, 1);
+   vec4 clip1 = transform * vec4(p1, 1);
+   vec2 s0    = toScreen(clip0);
+   vec2 s1    = toScreen(clip1);
+   vec2 dirA  = direction(s0, s1);
+   vec2 nrmA  = vec2(-dirA.y, dirA.x);
+
+   if (!isJoin) {
+      // quad around the segment, vertices ordered for a triangle strip
+      bool  atEnd = gl_VertexID > 1;
+      float side  = (gl_VertexID & 1) == 1 ? 1.0 : -1.0;
+      float ext   = isRound ? halfWidth : 0.0;
+      float len   = length(s1 - s0);
+
+      vec2 s   = (atEnd ? s1 + dirA * ext : s0 - dirA * ext) + nrmA * side * halfWidth;
+      stroke       = vec2(atEnd ? len + ext : -ext, side * halfWidth);
+      strokeLength = len;
+      hpoint       = vec4(atEnd ? p1 : p0, 1);
+      pervcol      = atEnd ? vec4(c1, a1) : vec4(c0, a0);
+      gl_Position  = toClip(s, atEnd ? clip1 : clip0);
+   } else {
+      // wedge filling the gap on the outer side of a miter join
+      vec2 s2    = toScreen(transform * vec4(p2, 1));
+      vec2 dirB  = direction(s1, s2);
+      vec2 nrmB  = vec2(-dirB.y, dirB.x);
+      float turn = dirA.x * dirB.y - dirA.y * dirB.x;
+      float outer = turn > 0.0 ? -1.0 : 1.0;
+
+      vec2 cornerA = s1 + outer * nrmA * halfWidth;
+      vec2 cornerB = s1 + outer * nrmB * halfWidth;
+      vec2 miter   = nrmA + nrmB;
+      float cosine = dot(miter, miter) > 1.0e-12 ? dot(normalize(miter), nrmA) : 0.0;
+      vec2 tip     = 0.5 * (cornerA + cornerB);
+      if (cosine > 1.0 / MITER_LIMIT)
+         tip = s1 + outer * normalize(miter) * halfWidth / cosine;
+
+      vec2 s = gl_VertexID == 0 ? s1 :
+               gl_VertexID == 1 ? cornerA :
+               gl_VertexID == 2 ? cornerB : tip;
+      // distances from the center lines of both segments
+      stroke       = vec2(dot(s - s1, outer * nrmA), dot(s - s1, outer * nrmB));
+      strokeLength = 0.0;
+      hpoint       = vec4(p1, 1);
+      pervcol      = vec4(c1, a1);
+      gl_Position  = toClip(s, clip1);
+   }
+}
@@ -0,0 +1,26 @@
+#version 330
+
+uniform mat4 transform;
+uniform int seriesLength;
+uniform float psize;
+uniform samplerBuffer colors;
+uniform samplerBuffer alphas;
+
+in vec3 point;
+
+out vec4 hpoint;
+out vec4 pervcol;
+
+void main(void)
+{
+   // series are laid out one after the other, every series
+   // has room for seriesLength points in the vertex buffer
+   int series  = gl_VertexID / seriesLength;
+   pervcol     = vec4(texelFetch(colors, 3*series  ).r,
+                      texelFetch(colors, 3*series+1).r,
+                      texelFetch(colors, 3*series+2).r,
+                      texelFetch(alphas, series).r);
+   hpoint      = vec4(point.xyz, 1);
+   gl_Position = transform * hpoint;
+   gl_PointSize = psize;
+}
@@ -0,0 +1,49 @@
+#version 330
+
+/* origin of every axis, split into three floats like the points below */
+uniform vec3 origin[3];
+
+/* doubles as pairs of 32 bit words, least significant word first */
+in uvec4 pointXY;
+in uvec2 pointZ;
+
+#ifdef DIM3
+out vec3 relative;
+#else
+out vec2 relative;
+#endif
+
+float exp2i(int e)
+{
+   // 2^e built from its bits, zero below the range of normal floats
+   return e < -126 ? 0.0 : uintBitsToFloat(uint(min(e, 128) + 127) << 23);
+}
+
+float relativeTo(uvec2 words, vec3 org)
+{
+   int e = int((words.y >> 20) & 0x7FFu) - 1075;
+   // zero and subnormals
+   if (e == -1075)
+      return -org.x - org.y - org.z;
+   float s = (words.y & 0x80000000u) != 0u ? -1.0 : 1.0;
+   // top 24, next 24 and last 5 bits of the 53 bit significand, each
+   // exact as a float. Differences of parts with equal exponents are
+   // exact too, hence only the final sums round
+   uint hi  = (((words.y & 0xFFFFFu) | 0x100000u) << 3) | (words.x >> 29);
+   uint mid = (words.x >> 5) & 0xFFFFFFu;
+   uint lo  = words.x & 0x1Fu;
+   float dHi  = s * float(hi)  * exp2i(e + 29) - org.x;
+   float dMid = s * float(mid) * exp2i(e + 5)  - org.y;
+   float dLo  = s * float(lo)  * exp2i(e)      - org.z;
+   return (dHi + dMid) + dLo;
+}
+
+void main(void)
+{
+   relative.x = relativeTo(pointXY.xy, origin[0]);
+   relative.y = relativeTo(pointXY.zw, origin[1]);
+#ifdef DIM3
+   relative.z = relativeTo(pointZ, origin[2]);
+#endif
+   gl_Position = vec4(0, 0, 0, 1);
+}
@@ -0,0 +1,18 @@
+#version 330
+
+layout(location = 0) in vec2 pos;
+layout(location = 1) in vec2 tex;
+
+uniform mat4 matrix;
+uniform vec2 texoffset;
+uniform vec2 texscale;
+
+out vec2 texcoord;
+
+void main()
+{
+    // tiles along right and bottom edges of the image and
+    // regions drawn from coarser tiles use part of a texture
+    texcoord = texoffset + tex * texscale;
+    gl_Position = matrix * vec4(pos, 0.0, 1.0);
+}
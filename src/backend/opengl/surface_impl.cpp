@@ -9,7 +9,9 @@
 
 #include <common.hpp>
 #include <err_opengl.hpp>
+#include <profiler_impl.hpp>
 #include <surface_impl.hpp>
+#include <trace_impl.hpp>
 #include <shader_headers/marker_fs.hpp>
 #include <shader_headers/plot3_vs.hpp>
 #include <shader_headers/plot3_fs.hpp>
@@ -57,7 +59,7 @@ if (mVAOMap.find(pWindowId) == mVAOMap.end()) {
     // attach plot vertices
     glEnableVertexAttribArray(mSurfPointIndex);
     glBindBuffer(GL_ARRAY_BUFFER, mVBO);
-    glVertexAttribPointer(mSurfPointIndex, 3, mDataType, GL_FALSE, 0, 0);
+    glVertexAttribPointer(mSurfPointIndex, 3, mDataType, mNormalized, 0, 0);
     glEnableVertexAttribArray(mSurfColorIndex);
     glBindBuffer(GL_ARRAY_BUFFER, mCBO);
     glVertexAttribPointer(mSurfColorIndex, 3, GL_FLOAT, GL_FALSE, 0, 0);
@@ -119,6 +121,7 @@ void surface_impl::renderGraph(const int pWindowId, const glm::mat4& transform)
 
     bindResources(pWindowId);
     glDrawElements(GL_TRIANGLE_STRIP, mIBOSize, GL_UNSIGNED_SHORT, (void*)0 );
+    countDrawCall();
     unbindResources();
     glUseProgram(0);
 
@@ -134,6 +137,7 @@ void surface_impl::renderGraph(const int pWindowId, const glm::mat4& transform)
 
         bindResources(pWindowId);
         glDrawElements(GL_POINTS, mIBOSize, GL_UNSIGNED_SHORT, (void*)0);
+        countDrawCall();
         unbindResources();
 
         glUseProgram(0);
@@ -146,7 +150,7 @@ void surface_impl::renderGraph(const int pWindowId, const glm::mat4& transform)
 surface_impl::surface_impl(unsigned pNumXPoints, unsigned pNumYPoints,
                            fg::dtype pDataType, fg::MarkerType pMarkerType)
     : mNumXPoints(pNumXPoints),mNumYPoints(pNumYPoints), mDataType(dtype2gl(pDataType)),
-      mMarkerType(pMarkerType), mIBO(0), mIBOSize(0), mMarkerProgram(-1), mSurfProgram(-1),
+      mNormalized(isNormalized(pDataType)), mMarkerType(pMarkerType), mIBO(0), mIBOSize(0), mMarkerProgram(-1), mSurfProgram(-1),
       mMarkerMatIndex(-1), mMarkerPointIndex(-1), mMarkerColorIndex(-1), mMarkerAlphaIndex(-1),
       mMarkerPVCIndex(-1), mMarkerPVAIndex(-1), mMarkerTypeIndex(-1), mMarkerColIndex(-1),
       mSurfMatIndex(-1), mSurfRangeIndex(-1), mSurfPointIndex(-1), mSurfColorIndex(-1),
@@ -196,8 +200,10 @@ surface_impl::surface_impl(unsigned pNumXPoints, unsigned pNumYPoints,
         case GL_UNSIGNED_INT   : SURF_CREATE_BUFFERS(uint)  ; break;
         case GL_SHORT          : SURF_CREATE_BUFFERS(short) ; break;
         case GL_UNSIGNED_SHORT : SURF_CREATE_BUFFERS(ushort); break;
-        case GL_UNSIGNED_BYTE  : SURF_CREATE_BUFFERS(float) ; break;
-        default: fg::TypeError("surface_impl::surface_impl", __LINE__, 1, pDataType);
+        case GL_HALF_FLOAT     : SURF_CREATE_BUFFERS(ushort); break;
+        case GL_BYTE           : SURF_CREATE_BUFFERS(char)  ; break;
+        case GL_UNSIGNED_BYTE  : SURF_CREATE_BUFFERS(uchar) ; break;
+        default: throw fg::TypeError("surface_impl::surface_impl", __LINE__, 1, pDataType);
     }
 
 #undef SURF_CREATE_BUFFERS
@@ -231,6 +237,8 @@ void surface_impl::render(const int pWindowId,
                           const glm::mat4& pView)
 {
     CheckGL("Begin surface_impl::render");
+    ProfileScope scope(FG_STAT_RENDERABLE, this, mLegend);
+    FG_TRACE_GPU_SCOPE("surface_impl::render");
     // FIXME: even when per vertex alpha is enabled
     // primitives of transparent object should be sorted
     // from the furthest to closest primitive
@@ -263,6 +271,7 @@ void scatter3_impl::renderGraph(const int pWindowId, const glm::mat4& transform)
 
         bindResources(pWindowId);
         glDrawElements(GL_POINTS, mIBOSize, GL_UNSIGNED_SHORT, (void*)0);
+        countDrawCall();
         unbindResources();
 
         glUseProgram(0);
@@ -25,6 +25,7 @@ class surface_impl : public AbstractRenderable {
         GLuint    mNumXPoints;
         GLuint    mNumYPoints;
         GLenum    mDataType;
+        GLboolean mNormalized;
         bool      mIsPVCOn;
         bool      mIsPVAOn;
         fg::MarkerType mMarkerType;
@@ -0,0 +1,684 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <common.hpp>
+#include <colormap_impl.hpp>
+#include <err_opengl.hpp>
+#include <profiler_impl.hpp>
+#include <tiled_image_impl.hpp>
+#include <trace_impl.hpp>
+#include <shader_headers/tiled_image_vs.hpp>
+#include <shader_headers/image_fs.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+namespace opengl
+{
+
+const uint tiled_image_impl::TILE_SIZE;
+
+static const uint LEVEL_SHIFT = 48;
+static const uint ROW_SHIFT   = 24;
+static const unsigned long long INDEX_MASK = (1ull << ROW_SHIFT) - 1;
+
+static inline
+unsigned long long tileKey(const uint pLevel, const uint pTileX, const uint pTileY)
+{
+    return ((unsigned long long)pLevel << LEVEL_SHIFT) |
+           ((unsigned long long)pTileY << ROW_SHIFT) | pTileX;
+}
+
+static inline
+void decodeTileKey(const unsigned long long pKey, uint& pLevel, uint& pTileX, uint& pTileY)
+{
+    pLevel = (uint)(pKey >> LEVEL_SHIFT);
+    pTileY = (uint)((pKey >> ROW_SHIFT) & INDEX_MASK);
+    pTileX = (uint)(pKey & INDEX_MASK);
+}
+
+/* largest number of source pixels, along each axis, that
+ * are averaged into one pixel of a coarser level */
+static const uint MAX_FILTER_TAPS = 8;
+
+static float halfToFloat(const ushort pValue)
+{
+    const uint sign = (pValue & 0x8000u) << 16;
+    const uint exp  = (pValue >> 10) & 0x1f;
+    const uint mant = pValue & 0x3ff;
+    float result;
+    if (exp == 0)
+        result = std::ldexp(float(mant), -24);
+    else if (exp == 31)
+        result = mant ? NAN : INFINITY;
+    else
+        result = std::ldexp(float(mant | 0x400), int(exp) - 25);
+    return sign ? -result : result;
+}
+
+static ushort floatToHalf(const float pValue)
+{
+    const ushort sign = std::signbit(pValue) ? 0x8000 : 0;
+    const float  mag  = std::fabs(pValue);
+    if (std::isnan(mag))
+        return 0x7e00;
+    if (mag >= 65520.0f)
+        return sign | 0x7c00;
+    if (mag < std::ldexp(1.0f, -14))
+        return sign | (ushort)std::lround(std::ldexp(mag, 24));
+    int exp;
+    const float frac = std::frexp(mag, &exp);
+    /* rounding may carry into the exponent, which the bit layout absorbs */
+    return sign | (ushort)(((exp + 14) << 10) + std::lround(std::ldexp(frac, 11)) - 1024);
+}
+
+static double loadValue(const uchar* pSrc, const GLenum pType)
+{
+    switch(pType) {
+        case GL_INT:            return *(const int*   )pSrc;
+        case GL_UNSIGNED_INT:   return *(const uint*  )pSrc;
+        case GL_SHORT:          return *(const short* )pSrc;
+        case GL_UNSIGNED_SHORT: return *(const ushort*)pSrc;
+        case GL_HALF_FLOAT:     return halfToFloat(*(const ushort*)pSrc);
+        case GL_BYTE:           return *(const char*  )pSrc;
+        case GL_UNSIGNED_BYTE:  return *(const uchar* )pSrc;
+        default:                return *(const float* )pSrc;
+    }
+}
+
+static void storeValue(uchar* pDst, const GLenum pType, const double pValue)
+{
+    const double rounded = std::floor(pValue + 0.5);
+    switch(pType) {
+        case GL_INT:            *(int*   )pDst = (int   )rounded; break;
+        case GL_UNSIGNED_INT:   *(uint*  )pDst = (uint  )rounded; break;
+        case GL_SHORT:          *(short* )pDst = (short )rounded; break;
+        case GL_UNSIGNED_SHORT: *(ushort*)pDst = (ushort)rounded; break;
+        case GL_HALF_FLOAT:     *(ushort*)pDst = floatToHalf((float)pValue); break;
+        case GL_BYTE:           *(char*  )pDst = (char  )rounded; break;
+        case GL_UNSIGNED_BYTE:  *(uchar* )pDst = (uchar )rounded; break;
+        default:                *(float* )pDst = (float )pValue; break;
+    }
+}
+
+void tiled_image_impl::init()
+{
+    CheckGL("Begin tiled_image_impl::init");
+    if (mDataType == fg::f64)
+        throw fg::TypeError("tiled_image_impl::tiled_image_impl", __LINE__, 4, mDataType);
+
+    size_t typeSize = 0;
+    switch(mGLType) {
+        case GL_INT:            typeSize = sizeof(int   ); break;
+        case GL_UNSIGNED_INT:   typeSize = sizeof(uint  ); break;
+        case GL_SHORT:          typeSize = sizeof(short ); break;
+        case GL_UNSIGNED_SHORT: typeSize = sizeof(ushort); break;
+        case GL_HALF_FLOAT:     typeSize = sizeof(ushort); break;
+        case GL_BYTE:           typeSize = sizeof(char  ); break;
+        case GL_UNSIGNED_BYTE:  typeSize = sizeof(uchar ); break;
+        default: typeSize = sizeof(float); break;
+    }
+    uint numChannels = 1;
+    switch(mFormat) {
+        case FG_GRAYSCALE: numChannels = 1;   break;
+        case FG_RG:        numChannels = 2;   break;
+        case FG_RGB:       numChannels = 3;   break;
+        case FG_BGR:       numChannels = 3;   break;
+        case FG_RGBA:      numChannels = 4;   break;
+        case FG_BGRA:      numChannels = 4;   break;
+        /* subsampled and mosaic formats can not be split into tiles */
+        default:
+            throw fg::ArgumentError("tiled_image_impl::tiled_image_impl", __LINE__, 3,
+                                    "Tiled images support only grayscale, RG, RGB and RGBA formats");
+    }
+    mNumChannels = numChannels;
+    mPixelSize   = numChannels * typeSize;
+
+    mNumLevels = 1;
+    while (std::max(levelWidth(mNumLevels-1), levelHeight(mNumLevels-1)) > TILE_SIZE)
+        mNumLevels++;
+
+    std::string fragShader = glsl::image_fs;
+    if (isIntegerTexture(mDataType))
+        fragShader = addShaderDefines(fragShader, mDataType==fg::u32 ? "#define SAMPLER usampler2D"
+                                                                 : "#define SAMPLER isampler2D");
+
+    mProgram        = initShaders(glsl::tiled_image_vs.c_str(), fragShader.c_str());
+    mMatIndex       = glGetUniformLocation(mProgram, "matrix");
+    mTexOffsetIndex = glGetUniformLocation(mProgram, "texoffset");
+    mTexScaleIndex  = glGetUniformLocation(mProgram, "texscale");
+    mCMapIndex      = glGetUniformLocation(mProgram, "cmap");
+    mCMapLenIndex   = glGetUniformLocation(mProgram, "cmaplen");
+    mTexIndex       = glGetUniformLocation(mProgram, "tex");
+    mNumCIndex      = glGetUniformLocation(mProgram, "numcomps");
+    mAlphaIndex     = glGetUniformLocation(mProgram, "alpha");
+
+    /* values of normalized and float textures in [0, 1] map as is,
+     * 32 bit integer textures span the full range of their type */
+    float maxValue = 1.0f;
+    if (mDataType == fg::s32)
+        maxValue = 2147483647.0f;
+    else if (mDataType == fg::u32)
+        maxValue = 4294967295.0f;
+    glUseProgram(mProgram);
+    glUniform1f(glGetUniformLocation(mProgram, "valscale"), 1.0f);
+    glUniform2f(glGetUniformLocation(mProgram, "range"), 0.0f, maxValue);
+    glUniform1f(glGetUniformLocation(mProgram, "gamma"), 1.0f);
+    glUniform1i(glGetUniformLocation(mProgram, "uselog"), 0);
+    glUniform1f(glGetUniformLocation(mProgram, "alphamax"), maxValue);
+    glUseProgram(0);
+    CheckGL("End tiled_image_impl::init");
+}
+
+void tiled_image_impl::loadTiles()
+{
+    while (true) {
+        TileKey key;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this] { return mStop || !mRequests.empty(); });
+            if (mStop)
+                return;
+            key = mRequests.front();
+            mRequests.pop_front();
+        }
+
+        uint level, tx, ty;
+        decodeTileKey(key, level, tx, ty);
+
+        LoadedTile tile;
+        tile.mKey    = key;
+        tile.mWidth  = std::min(TILE_SIZE, levelWidth(level)  - tx * TILE_SIZE);
+        tile.mHeight = std::min(TILE_SIZE, levelHeight(level) - ty * TILE_SIZE);
+        tile.mData.resize(tile.mWidth * tile.mHeight * mPixelSize);
+
+        if (mLoader)
+            mLoader(tile.mData.data(), level, tx, ty, tile.mWidth, tile.mHeight, mUserData);
+        else
+            readFromFile(tile.mData.data(), level, tx, ty, tile.mWidth, tile.mHeight);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mLoaded.push_back(std::move(tile));
+    }
+}
+
+void tiled_image_impl::readFromFile(uchar* pOut, const uint pLevel,
+                                    const uint pTileX, const uint pTileY,
+                                    const uint pTileW, const uint pTileH) const
+{
+    const uchar* src  = mFile->data();
+    const size_t step = size_t(1) << pLevel;
+    const size_t x0   = size_t(pTileX) * TILE_SIZE * step;
+    const size_t y0   = size_t(pTileY) * TILE_SIZE * step;
+
+    if (pLevel == 0) {
+        for (uint j = 0; j < pTileH; ++j)
+            memcpy(pOut + size_t(j) * pTileW * mPixelSize,
+                   src + ((y0 + j) * mWidth + x0) * mPixelSize, pTileW * mPixelSize);
+        return;
+    }
+
+    /* coarser levels are generated on the fly by box filtering the
+     * 2^level wide square of full resolution pixels each one covers.
+     * Wide squares are averaged over evenly spaced taps, which keeps
+     * the cost of a tile bounded irrespective of the level */
+    const uint   taps       = (uint)std::min(step, size_t(MAX_FILTER_TAPS));
+    const size_t channels   = mNumChannels;
+    const size_t typeSize   = mPixelSize / channels;
+    std::vector<size_t> offsets(taps);
+    for (uint t = 0; t < taps; ++t)
+        offsets[t] = (t * step) / taps + step / (2 * taps);
+
+    std::vector<double> sums(channels);
+    for (uint j = 0; j < pTileH; ++j) {
+        uchar* dstRow = pOut + size_t(j) * pTileW * mPixelSize;
+        for (uint i = 0; i < pTileW; ++i) {
+            std::fill(sums.begin(), sums.end(), 0.0);
+            for (uint ty = 0; ty < taps; ++ty) {
+                size_t y = std::min(y0 + j * step + offsets[ty], size_t(mHeight - 1));
+                const uchar* srcRow = src + y * mWidth * mPixelSize;
+                for (uint tx = 0; tx < taps; ++tx) {
+                    size_t x = std::min(x0 + i * step + offsets[tx], size_t(mWidth - 1));
+                    const uchar* pixel = srcRow + x * mPixelSize;
+                    for (size_t c = 0; c < channels; ++c)
+                        sums[c] += loadValue(pixel + c * typeSize, mGLType);
+                }
+            }
+            uchar* dst = dstRow + i * mPixelSize;
+            for (size_t c = 0; c < channels; ++c)
+                storeValue(dst + c * typeSize, mGLType, sums[c] / (taps * taps));
+        }
+    }
+}
+
+uint tiled_image_impl::levelWidth(const uint pLevel) const
+{
+    return (mWidth + (1u << pLevel) - 1) >> pLevel;
+}
+
+uint tiled_image_impl::levelHeight(const uint pLevel) const
+{
+    return (mHeight + (1u << pLevel) - 1) >> pLevel;
+}
+
+std::map<tiled_image_impl::TileKey, tiled_image_impl::CachedTile>::iterator
+tiled_image_impl::findResident(const uint pLevel, const uint pTileX, const uint pTileY,
+                               uint& pFoundLevel)
+{
+    for (uint l = pLevel; l < mNumLevels; ++l) {
+        const uint shift = l - pLevel;
+        auto it = mCache.find(tileKey(l, pTileX >> shift, pTileY >> shift));
+        if (it != mCache.end()) {
+            pFoundLevel = l;
+            return it;
+        }
+    }
+    return mCache.end();
+}
+
+GLuint tiled_image_impl::acquireTexture()
+{
+    GLuint tex = 0;
+    if (mCache.size() < mMaxTiles) {
+        glGenTextures(1, &tex);
+        glBindTexture(GL_TEXTURE_2D, tex);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D, 0, mGLiformat, TILE_SIZE, TILE_SIZE, 0,
+                     mGLformat, mGLType, NULL);
+    } else {
+        /* evict the least recently drawn tile, tiles
+         * pinned for the current frame are left alone */
+        auto lru = mCache.end();
+        for (auto it = mCache.begin(); it != mCache.end(); ++it) {
+            if (it->second.mLastUsed < mFrame &&
+                (lru == mCache.end() || it->second.mLastUsed < lru->second.mLastUsed))
+                lru = it;
+        }
+        if (lru == mCache.end())
+            return 0;
+        tex = lru->second.mTex;
+        mCache.erase(lru);
+        glBindTexture(GL_TEXTURE_2D, tex);
+    }
+    return tex;
+}
+
+void tiled_image_impl::uploadTiles()
+{
+    std::vector<LoadedTile> tiles;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        size_t count = std::min(mLoaded.size(), size_t(mMaxUploads));
+        for (size_t i = 0; i < count; ++i) {
+            mInFlight.erase(mLoaded[i].mKey);
+            tiles.push_back(std::move(mLoaded[i]));
+        }
+        mLoaded.erase(mLoaded.begin(), mLoaded.begin() + count);
+    }
+
+    if (tiles.empty())
+        return;
+
+    ProfileScope scope(FG_STAT_UPLOAD, this);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        const LoadedTile& tile = tiles[i];
+        GLuint tex = acquireTexture();
+        /* cache is full of tiles drawn in this frame, the tile is
+         * requested again only if there is room for it later */
+        if (tex == 0)
+            continue;
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, tile.mWidth, tile.mHeight,
+                        mGLformat, mGLType, tile.mData.data());
+        countUploadBytes(tile.mData.size());
+        CachedTile entry = {tex, tile.mWidth, tile.mHeight, mFrame};
+        mCache[tile.mKey] = entry;
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+tiled_image_impl::tiled_image_impl(const uint pWidth, const uint pHeight,
+                                   const fg::ChannelFormat pFormat, const fg::dtype pDataType,
+                                   fg_tile_loader pLoader, void* pUserData)
+    : mWidth(pWidth), mHeight(pHeight), mNumLevels(1), mFormat(pFormat),
+      mGLformat(ctype2gl(mFormat, pDataType)), mGLiformat(ictype2gl(mFormat, pDataType)),
+      mDataType(pDataType), mGLType(dtype2gl(mDataType)), mNumChannels(1), mPixelSize(1),
+      mAlpha(1.0f), mKeepARatio(true), mLoader(pLoader), mUserData(pUserData),
+      mMaxTiles(512), mMaxUploads(16), mFrame(0), mProgram(0), mMatIndex(-1),
+      mTexIndex(-1), mTexOffsetIndex(-1), mTexScaleIndex(-1), mNumCIndex(-1), mAlphaIndex(-1),
+      mCMapLenIndex(-1), mCMapIndex(-1), mCMapTex(0), mCMapLen(0), mUserCMap(0), mUserCMapLen(0),
+      mStop(false)
+{
+    if (pLoader == NULL)
+        throw fg::ArgumentError("tiled_image_impl::tiled_image_impl", __LINE__, 5,
+                                "Tile loader function can't be NULL");
+    init();
+    mWorker = std::thread(&tiled_image_impl::loadTiles, this);
+}
+
+tiled_image_impl::tiled_image_impl(const char* pFilePath,
+                                   const uint pWidth, const uint pHeight,
+                                   const fg::ChannelFormat pFormat, const fg::dtype pDataType)
+    : mWidth(pWidth), mHeight(pHeight), mNumLevels(1), mFormat(pFormat),
+      mGLformat(ctype2gl(mFormat, pDataType)), mGLiformat(ictype2gl(mFormat, pDataType)),
+      mDataType(pDataType), mGLType(dtype2gl(mDataType)), mNumChannels(1), mPixelSize(1),
+      mAlpha(1.0f), mKeepARatio(true), mLoader(NULL), mUserData(NULL),
+      mMaxTiles(512), mMaxUploads(16), mFrame(0), mProgram(0), mMatIndex(-1),
+      mTexIndex(-1), mTexOffsetIndex(-1), mTexScaleIndex(-1), mNumCIndex(-1), mAlphaIndex(-1),
+      mCMapLenIndex(-1), mCMapIndex(-1), mCMapTex(0), mCMapLen(0), mUserCMap(0), mUserCMapLen(0),
+      mStop(false)
+{
+    if (pFilePath == NULL)
+        throw fg::ArgumentError("tiled_image_impl::tiled_image_impl", __LINE__, 0,
+                                "Empty path string");
+    mFile.reset(new MappedFile(pFilePath));
+    init();
+    if (mFile->size() < size_t(mWidth) * mHeight * mPixelSize) {
+        glDeleteProgram(mProgram);
+        throw fg::ArgumentError("tiled_image_impl::tiled_image_impl", __LINE__, 0,
+                                "File is smaller than the image dimensions");
+    }
+    mWorker = std::thread(&tiled_image_impl::loadTiles, this);
+}
+
+tiled_image_impl::~tiled_image_impl()
+{
+    CheckGL("Begin tiled_image_impl::~tiled_image_impl");
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mCondition.notify_one();
+    if (mWorker.joinable())
+        mWorker.join();
+
+    for (auto it = mCache.begin(); it != mCache.end(); ++it) {
+        GLuint tex = it->second.mTex;
+        glDeleteTextures(1, &tex);
+    }
+    if (mUserCMap)
+        glDeleteTextures(1, &mUserCMap);
+    glDeleteProgram(mProgram);
+    CheckGL("End tiled_image_impl::~tiled_image_impl");
+}
+
+void tiled_image_impl::setColorMapParams(const GLuint pTexture, const GLuint pLength)
+{
+    mCMapTex = pTexture;
+    mCMapLen = pLength;
+}
+
+void tiled_image_impl::setColorMap(const float* pRGBA, const size_t pLength)
+{
+    if (mUserCMap) {
+        glDeleteTextures(1, &mUserCMap);
+        mUserCMap    = 0;
+        mUserCMapLen = 0;
+    }
+    /* null color map reverts to the color map of window */
+    if (pRGBA != NULL) {
+        mUserCMap    = createColorMapTexture(pRGBA, pLength);
+        mUserCMapLen = (GLuint)pLength;
+    }
+    ++mVersion;
+}
+
+void tiled_image_impl::setAlpha(const float pAlpha)
+{
+    mAlpha = pAlpha;
+    ++mVersion;
+}
+
+void tiled_image_impl::keepAspectRatio(const bool pKeep)
+{
+    if (mKeepARatio != pKeep) {
+        mKeepARatio = pKeep;
+        ++mVersion;
+    }
+}
+
+void tiled_image_impl::setCacheSize(const uint pMaxTiles)
+{
+    if (pMaxTiles == 0)
+        throw fg::ArgumentError("tiled_image_impl::setCacheSize", __LINE__, 1,
+                                "Cache should hold atleast one tile");
+    mMaxTiles = pMaxTiles;
+    while (mCache.size() > mMaxTiles) {
+        auto lru = mCache.begin();
+        for (auto it = mCache.begin(); it != mCache.end(); ++it) {
+            if (it->second.mLastUsed < lru->second.mLastUsed)
+                lru = it;
+        }
+        GLuint tex = lru->second.mTex;
+        glDeleteTextures(1, &tex);
+        mCache.erase(lru);
+    }
+}
+
+unsigned long long tiled_image_impl::version()
+{
+    /* finer tiles replace coarser ones over the
+     * next frames while loads are pending */
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mRequests.empty() || !mInFlight.empty() || !mLoaded.empty())
+        ++mVersion;
+    return mVersion;
+}
+
+uint tiled_image_impl::width() const { return mWidth; }
+
+uint tiled_image_impl::height() const { return mHeight; }
+
+uint tiled_image_impl::levels() const { return mNumLevels; }
+
+void tiled_image_impl::render(const int pWindowId,
+                              const int pX, const int pY, const int pVPW, const int pVPH,
+                              const glm::mat4 &pView)
+{
+    CheckGL("Begin tiled_image_impl::render");
+    ProfileScope scope(FG_STAT_RENDERABLE, this, mLegend);
+    FG_TRACE_GPU_SCOPE("tiled_image_impl::render");
+    mFrame++;
+
+    float xscale = 1.f;
+    float yscale = 1.f;
+    if (mKeepARatio) {
+        if (mWidth > mHeight) {
+            float trgtH = pVPW * float(mHeight)/float(mWidth);
+            float trgtW = trgtH * float(mWidth)/float(mHeight);
+            xscale = trgtW/pVPW;
+            yscale = trgtH/pVPH;
+        } else {
+            float trgtW = pVPH * float(mWidth)/float(mHeight);
+            float trgtH = trgtW * float(mHeight)/float(mWidth);
+            xscale = trgtW/pVPW;
+            yscale = trgtH/pVPH;
+        }
+    }
+
+    glm::mat4 strans = glm::scale(pView, glm::vec3(xscale, yscale, 1));
+
+    /* pick the pyramid level whose resolution is closest
+     * to the number of pixels the image covers on screen */
+    float screenW = std::sqrt(strans[0][0]*strans[0][0] + strans[0][1]*strans[0][1]) * pVPW;
+    float texelsPerPixel = mWidth / std::max(screenW, 1.0f);
+    uint level = 0;
+    if (texelsPerPixel > 1.0f)
+        level = std::min(uint(std::floor(std::log2(texelsPerPixel))), mNumLevels - 1);
+
+    /* find the region of the image, in full resolution pixels,
+     * that is visible in the viewport */
+    glm::mat4 inv = glm::inverse(strans);
+    float minX =  2.0f, minY =  2.0f;
+    float maxX = -2.0f, maxY = -2.0f;
+    static const float corners[4][2] = {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+    for (int i = 0; i < 4; ++i) {
+        glm::vec4 p = inv * glm::vec4(corners[i][0], corners[i][1], 0, 1);
+        minX = std::min(minX, p.x / p.w); maxX = std::max(maxX, p.x / p.w);
+        minY = std::min(minY, p.y / p.w); maxY = std::max(maxY, p.y / p.w);
+    }
+    float px0 = std::max(0.0f, (minX + 1.0f) * 0.5f * mWidth );
+    float px1 = std::min(float(mWidth ), (maxX + 1.0f) * 0.5f * mWidth );
+    float py0 = std::max(0.0f, (1.0f - maxY) * 0.5f * mHeight);
+    float py1 = std::min(float(mHeight), (1.0f - minY) * 0.5f * mHeight);
+
+    /* tiles of the target level that cover the visible region */
+    const bool isVisible = (px0 < px1 && py0 < py1);
+    const uint span = TILE_SIZE << level;
+    const uint ntx  = (levelWidth(level)  + TILE_SIZE - 1) / TILE_SIZE;
+    const uint nty  = (levelHeight(level) + TILE_SIZE - 1) / TILE_SIZE;
+    const uint tx0  = std::min(uint(px0) / span, ntx - 1);
+    const uint tx1  = std::min(uint(std::ceil(px1)) / span, ntx - 1);
+    const uint ty0  = std::min(uint(py0) / span, nty - 1);
+    const uint ty1  = std::min(uint(std::ceil(py1)) / span, nty - 1);
+    const uint coarsest = mNumLevels - 1;
+
+    /* pin the tiles this frame draws before uploads evict any. A missing
+     * tile is requested along with its tile at the coarsest level, which
+     * is always a valid fallback, and drawn from its nearest coarser tile
+     * in cache until it arrives */
+    std::vector<TileKey> wanted;
+    std::set<TileKey> fallbacks;
+    if (isVisible) {
+        for (uint ty = ty0; ty <= ty1; ++ty) {
+            for (uint tx = tx0; tx <= tx1; ++tx) {
+                uint found = level;
+                auto it = findResident(level, tx, ty, found);
+                if (it != mCache.end())
+                    it->second.mLastUsed = mFrame;
+                if (it != mCache.end() && found == level)
+                    continue;
+                wanted.push_back(tileKey(level, tx, ty));
+                const uint shift = coarsest - level;
+                TileKey root = tileKey(coarsest, tx >> shift, ty >> shift);
+                if (level != coarsest && mCache.find(root) == mCache.end() &&
+                    fallbacks.insert(root).second)
+                    wanted.push_back(root);
+            }
+        }
+    }
+
+    /* a cache full of tiles drawn in this frame can't take any upload,
+     * requesting the missing tiles would only load and drop them again
+     * on every frame. The view is drawn from the resident tiles instead */
+    size_t pinned = 0;
+    for (auto it = mCache.begin(); it != mCache.end(); ++it) {
+        if (it->second.mLastUsed == mFrame)
+            pinned++;
+    }
+    if (pinned >= mMaxTiles)
+        wanted.clear();
+
+    uploadTiles();
+
+    /* tiles cover disjoint regions of the image, the depth of
+     * other renderables isn't disturbed by drawing them */
+    glDepthMask(GL_FALSE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glUseProgram(mProgram);
+
+    glUniform1i(mNumCIndex, (GLint)mNumChannels);
+    glUniform1f(mAlphaIndex, mAlpha);
+    GLuint cmapTex = mUserCMap ? mUserCMap    : mCMapTex;
+    GLuint cmapLen = mUserCMap ? mUserCMapLen : mCMapLen;
+    glUniform1f(mCMapLenIndex, (GLfloat)cmapLen);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_1D, cmapTex);
+    glUniform1i(mCMapIndex, 1);
+    glActiveTexture(GL_TEXTURE0);
+    glUniform1i(mTexIndex, 0);
+
+    glBindVertexArray(screenQuadVAO(pWindowId));
+
+    if (isVisible) {
+        for (uint ty = ty0; ty <= ty1; ++ty) {
+            for (uint tx = tx0; tx <= tx1; ++tx) {
+                uint found = level;
+                auto it = findResident(level, tx, ty, found);
+                if (it == mCache.end())
+                    continue;
+                const CachedTile& tile = it->second;
+
+                /* region of the target tile in full resolution pixels */
+                float x0 = float(tx * span);
+                float y0 = float(ty * span);
+                float x1 = std::min(float(mWidth ), x0 + float(span));
+                float y1 = std::min(float(mHeight), y0 + float(span));
+                float nx0 = 2.0f * x0 / mWidth  - 1.0f;
+                float nx1 = 2.0f * x1 / mWidth  - 1.0f;
+                float ny0 = 1.0f - 2.0f * y0 / mHeight;
+                float ny1 = 1.0f - 2.0f * y1 / mHeight;
+
+                glm::mat4 model = glm::translate(strans,
+                                                 glm::vec3((nx0+nx1)/2, (ny0+ny1)/2, 0));
+                model = glm::scale(model, glm::vec3((nx1-nx0)/2, (ny0-ny1)/2, 1));
+
+                /* the part of the found tile's texture that covers the region */
+                const uint  shift = found - level;
+                const float extent = float(TILE_SIZE << found);
+                const float ox = float((tx >> shift) * (TILE_SIZE << found));
+                const float oy = float((ty >> shift) * (TILE_SIZE << found));
+
+                glUniformMatrix4fv(mMatIndex, 1, GL_FALSE, glm::value_ptr(model));
+                glUniform2f(mTexOffsetIndex, (x0 - ox) / extent, (y0 - oy) / extent);
+                glUniform2f(mTexScaleIndex, (x1 - x0) / extent, (y1 - y0) / extent);
+                glBindTexture(GL_TEXTURE_2D, tile.mTex);
+                glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+                countDrawCall();
+            }
+        }
+    }
+
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_1D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glUseProgram(0);
+    glDisable(GL_BLEND);
+    glDepthMask(GL_TRUE);
+
+    /* coarsest level tiles are loaded first as they
+     * are the fallback for every region of the image */
+    std::stable_partition(wanted.begin(), wanted.end(), [this](const TileKey pKey) {
+            return (pKey >> LEVEL_SHIFT) == mNumLevels - 1;
+        });
+
+    /* replace pending requests with the tiles needed
+     * for current view, tiles already being loaded are kept */
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto it = mRequests.begin(); it != mRequests.end(); ++it)
+            mInFlight.erase(*it);
+        mRequests.clear();
+        for (size_t i = 0; i < wanted.size(); ++i) {
+            if (mInFlight.insert(wanted[i]).second)
+                mRequests.push_back(wanted[i]);
+        }
+    }
+    if (!wanted.empty())
+        mCondition.notify_one();
+
+    CheckGL("End tiled_image_impl::render");
+}
+
+}
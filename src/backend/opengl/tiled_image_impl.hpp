@@ -0,0 +1,148 @@
+/*******************************************************
+* Copyright (c) 2015-2019, ArrayFire
+* All rights reserved.
+*
+* This file is distributed under 3-clause BSD license.
+* The complete license agreement can be obtained at:
+* http://arrayfire.com/licenses/BSD-3-Clause
+********************************************************/
+
+#pragma once
+
+#include <common.hpp>
+#include <util.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace opengl
+{
+
+/* Renders images that are too large to fit in a single texture
+ *
+ * The image is split into a pyramid of tiles, level zero is the
+ * full resolution image and each following level is half the size
+ * of the previous one. Tiles visible in the current view are fetched
+ * by a background thread either from an user supplied loader or from a
+ * memory mapped file and uploaded into a fixed size cache of textures.
+ * Regions whose tiles are not in cache yet are drawn from the nearest
+ * coarser tile that is, tiles drawn in a frame are never evicted by
+ * uploads of the same frame.
+ */
+class tiled_image_impl : public AbstractRenderable {
+    public:
+        static const uint TILE_SIZE = 256;
+
+    private:
+        typedef unsigned long long TileKey;
+
+        struct CachedTile {
+            GLuint mTex;
+            uint   mWidth;
+            uint   mHeight;
+            unsigned long long mLastUsed;
+        };
+
+        struct LoadedTile {
+            TileKey mKey;
+            uint    mWidth;
+            uint    mHeight;
+            std::vector<uchar> mData;
+        };
+
+        uint   mWidth;
+        uint   mHeight;
+        uint   mNumLevels;
+        fg::ChannelFormat mFormat;
+        GLenum mGLformat;
+        GLenum mGLiformat;
+        fg::dtype mDataType;
+        GLenum mGLType;
+        uint   mNumChannels;
+        size_t mPixelSize;
+        float  mAlpha;
+        bool   mKeepARatio;
+        /* tile sources */
+        fg_tile_loader mLoader;
+        void*          mUserData;
+        std::unique_ptr<MappedFile> mFile;
+        /* texture cache */
+        uint   mMaxTiles;
+        uint   mMaxUploads;
+        unsigned long long mFrame;
+        std::map<TileKey, CachedTile> mCache;
+        /* shader program and its attributes */
+        GLuint mProgram;
+        GLuint mMatIndex;
+        GLuint mTexIndex;
+        GLuint mTexOffsetIndex;
+        GLuint mTexScaleIndex;
+        GLuint mNumCIndex;
+        GLuint mAlphaIndex;
+        GLuint mCMapLenIndex;
+        GLuint mCMapIndex;
+        /* color map details, mUserCMap when set
+         * overrides the color map of window */
+        GLuint mCMapTex;
+        GLuint mCMapLen;
+        GLuint mUserCMap;
+        GLuint mUserCMapLen;
+        /* background loader thread state, members
+         * below are guarded by mMutex */
+        std::mutex                mMutex;
+        std::condition_variable   mCondition;
+        std::deque<TileKey>       mRequests;
+        std::set<TileKey>         mInFlight;
+        std::vector<LoadedTile>   mLoaded;
+        bool                      mStop;
+        std::thread               mWorker;
+
+        void init();
+        void loadTiles();
+        void readFromFile(uchar* pOut, const uint pLevel,
+                          const uint pTileX, const uint pTileY,
+                          const uint pTileW, const uint pTileH) const;
+
+        uint levelWidth(const uint pLevel) const;
+        uint levelHeight(const uint pLevel) const;
+        /* nearest tile at pLevel or coarser that is in cache, the
+         * level of the tile found is returned in pFoundLevel */
+        std::map<TileKey, CachedTile>::iterator findResident(const uint pLevel,
+                                                             const uint pTileX,
+                                                             const uint pTileY,
+                                                             uint& pFoundLevel);
+        void uploadTiles();
+        GLuint acquireTexture();
+
+    public:
+        tiled_image_impl(const uint pWidth, const uint pHeight,
+                         const fg::ChannelFormat pFormat, const fg::dtype pDataType,
+                         fg_tile_loader pLoader, void* pUserData);
+        tiled_image_impl(const char* pFilePath,
+                         const uint pWidth, const uint pHeight,
+                         const fg::ChannelFormat pFormat, const fg::dtype pDataType);
+        ~tiled_image_impl();
+
+        void setColorMapParams(const GLuint pTexture, const GLuint pLength);
+        void setColorMap(const float* pRGBA, const size_t pLength);
+        void setAlpha(const float pAlpha);
+        void keepAspectRatio(const bool pKeep=true);
+        void setCacheSize(const uint pMaxTiles);
+        unsigned long long version() override;
+
+        uint width() const;
+        uint height() const;
+        uint levels() const;
+
+        void render(const int pWindowId,
+                    const int pX, const int pY, const int pVPW, const int pVPH,
+                    const glm::mat4 &pView);
+};
+
+}
@@ -0,0 +1,274 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <common.hpp>
+#include <trace_impl.hpp>
+
+#include <cstdlib>
+
+#if defined(OS_WIN)
+#include <windows.h>
+#elif defined(OS_MAC)
+#include <pthread.h>
+#include <unistd.h>
+#else
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace opengl
+{
+
+static thread_local const void* currentContext = nullptr;
+
+/* GPU tracks are numbered above any thread id of the OS */
+static const unsigned GPU_TRACK_BASE = 2000000000u;
+
+static const size_t FLUSH_SIZE = 1 << 16;
+
+static unsigned long processId()
+{
+#if defined(OS_WIN)
+    return (unsigned long)GetCurrentProcessId();
+#else
+    return (unsigned long)getpid();
+#endif
+}
+
+static unsigned long threadId()
+{
+#if defined(OS_WIN)
+    return (unsigned long)GetCurrentThreadId();
+#elif defined(OS_MAC)
+    uint64_t tid = 0;
+    pthread_threadid_np(NULL, &tid);
+    return (unsigned long)tid;
+#else
+    return (unsigned long)syscall(SYS_gettid);
+#endif
+}
+
+static std::string escape(const char* pString)
+{
+    std::string result;
+    for (const char* c = pString; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            result += '\\';
+            result += *c;
+        } else if ((unsigned char)*c < 0x20) {
+            result += ' ';
+        } else {
+            result += *c;
+        }
+    }
+    return result;
+}
+
+trace_impl::trace_impl()
+    : mFile(nullptr), mFirst(true), mEpoch(Clock::now()), mPid(processId())
+{
+    const char* path = std::getenv("FG_TRACE_FILE");
+    if (path && *path) {
+        mFile = std::fopen(path, "w");
+        if (mFile)
+            std::fputs("[", mFile);
+        else
+            std::fprintf(stderr, "Forge: could not open trace file %s\n", path);
+    }
+}
+
+trace_impl::~trace_impl()
+{
+    if (!mFile)
+        return;
+    /* GPU spans still pending belong to contexts
+     * that are gone by now, they are dropped */
+    flush();
+    std::fputs("\n]\n", mFile);
+    std::fclose(mFile);
+}
+
+trace_impl& trace_impl::instance()
+{
+    static trace_impl tracer;
+    return tracer;
+}
+
+const void* trace_impl::context()
+{
+    return currentContext;
+}
+
+void trace_impl::setContext(const void* pContext)
+{
+    currentContext = pContext;
+}
+
+double trace_impl::now() const
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - mEpoch).count();
+}
+
+void trace_impl::append(const std::string& pEvent)
+{
+    mBuffer += mFirst ? "\n" : ",\n";
+    mBuffer += pEvent;
+    mFirst = false;
+    if (mBuffer.size() > FLUSH_SIZE)
+        flush();
+}
+
+void trace_impl::flush()
+{
+    std::fwrite(mBuffer.data(), 1, mBuffer.size(), mFile);
+    std::fflush(mFile);
+    mBuffer.clear();
+}
+
+void trace_impl::complete(const char* pName, const double pStart, const double pEnd)
+{
+    char event[512];
+    std::snprintf(event, sizeof(event),
+                  "{\"name\":\"%s\",\"cat\":\"forge\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                  "\"pid\":%lu,\"tid\":%lu}",
+                  escape(pName).c_str(), pStart, pEnd - pStart, mPid, threadId());
+    std::lock_guard<std::mutex> lock(mMutex);
+    append(event);
+}
+
+void trace_impl::begin(const char* pName)
+{
+    char event[512];
+    std::snprintf(event, sizeof(event),
+                  "{\"name\":\"%s\",\"cat\":\"user\",\"ph\":\"B\",\"ts\":%.3f,"
+                  "\"pid\":%lu,\"tid\":%lu}",
+                  escape(pName).c_str(), now(), mPid, threadId());
+    std::lock_guard<std::mutex> lock(mMutex);
+    append(event);
+}
+
+void trace_impl::end()
+{
+    char event[256];
+    std::snprintf(event, sizeof(event),
+                  "{\"ph\":\"E\",\"ts\":%.3f,\"pid\":%lu,\"tid\":%lu}",
+                  now(), mPid, threadId());
+    std::lock_guard<std::mutex> lock(mMutex);
+    append(event);
+}
+
+void trace_impl::queueGPU(const char* pName, const GLuint pQueries[2])
+{
+    GPUSpan span;
+    span.mContext    = currentContext;
+    span.mName       = pName;
+    span.mQueries[0] = pQueries[0];
+    span.mQueries[1] = pQueries[1];
+    span.mFence      = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPending.push_back(span);
+}
+
+void trace_impl::resolveGPU(const bool pWait)
+{
+    if (!mFile)
+        return;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    bool calibrated = false;
+    double offset   = 0.0;
+    unsigned track  = 0;
+
+    std::vector<GPUSpan> pending;
+    for (auto& span : mPending) {
+        if (span.mContext != currentContext) {
+            pending.push_back(span);
+            continue;
+        }
+        GLenum status = glClientWaitSync(span.mFence, pWait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                                         pWait ? 1000000000ull : 0);
+        if (status == GL_TIMEOUT_EXPIRED && !pWait) {
+            pending.push_back(span);
+            continue;
+        }
+        if (status != GL_WAIT_FAILED) {
+            if (!calibrated) {
+                /* GPU clock is mapped onto the CPU one by sampling
+                 * both now, good enough for spans of recent frames */
+                GLint64 gpuNow = 0;
+                glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+                offset = now() - gpuNow * 1e-3;
+
+                auto it = mTracks.find(currentContext);
+                if (it == mTracks.end()) {
+                    track = GPU_TRACK_BASE + (unsigned)mTracks.size();
+                    mTracks[currentContext] = track;
+
+                    char event[256];
+                    std::snprintf(event, sizeof(event),
+                                  "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%lu,\"tid\":%u,"
+                                  "\"args\":{\"name\":\"GPU context %u\"}}",
+                                  mPid, track, track - GPU_TRACK_BASE);
+                    append(event);
+                } else {
+                    track = it->second;
+                }
+                calibrated = true;
+            }
+            GLuint64 start = 0, stop = 0;
+            glGetQueryObjectui64v(span.mQueries[0], GL_QUERY_RESULT, &start);
+            glGetQueryObjectui64v(span.mQueries[1], GL_QUERY_RESULT, &stop);
+
+            char event[512];
+            std::snprintf(event, sizeof(event),
+                          "{\"name\":\"%s\",\"cat\":\"gpu\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                          "\"pid\":%lu,\"tid\":%u}",
+                          escape(span.mName.c_str()).c_str(), start * 1e-3 + offset,
+                          (stop - start) * 1e-3, mPid, track);
+            append(event);
+        }
+        glDeleteQueries(2, span.mQueries);
+        glDeleteSync(span.mFence);
+    }
+    mPending.swap(pending);
+
+    /* once per frame, so that a trace of a crashed run is still useful */
+    if (!mBuffer.empty())
+        flush();
+}
+
+TraceScope::TraceScope(const char* pName, const bool pGPU)
+    : mName(pName), mGPU(false), mStart(-1.0)
+{
+    trace_impl& tracer = trace_impl::instance();
+    if (!tracer.enabled())
+        return;
+    if (pGPU && trace_impl::context()) {
+        mGPU = true;
+        glGenQueries(2, mQueries);
+        glQueryCounter(mQueries[0], GL_TIMESTAMP);
+    }
+    mStart = tracer.now();
+}
+
+TraceScope::~TraceScope()
+{
+    if (mStart < 0.0)
+        return;
+    trace_impl& tracer = trace_impl::instance();
+    if (mGPU) {
+        glQueryCounter(mQueries[1], GL_TIMESTAMP);
+        tracer.queueGPU(mName, mQueries);
+    }
+    tracer.complete(mName, mStart, tracer.now());
+}
+
+}
@@ -0,0 +1,127 @@
+/*******************************************************
+* Copyright (c) 2015-2019, ArrayFire
+* All rights reserved.
+*
+* This file is distributed under 3-clause BSD license.
+* The complete license agreement can be obtained at:
+* http://arrayfire.com/licenses/BSD-3-Clause
+********************************************************/
+
+#pragma once
+
+#include <common.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace opengl
+{
+
+/* Writes spans of work to a Chrome trace_event file
+ *
+ * Tracing is turned on by naming the output file in FG_TRACE_FILE
+ * environment variable. Events are written in the JSON array format read
+ * by chrome://tracing and Perfetto, a trace cut short by a crash still loads.
+ *
+ * CPU spans carry the id of the thread they ran on. GPU spans are bracketed
+ * by timestamp queries followed by a fence, they are read once the fence is
+ * signaled and shown on a track of their own per context, shifted to the
+ * CPU clock. Hence reading them back never stalls rendering.
+ *
+ * Forge's own spans are compiled in only when FG_ENABLE_TRACING is defined,
+ * spans of the application added through fg_trace_begin are always recorded.
+ */
+class trace_impl {
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        struct GPUSpan {
+            const void* mContext;
+            std::string mName;
+            GLuint      mQueries[2];
+            GLsync      mFence;
+        };
+
+        std::FILE*        mFile;
+        bool              mFirst;
+        Clock::time_point mEpoch;
+        unsigned long     mPid;
+        std::string       mBuffer;
+        std::mutex        mMutex;
+
+        std::vector<GPUSpan>            mPending;
+        /* track id of the GPU timeline of each context */
+        std::map<const void*, unsigned> mTracks;
+
+        trace_impl();
+        ~trace_impl();
+
+        void append(const std::string& pEvent);
+        void flush();
+
+    public:
+        static trace_impl& instance();
+
+        bool enabled() const { return mFile != nullptr; }
+
+        /* @return microseconds since tracing started */
+        double now() const;
+
+        /* span that ran on calling thread */
+        void complete(const char* pName, const double pStart, const double pEnd);
+
+        /* open and close a span on calling thread, spans nest */
+        void begin(const char* pName);
+        void end();
+
+        /* queue a GPU span, pQueries hold GL_TIMESTAMP queries
+         * issued at its start and end on the current context */
+        void queueGPU(const char* pName, const GLuint pQueries[2]);
+
+        /* emit GPU spans of the current context that are done, waiting
+         * for them if pWait is true. Spans that are not done are kept */
+        void resolveGPU(const bool pWait);
+
+        /* context whose window is current on calling thread */
+        static const void* context();
+        static void setContext(const void* pContext);
+};
+
+/* Traces the enclosing scope, and its GL commands if pGPU is true */
+class TraceScope {
+    private:
+        const char* mName;
+        bool        mGPU;
+        double      mStart;
+        GLuint      mQueries[2];
+
+        TraceScope(const TraceScope&);
+        TraceScope& operator=(const TraceScope&);
+
+    public:
+        TraceScope(const char* pName, const bool pGPU=false);
+        ~TraceScope();
+};
+
+}
+
+#define FG_TRACE_CONCAT_(pA, pB) pA##pB
+#define FG_TRACE_CONCAT(pA, pB) FG_TRACE_CONCAT_(pA, pB)
+
+#if defined(FG_ENABLE_TRACING)
+#define FG_TRACE_SCOPE(pName) \
+    opengl::TraceScope FG_TRACE_CONCAT(fgTraceScope, __LINE__)(pName)
+#define FG_TRACE_GPU_SCOPE(pName) \
+    opengl::TraceScope FG_TRACE_CONCAT(fgTraceScope, __LINE__)(pName, true)
+#define FG_TRACE_CONTEXT(pContext) opengl::trace_impl::setContext(pContext)
+#define FG_TRACE_RESOLVE_GPU(pWait) opengl::trace_impl::instance().resolveGPU(pWait)
+#else
+#define FG_TRACE_SCOPE(pName)
+#define FG_TRACE_GPU_SCOPE(pName)
+#define FG_TRACE_CONTEXT(pContext)
+#define FG_TRACE_RESOLVE_GPU(pWait)
+#endif
@@ -0,0 +1,121 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <common.hpp>
+#include <uploader_impl.hpp>
+#include <window_impl.hpp>
+
+#include <cstring>
+
+namespace opengl
+{
+
+uploader_impl::uploader_impl(const std::shared_ptr<window_impl>& pWindow)
+    : mBusy(false), mStop(false)
+{
+    /* widgets have to be created on the thread that owns
+     * the event loop, hence the hidden window is created here
+     * and only its context is handed over to the worker */
+    mWindow = std::make_shared<window_impl>(1, 1, "Forge Uploader", pWindow, true);
+    mWindow->get()->releaseContext();
+    MakeContextCurrent(pWindow.get());
+
+    mWorker = std::thread(&uploader_impl::run, this);
+}
+
+uploader_impl::~uploader_impl()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mCondition.notify_one();
+    if (mWorker.joinable())
+        mWorker.join();
+
+    for (auto fence : mFences)
+        glDeleteSync(fence);
+}
+
+void uploader_impl::run()
+{
+    MakeContextCurrent(mWindow.get());
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this] { return mStop || !mJobs.empty(); });
+            if (mJobs.empty())
+                break;
+            job = std::move(mJobs.front());
+            mJobs.pop_front();
+            mBusy = true;
+        }
+
+        glBindBuffer(GL_COPY_WRITE_BUFFER, job.mBuffer);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, job.mOffset, job.mData.size(), job.mData.data());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        /* fence has to reach the GPU before other
+         * contexts can wait on it without dead locking */
+        glFlush();
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mFences.push_back(fence);
+            mBusy = false;
+        }
+        mIdle.notify_all();
+    }
+
+    mWindow->get()->releaseContext();
+}
+
+void uploader_impl::upload(const GLuint pBuffer, const void* pData,
+                           const size_t pBytes, const size_t pOffset)
+{
+    if (pData == NULL)
+        throw fg::ArgumentError("uploader_impl::upload", __LINE__, 2,
+                                "Host pointer is NULL");
+
+    Job job;
+    job.mBuffer = pBuffer;
+    job.mOffset = pOffset;
+    job.mData.resize(pBytes);
+    std::memcpy(job.mData.data(), pData, pBytes);
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJobs.push_back(std::move(job));
+    }
+    mCondition.notify_one();
+}
+
+void uploader_impl::finish()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mIdle.wait(lock, [this] { return mJobs.empty() && !mBusy; });
+}
+
+void uploader_impl::waitOnGPU()
+{
+    std::vector<GLsync> fences;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        fences.swap(mFences);
+    }
+    /* sync objects are shared between contexts, the
+     * wait is queued on the GPU and returns at once */
+    for (auto fence : fences) {
+        glWaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSync(fence);
+    }
+}
+
+}
@@ -0,0 +1,79 @@
+/*******************************************************
+* Copyright (c) 2015-2019, ArrayFire
+* All rights reserved.
+*
+* This file is distributed under 3-clause BSD license.
+* The complete license agreement can be obtained at:
+* http://arrayfire.com/licenses/BSD-3-Clause
+********************************************************/
+
+#pragma once
+
+#include <common.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace opengl
+{
+
+class window_impl;
+
+/* Copies host data into OpenGL buffers off the render thread
+ *
+ * The uploader owns a hidden window whose context shares objects with
+ * the context of the window it is created for. A background thread makes
+ * that context current and executes the upload jobs in submission order.
+ * Each job is followed by a fence, render thread makes the GPU wait on
+ * these fences before drawing, so the CPU never blocks on a transfer.
+ */
+class uploader_impl {
+    private:
+        struct Job {
+            GLuint mBuffer;
+            size_t mOffset;
+            std::vector<uchar> mData;
+        };
+
+        std::shared_ptr<window_impl> mWindow;
+        /* members below are guarded by mMutex */
+        std::mutex              mMutex;
+        std::condition_variable mCondition;
+        std::condition_variable mIdle;
+        std::deque<Job>         mJobs;
+        std::vector<GLsync>     mFences;
+        bool                    mBusy;
+        bool                    mStop;
+        std::thread             mWorker;
+
+        void run();
+
+    public:
+        /* @pWindow is the window whose context is shared */
+        uploader_impl(const std::shared_ptr<window_impl>& pWindow);
+        ~uploader_impl();
+
+        /* Queue a copy of host memory into a buffer object
+         *
+         * Data is copied before returning, hence the caller can reuse
+         * the memory pointed by pData right away.
+         */
+        void upload(const GLuint pBuffer, const void* pData,
+                    const size_t pBytes, const size_t pOffset);
+
+        /* Block calling thread until all queued jobs are issued */
+        void finish();
+
+        /* Make the GPU wait on fences of issued jobs
+         *
+         * Has to be called with the context of render
+         * thread current, ideally before drawing anything.
+         */
+        void waitOnGPU();
+};
+
+}
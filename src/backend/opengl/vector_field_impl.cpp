@@ -8,6 +8,8 @@
  ********************************************************/
 
 #include <err_opengl.hpp>
+#include <profiler_impl.hpp>
+#include <trace_impl.hpp>
 #include <vector_field_impl.hpp>
 #include <shader_headers/vector_field2d_vs.hpp>
 #include <shader_headers/vector_field2d_gs.hpp>
@@ -36,7 +38,7 @@ void vector_field_impl::bindResources(const int pWindowId)
         // attach vertices
         glEnableVertexAttribArray(mFieldPointIndex);
         glBindBuffer(GL_ARRAY_BUFFER, mVBO);
-        glVertexAttribPointer(mFieldPointIndex, mDimension, mGLType, GL_FALSE, 0, 0);
+        glVertexAttribPointer(mFieldPointIndex, mDimension, mGLType, isNormalized(mDataType), 0, 0);
         // attach colors
         glEnableVertexAttribArray(mFieldColorIndex);
         glBindBuffer(GL_ARRAY_BUFFER, mCBO);
@@ -146,8 +148,10 @@ vector_field_impl::vector_field_impl(const uint pNumPoints, const fg::dtype pDat
             case GL_UNSIGNED_INT   : PLOT_CREATE_BUFFERS(uint)  ; break;
             case GL_SHORT          : PLOT_CREATE_BUFFERS(short) ; break;
             case GL_UNSIGNED_SHORT : PLOT_CREATE_BUFFERS(ushort); break;
-            case GL_UNSIGNED_BYTE  : PLOT_CREATE_BUFFERS(float) ; break;
-            default: fg::TypeError("vector_field_impl::vector_field_impl", __LINE__, 1, mDataType);
+            case GL_HALF_FLOAT     : PLOT_CREATE_BUFFERS(ushort); break;
+            case GL_BYTE           : PLOT_CREATE_BUFFERS(char)  ; break;
+            case GL_UNSIGNED_BYTE  : PLOT_CREATE_BUFFERS(uchar) ; break;
+            default: throw fg::TypeError("vector_field_impl::vector_field_impl", __LINE__, 1, mDataType);
         }
 #undef PLOT_CREATE_BUFFERS
         CheckGL("End vector_field_impl::vector_field_impl");
@@ -178,6 +182,15 @@ size_t vector_field_impl::directionsSize() const
     return mDBOSize;
 }
 
+GLuint vector_field_impl::buffer(const fg::BufferKind pKind, size_t& pSize)
+{
+    if (pKind == FG_DIRECTION_BUFFER) {
+        pSize = directionsSize();
+        return directions();
+    }
+    return AbstractRenderable::buffer(pKind, pSize);
+}
+
 void vector_field_impl::render(const int pWindowId,
                        const int pX, const int pY, const int pVPW, const int pVPH,
                        const glm::mat4& pView)
@@ -185,6 +198,8 @@ void vector_field_impl::render(const int pWindowId,
     static const glm::mat4 ArrowScaleMat = glm::scale(glm::mat4(1), glm::vec3(0.1,0.1,0.1));
 
     CheckGL("Begin vector_field_impl::render");
+    ProfileScope scope(FG_STAT_RENDERABLE, this, mLegend);
+    FG_TRACE_GPU_SCOPE("vector_field_impl::render");
     if (mIsPVAOn) {
         glDepthMask(GL_FALSE);
         glEnable(GL_BLEND);
@@ -206,6 +221,7 @@ void vector_field_impl::render(const int pWindowId,
         glEnable(GL_CULL_FACE);
     vector_field_impl::bindResources(pWindowId);
     glDrawArrays(GL_POINTS, 0, mNumPoints);
+    countDrawCall();
     vector_field_impl::unbindResources();
     if (mDimension==3)
         glDisable(GL_CULL_FACE);
@@ -65,6 +65,8 @@ class vector_field_impl : public AbstractRenderable {
         GLuint directions();
         size_t directionsSize() const;
 
+        GLuint buffer(const fg::BufferKind pKind, size_t& pSize) override;
+
         virtual void render(const int pWindowId,
                             const int pX, const int pY, const int pVPW, const int pVPH,
                             const glm::mat4 &pView);
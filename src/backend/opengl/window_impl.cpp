@@ -12,9 +12,15 @@
 
 #include <common.hpp>
 #include <err_opengl.hpp>
+#include <profiler_impl.hpp>
+#include <trace_impl.hpp>
 #include <window_impl.hpp>
+#include <shader_headers/image_vs.hpp>
+#include <shader_headers/cell_fs.hpp>
 
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <memory>
 #include <mutex>
 
@@ -22,7 +28,9 @@
 
 using namespace fg;
 
-static GLEWContext* current = nullptr;
+/* each thread has its own current context, uploader
+ * threads make their hidden window context current */
+static thread_local GLEWContext* current = nullptr;
 
 GLEWContext* glewGetContext()
 {
@@ -90,12 +98,36 @@ void MakeContextCurrent(const window_impl* pWindow)
     if (pWindow != NULL) {
         pWindow->get()->makeContextCurrent();
         current = pWindow->glewContext();
+        profiler_impl::setCurrent(pWindow->profiler());
+        glDebugSetCurrent(pWindow->debugLog());
+        FG_TRACE_CONTEXT(pWindow);
     }
 }
 
+void ReleaseContext(const window_impl* pWindow)
+{
+    pWindow->get()->releaseContext();
+    current = nullptr;
+    profiler_impl::setCurrent(nullptr);
+    glDebugSetCurrent(nullptr);
+}
+
+void checkContextCurrent(const char* pFunction)
+{
+    if (current == nullptr)
+        throw fg::Error(pFunction, __LINE__,
+                        "No window context is current on the calling thread, "
+                        "use Window::submit for windows in threaded mode",
+                        FG_ERR_GL_ERROR);
+}
+
 window_impl::window_impl(int pWidth, int pHeight, const char* pTitle,
                         std::weak_ptr<window_impl> pWindow, const bool invisible)
-    : mID(getNextUniqueId())
+    : mID(getNextUniqueId()), mCMapTex(0), mCMapLen(0), mUserCMap(0),
+      mOwnerThread(std::this_thread::get_id()), mSwapInterval(-1), mOnDemand(false),
+      mCellFBO(0), mCellColorRBO(0), mCellDepthRBO(0),
+      mCellCacheWidth(0), mCellCacheHeight(0), mCellProgram(0),
+      mProfiler(new profiler_impl()), mStatsOverlay(false)
 {
     if (auto observe = pWindow.lock()) {
         mWindow = new wtk::Widget(pWidth, pHeight, pTitle, observe->get(), invisible);
@@ -135,6 +167,16 @@ window_impl::window_impl(int pWidth, int pHeight, const char* pTitle,
                 "GLEW initilization failed", FG_ERR_GL_ERROR);
     }
 
+    if (glDebugEnabled()) {
+        mDebugLog.reset(new GLDebugLog());
+        if (glDebugAttach(mDebugLog.get())) {
+            glDebugSetCurrent(mDebugLog.get());
+        } else {
+            std::cerr << "Forge: context has no KHR_debug, FG_GL_DEBUG is ignored\n";
+            mDebugLog.reset();
+        }
+    }
+
     mCxt = mWindow->getGLContextHandle();
     mDsp = mWindow->getDisplayHandle();
     /* copy colormap shared pointer if
@@ -150,8 +192,8 @@ window_impl::window_impl(int pWidth, int pHeight, const char* pTitle,
     mWindow->resizePixelBuffers();
 
     /* set the colormap to default */
-    mColorMapUBO = mCMap->defaultMap();
-    mUBOSize = mCMap->defaultLen();
+    mCMapTex = mCMap->cmap(FG_COLOR_MAP_DEFAULT);
+    mCMapLen = mCMap->length(FG_COLOR_MAP_DEFAULT);
     glEnable(GL_MULTISAMPLE);
 
     std::vector<glm::mat4>& mats = mWindow->mViewMatrices;
@@ -172,12 +214,35 @@ window_impl::window_impl(int pWidth, int pHeight, const char* pTitle,
 
 window_impl::~window_impl()
 {
+    /* let queued commands finish and get
+     * the context back on this thread */
+    if (mRenderThread) {
+        mRenderThread.reset();
+        MakeContextCurrent(this);
+    }
+    /* worker of uploader has to let go of
+     * the shared context before it is destroyed */
+    mUploader.reset();
+    /* query objects of profiler and tracer belong to this context */
+    MakeContextCurrent(this);
+    mProfiler.reset();
+    FG_TRACE_RESOLVE_GPU(true);
+    if (mUserCMap)
+        glDeleteTextures(1, &mUserCMap);
+    releaseCellCache();
+    if (mCellProgram)
+        glDeleteProgram(mCellProgram);
+    if (mDebugLog) {
+        glDebugAttach(NULL);
+        glDebugSetCurrent(nullptr);
+    }
     delete mWindow;
 }
 
 void window_impl::setFont(const std::shared_ptr<font_impl>& pFont)
 {
     mFont = pFont;
+    mWindow->mDirty = true;
 }
 
 void window_impl::setTitle(const char* pTitle)
@@ -197,36 +262,89 @@ void window_impl::setSize(unsigned pW, unsigned pH)
 
 void window_impl::setColorMap(fg::ColorMap cmap)
 {
-    switch(cmap) {
-        case FG_COLOR_MAP_DEFAULT:
-            mColorMapUBO = mCMap->defaultMap();
-            mUBOSize     = mCMap->defaultLen();
-            break;
-        case FG_COLOR_MAP_SPECTRUM:
-            mColorMapUBO = mCMap->spectrum();
-            mUBOSize     = mCMap->spectrumLen();
-            break;
-        case FG_COLOR_MAP_COLORS:
-            mColorMapUBO = mCMap->colors();
-            mUBOSize     = mCMap->colorsLen();
-            break;
-        case FG_COLOR_MAP_RED:
-            mColorMapUBO = mCMap->red();
-            mUBOSize     = mCMap->redLen();
-            break;
-        case FG_COLOR_MAP_MOOD:
-            mColorMapUBO = mCMap->mood();
-            mUBOSize     = mCMap->moodLen();
-            break;
-        case FG_COLOR_MAP_HEAT:
-            mColorMapUBO = mCMap->heat();
-            mUBOSize     = mCMap->heatLen();
-            break;
-        case FG_COLOR_MAP_BLUE:
-            mColorMapUBO = mCMap->blue();
-            mUBOSize     = mCMap->blueLen();
-            break;
+    if (forward([&] { setColorMap(cmap); }))
+        return;
+    MakeContextCurrent(this);
+    if (mUserCMap) {
+        glDeleteTextures(1, &mUserCMap);
+        mUserCMap = 0;
+    }
+    mCMapTex = mCMap->cmap(cmap);
+    mCMapLen = mCMap->length(cmap);
+    mWindow->mDirty = true;
+}
+
+void window_impl::setColorMap(const float* pRGBA, const size_t pLength)
+{
+    if (forward([&] { setColorMap(pRGBA, pLength); }))
+        return;
+    MakeContextCurrent(this);
+    GLuint tex = createColorMapTexture(pRGBA, pLength);
+    if (mUserCMap)
+        glDeleteTextures(1, &mUserCMap);
+    mUserCMap = tex;
+    mCMapTex  = mUserCMap;
+    mCMapLen  = (GLuint)pLength;
+    mWindow->mDirty = true;
+}
+
+void window_impl::uploadAsync(const GLuint pBuffer, const void* pData,
+                              const size_t pBytes, const size_t pOffset)
+{
+    if (mRenderThread) {
+        /* render thread already owns a context, buffer
+         * updates are ordered with draws in its queue */
+        if (pData == NULL)
+            throw fg::ArgumentError("window_impl::uploadAsync", __LINE__, 2,
+                                    "Host pointer is NULL");
+        if (mProfiler->enabled())
+            mProfiler->addUploadBytes(pBytes);
+        std::shared_ptr< std::vector<uchar> > data =
+            std::make_shared< std::vector<uchar> >(pBytes);
+        std::memcpy(data->data(), pData, pBytes);
+        mRenderThread->enqueue([pBuffer, pOffset, data] {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, pBuffer);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, pOffset, data->size(), data->data());
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        });
+        return;
+    }
+
+    std::shared_ptr<uploader_impl> uploader;
+    {
+        std::lock_guard<std::mutex> lock(mUploaderMutex);
+        if (!mUploader)
+            mUploader = std::make_shared<uploader_impl>(shared_from_this());
+        uploader = mUploader;
+    }
+    uploader->upload(pBuffer, pData, pBytes, pOffset);
+    if (mProfiler->enabled())
+        mProfiler->addUploadBytes(pBytes);
+}
+
+void window_impl::finishUploads()
+{
+    if (mRenderThread && !mRenderThread->onRenderThread())
+        mRenderThread->wait(mRenderThread->enqueue([] {}));
+
+    std::shared_ptr<uploader_impl> uploader;
+    {
+        std::lock_guard<std::mutex> lock(mUploaderMutex);
+        uploader = mUploader;
+    }
+    if (uploader)
+        uploader->finish();
+}
+
+void window_impl::waitOnUploads()
+{
+    std::shared_ptr<uploader_impl> uploader;
+    {
+        std::lock_guard<std::mutex> lock(mUploaderMutex);
+        uploader = mUploader;
     }
+    if (uploader)
+        uploader->waitOnGPU();
 }
 
 int window_impl::getID() const
@@ -269,6 +387,16 @@ const std::shared_ptr<colormap_impl>& window_impl::colorMapPtr() const
     return mCMap;
 }
 
+profiler_impl* window_impl::profiler() const
+{
+    return mProfiler.get();
+}
+
+GLDebugLog* window_impl::debugLog() const
+{
+    return mDebugLog.get();
+}
+
 void window_impl::hide()
 {
     mWindow->hide();
@@ -284,37 +412,238 @@ bool window_impl::close()
     return mWindow->close();
 }
 
-void window_impl::draw(const std::shared_ptr<AbstractRenderable>& pRenderable)
+bool window_impl::forward(const std::function<void()>& pCommand)
+{
+    if (!mRenderThread || mRenderThread->onRenderThread())
+        return false;
+    /* wait returns only after the command has run, hence
+     * it can safely refer to the arguments of the caller */
+    mRenderThread->wait(mRenderThread->enqueue(std::function<void()>(pCommand)));
+    return true;
+}
+
+glm::mat4 window_impl::cellView(int pColId, int pRowId) const
+{
+    /* grid may change on the render thread and views
+     * on the thread processing events, copy under lock */
+    std::lock_guard<std::mutex> lock(mWindow->mViewMutex);
+    if (pColId < 0 || pColId >= mWindow->mCols)
+        throw fg::ArgumentError("window_impl::draw", __LINE__, 1,
+                                "Column index is outside of the grid");
+    if (pRowId < 0 || pRowId >= mWindow->mRows)
+        throw fg::ArgumentError("window_impl::draw", __LINE__, 2,
+                                "Row index is outside of the grid");
+    return mWindow->mViewMatrices[pRowId + pColId * mWindow->mRows];
+}
+
+void window_impl::pollEvents()
+{
+    /* events are delivered only to the thread
+     * that created the window */
+    if (std::this_thread::get_id() == mOwnerThread)
+        mWindow->pollEvents();
+    /* a render thread applies resize events on its next swap */
+    if (!mRenderThread)
+        mWindow->applyResize();
+}
+
+void window_impl::renderFrame(const std::shared_ptr<AbstractRenderable>& pRenderable,
+                              const glm::mat4& pView)
 {
     CheckGL("Begin window_impl::draw");
     MakeContextCurrent(this);
+    FG_TRACE_GPU_SCOPE("window_impl::renderFrame");
+    mProfiler->beginFrame();
     mWindow->resetCloseFlag();
+    waitOnUploads();
     glViewport(0, 0, mWindow->mWidth, mWindow->mHeight);
 
-    const glm::mat4& viewMatrix = mWindow->mViewMatrices[0];
     // clear color and depth buffers
     glClearColor(WHITE[0], WHITE[1], WHITE[2], WHITE[3]);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // set colormap call is equivalent to noop for non-image renderables
-    pRenderable->setColorMapUBOParams(mColorMapUBO, mUBOSize);
-    pRenderable->render(mID, 0, 0, mWindow->mWidth, mWindow->mHeight, viewMatrix);
+    pRenderable->setColorMapParams(mCMapTex, mCMapLen);
+    pRenderable->render(mID, 0, 0, mWindow->mWidth, mWindow->mHeight, pView);
+    pRenderable->markRendered();
 
-    mWindow->swapBuffers();
-    mWindow->pollEvents();
     CheckGL("End window_impl::draw");
 }
 
+void window_impl::setSwapInterval(const int pInterval)
+{
+    if (mSwapInterval == pInterval)
+        return;
+    /* swap interval applies to the current context */
+    MakeContextCurrent(this);
+    mWindow->setSwapInterval(pInterval);
+    mSwapInterval = pInterval;
+}
+
+void window_impl::setThreaded(const bool pThreaded)
+{
+    if (pThreaded == (mRenderThread != nullptr))
+        return;
+
+    if (pThreaded) {
+        mRenderThread.reset(new render_thread_impl(this));
+    } else {
+        mRenderThread.reset();
+        MakeContextCurrent(this);
+    }
+}
+
+void window_impl::setRenderOnDemand(const bool pOnDemand)
+{
+    if (forward([&] { setRenderOnDemand(pOnDemand); }))
+        return;
+    mOnDemand = pOnDemand;
+    mDrawnState.clear();
+    mCells.clear();
+    /* cached cells weren't kept up to date while
+     * not rendering on demand, they are drawn again */
+    for (auto& it : mCellCache)
+        it.second.mState.clear();
+    mWindow->mDirty = true;
+}
+
+bool window_impl::needsRedraw(std::vector<unsigned long long>& pState)
+{
+    /* nothing can be seen, contents are redrawn once window is exposed */
+    if (mWindow->isHidden())
+        return false;
+    if (!mWindow->mDirty && pState == mDrawnState)
+        return false;
+    mDrawnState.swap(pState);
+    mWindow->mDirty = false;
+    return true;
+}
+
+void window_impl::run(fg_frame_callback pCallback, void* pUserData, const float pMaxFps)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    if (pCallback == NULL)
+        throw fg::ArgumentError("window_impl::run", __LINE__, 1,
+                                "Frame callback is NULL");
+    if (pMaxFps < 0)
+        throw fg::ArgumentError("window_impl::run", __LINE__, 3,
+                                "Frame rate limit can not be negative");
+    if (std::this_thread::get_id() != mOwnerThread)
+        throw fg::Error("window_impl::run", __LINE__,
+                        "Event loop has to run on the thread that created the window",
+                        FG_ERR_INVALID_ARG);
+
+    const bool onDemand = mOnDemand;
+    setRenderOnDemand(true);
+
+    const Clock::duration period =
+        std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(pMaxFps > 0 ? 1.0 / pMaxFps : 0.0));
+    try {
+        while (!mWindow->close()) {
+            const Clock::time_point next = Clock::now() + period;
+            if (!pCallback(pUserData))
+                break;
+            if (pMaxFps > 0) {
+                /* sleep inside the event queue until next frame is
+                 * due, events arriving meanwhile are handled at once */
+                for (Clock::time_point now = Clock::now();
+                     now < next && !mWindow->close(); now = Clock::now())
+                    mWindow->waitEvents(std::chrono::duration<double>(next - now).count());
+            } else {
+                mWindow->waitEvents(0);
+            }
+        }
+    } catch (...) {
+        setRenderOnDemand(onDemand);
+        throw;
+    }
+    setRenderOnDemand(onDemand);
+}
+
+void window_impl::draw(const std::shared_ptr<AbstractRenderable>& pRenderable)
+{
+    FG_TRACE_SCOPE("window_impl::draw");
+    if (mRenderThread) {
+        mRenderThread->wait(drawAsync(pRenderable));
+        return;
+    }
+    if (mOnDemand) {
+        std::vector<unsigned long long> state(1, (unsigned long long)pRenderable.get());
+        state.push_back(pRenderable->version());
+        if (!needsRedraw(state)) {
+            pollEvents();
+            return;
+        }
+    }
+    renderFrame(pRenderable, cellView(0, 0));
+    finishFrame();
+    mWindow->swapBuffers();
+    pollEvents();
+}
+
+unsigned long long window_impl::drawAsync(const std::shared_ptr<AbstractRenderable>& pRenderable)
+{
+    if (!mRenderThread) {
+        draw(pRenderable);
+        return 0;
+    }
+    if (mOnDemand) {
+        std::vector<unsigned long long> state(1, (unsigned long long)pRenderable.get());
+        state.push_back(pRenderable->version());
+        if (!needsRedraw(state)) {
+            pollEvents();
+            return 0;
+        }
+    }
+    /* view matrices are updated by event handlers,
+     * render thread works on a copy */
+    const glm::mat4 view = cellView(0, 0);
+    unsigned long long id = mRenderThread->enqueue([this, pRenderable, view] {
+        renderFrame(pRenderable, view);
+        finishFrame();
+        mWindow->swapBuffers();
+    });
+    pollEvents();
+    return id;
+}
+
+unsigned long long window_impl::submit(fg_window_task pTask, void* pUserData)
+{
+    if (pTask == NULL)
+        throw fg::ArgumentError("window_impl::submit", __LINE__, 1,
+                                "Task function is NULL");
+    if (!mRenderThread) {
+        MakeContextCurrent(this);
+        pTask(pUserData);
+        return 0;
+    }
+    return mRenderThread->enqueue([pTask, pUserData] { pTask(pUserData); });
+}
+
+void window_impl::wait(const unsigned long long pId)
+{
+    if (mRenderThread && pId > 0)
+        mRenderThread->wait(pId);
+}
+
 void window_impl::grid(int pRows, int pCols)
 {
+    if (forward([&] { grid(pRows, pCols); }))
+        return;
+    MakeContextCurrent(this);
+    releaseCellCache();
     glViewport(0, 0, mWindow->mWidth, mWindow->mHeight);
     glClearColor(WHITE[0], WHITE[1], WHITE[2], WHITE[3]);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+    std::lock_guard<std::mutex> lock(mWindow->mViewMutex);
     mWindow->mRows       = pRows;
     mWindow->mCols       = pCols;
     mWindow->mCellWidth  = mWindow->mWidth  / mWindow->mCols;
     mWindow->mCellHeight = mWindow->mHeight / mWindow->mRows;
+    mWindow->mDirty      = true;
 
     // resize viewMatrix array for views to appropriate size
     std::vector<glm::mat4>& mats = mWindow->mViewMatrices;
@@ -322,21 +651,78 @@ void window_impl::grid(int pRows, int pCols)
     std::fill(mats.begin(), mats.end(), glm::mat4(1));
 }
 
-void window_impl::draw(int pColId, int pRowId,
-                       const std::shared_ptr<AbstractRenderable>& pRenderable,
-                       const char* pTitle)
+void window_impl::releaseCellCache()
 {
-    CheckGL("Begin draw(column, row)");
-    MakeContextCurrent(this);
-    mWindow->resetCloseFlag();
+    for (auto& it : mCellCache) {
+        glDeleteFramebuffers(1, &it.second.mFBO);
+        glDeleteTextures(1, &it.second.mTex);
+    }
+    mCellCache.clear();
+    if (mCellFBO) {
+        glDeleteFramebuffers(1, &mCellFBO);
+        glDeleteRenderbuffers(1, &mCellColorRBO);
+        glDeleteRenderbuffers(1, &mCellDepthRBO);
+        mCellFBO = mCellColorRBO = mCellDepthRBO = 0;
+    }
+    mCellCacheWidth  = 0;
+    mCellCacheHeight = 0;
+}
+
+void window_impl::prepareCellCache()
+{
+    const int w = mWindow->mCellWidth;
+    const int h = mWindow->mCellHeight;
+    if (mCellFBO && mCellCacheWidth == w && mCellCacheHeight == h)
+        return;
+
+    CheckGL("Begin window_impl::prepareCellCache");
+    /* cached cells are of no use once cell size changes */
+    releaseCellCache();
+
+    /* match anti-aliasing of the window framebuffer */
+    GLint samples = 0, maxSamples = 0;
+    glGetIntegerv(GL_SAMPLES, &samples);
+    glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+    samples = std::min(samples, maxSamples);
+
+    glGenRenderbuffers(1, &mCellColorRBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, mCellColorRBO);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RGBA8, w, h);
+    glGenRenderbuffers(1, &mCellDepthRBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, mCellDepthRBO);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_DEPTH_COMPONENT24, w, h);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &mCellFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, mCellFBO);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                              GL_RENDERBUFFER, mCellColorRBO);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                              GL_RENDERBUFFER, mCellDepthRBO);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+        throw fg::Error("window_impl::prepareCellCache", __LINE__,
+                        "Incomplete framebuffer for grid cells", FG_ERR_GL_ERROR);
+
+    if (mCellProgram == 0) {
+        mCellProgram     = initShaders(glsl::image_vs.c_str(), glsl::cell_fs.c_str());
+        mCellMatIndex    = glGetUniformLocation(mCellProgram, "matrix");
+        mCellTexIndex    = glGetUniformLocation(mCellProgram, "tex"   );
+        mCellOffsetIndex = glGetUniformLocation(mCellProgram, "offset");
+    }
 
+    mCellCacheWidth  = w;
+    mCellCacheHeight = h;
+    CheckGL("End window_impl::prepareCellCache");
+}
+
+void window_impl::drawCell(int pX, int pY,
+                           const std::shared_ptr<AbstractRenderable>& pRenderable,
+                           const char* pTitle, const glm::mat4& pView)
+{
     float pos[2] = {0.0, 0.0};
-    int c     = pColId;
-    int r     = pRowId;
-    int x_off = c * mWindow->mCellWidth;
-    int y_off = (mWindow->mRows - 1 - r) * mWindow->mCellHeight;
 
-    const glm::mat4& viewMatrix = mWindow->mViewMatrices[r+c*mWindow->mRows];
     /* following margins are tested out for various
      * aspect ratios and are working fine. DO NOT CHANGE.
      * */
@@ -345,18 +731,19 @@ void window_impl::draw(int pColId, int pRowId,
     int lef_margin = int(0.02f*mWindow->mCellWidth);
     int rig_margin = int(0.02f*mWindow->mCellWidth);
     // set viewport to render sub image
-    glViewport(x_off + lef_margin, y_off + bot_margin,
+    glViewport(pX + lef_margin, pY + bot_margin,
             mWindow->mCellWidth - 2 * rig_margin, mWindow->mCellHeight - 2 * top_margin);
-    glScissor(x_off + lef_margin, y_off + bot_margin,
+    glScissor(pX + lef_margin, pY + bot_margin,
             mWindow->mCellWidth - 2 * rig_margin, mWindow->mCellHeight - 2 * top_margin);
     glEnable(GL_SCISSOR_TEST);
 
     // set colormap call is equivalent to noop for non-image renderables
-    pRenderable->setColorMapUBOParams(mColorMapUBO, mUBOSize);
-    pRenderable->render(mID, x_off, y_off, mWindow->mCellWidth, mWindow->mCellHeight, viewMatrix);
+    pRenderable->setColorMapParams(mCMapTex, mCMapLen);
+    pRenderable->render(mID, pX, pY, mWindow->mCellWidth, mWindow->mCellHeight, pView);
+    pRenderable->markRendered();
 
     glDisable(GL_SCISSOR_TEST);
-    glViewport(x_off, y_off, mWindow->mCellWidth, mWindow->mCellHeight);
+    glViewport(pX, pY, mWindow->mCellWidth, mWindow->mCellHeight);
 
     if (pTitle!=NULL) {
         mFont->setOthro2D(mWindow->mCellWidth, mWindow->mCellHeight);
@@ -364,19 +751,294 @@ void window_impl::draw(int pColId, int pRowId,
         pos[1] = mWindow->mCellHeight*0.92f;
         mFont->render(mID, pos, AF_BLUE, pTitle, 16);
     }
+}
+
+void window_impl::renderCell(int pColId, int pRowId,
+                             const std::shared_ptr<AbstractRenderable>& pRenderable,
+                             const char* pTitle, const glm::mat4& pView)
+{
+    CheckGL("Begin draw(column, row)");
+    MakeContextCurrent(this);
+    FG_TRACE_GPU_SCOPE("window_impl::renderCell");
+    mProfiler->beginFrame();
+    mWindow->resetCloseFlag();
+    waitOnUploads();
+
+    const int w   = mWindow->mCellWidth;
+    const int h   = mWindow->mCellHeight;
+    int x_off     = pColId * w;
+    int y_off     = (mWindow->mRows - 1 - pRowId) * h;
+
+    /* buffers written through OpenGL or compute interop don't change
+     * the version of a renderable, cells are reused from the cache
+     * only when rendering on demand, which relies on markDirty */
+    if (!mOnDemand) {
+        drawCell(x_off, y_off, pRenderable, pTitle, pView);
+        CheckGL("End draw(column, row)");
+        return;
+    }
+    prepareCellCache();
+
+    /* everything that affects the pixels of cell other than
+     * its view matrix, which is compared separately */
+    std::vector<unsigned long long> state;
+    state.push_back((unsigned long long)pRenderable.get());
+    state.push_back(pRenderable->version());
+    state.push_back(pTitle != NULL);
+    state.push_back(pTitle != NULL ? std::hash<std::string>()(pTitle) : 0);
+    state.push_back(mCMapTex);
+    state.push_back(mCMapLen);
+    state.push_back((unsigned long long)mFont.get());
+
+    CellCache& cache = mCellCache[pRowId + pColId * mWindow->mRows];
+    if (cache.mFBO == 0) {
+        glGenTextures(1, &cache.mTex);
+        glBindTexture(GL_TEXTURE_2D, cache.mTex);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glGenFramebuffers(1, &cache.mFBO);
+        glBindFramebuffer(GL_FRAMEBUFFER, cache.mFBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                               GL_TEXTURE_2D, cache.mTex, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        cache.mState.clear();
+    }
+
+    if (state != cache.mState || pView != cache.mView) {
+        glBindFramebuffer(GL_FRAMEBUFFER, mCellFBO);
+        glViewport(0, 0, w, h);
+        glClearColor(WHITE[0], WHITE[1], WHITE[2], WHITE[3]);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        drawCell(0, 0, pRenderable, pTitle, pView);
+
+        /* resolve samples into the texture of cell */
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, mCellFBO);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, cache.mFBO);
+        glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        cache.mState.swap(state);
+        cache.mView = pView;
+    }
+
+    /* compose the frame, cached cell covers the whole cell area */
+    glViewport(x_off, y_off, w, h);
+    GLboolean isDepthOn = glIsEnabled(GL_DEPTH_TEST);
+    GLboolean isBlendOn = glIsEnabled(GL_BLEND);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    glUseProgram(mCellProgram);
+    glUniformMatrix4fv(mCellMatIndex, 1, GL_FALSE, glm::value_ptr(IDENTITY));
+    glUniform2i(mCellOffsetIndex, x_off, y_off);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, cache.mTex);
+    glUniform1i(mCellTexIndex, 0);
+    glBindVertexArray(screenQuadVAO(mID));
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    countDrawCall();
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+    if (isDepthOn) glEnable(GL_DEPTH_TEST);
+    if (isBlendOn) glEnable(GL_BLEND);
 
     CheckGL("End draw(column, row)");
 }
 
+void window_impl::draw(int pColId, int pRowId,
+                       const std::shared_ptr<AbstractRenderable>& pRenderable,
+                       const char* pTitle)
+{
+    FG_TRACE_SCOPE("window_impl::draw");
+    if (mRenderThread) {
+        mRenderThread->wait(drawAsync(pColId, pRowId, pRenderable, pTitle));
+        return;
+    }
+    if (mOnDemand) {
+        /* whether cells have to be drawn is known only on swap */
+        mCells.push_back(makeCell(pColId, pRowId, pRenderable, pTitle));
+        return;
+    }
+    renderCell(pColId, pRowId, pRenderable, pTitle, cellView(pColId, pRowId));
+}
+
+unsigned long long window_impl::drawAsync(int pColId, int pRowId,
+                                          const std::shared_ptr<AbstractRenderable>& pRenderable,
+                                          const char* pTitle)
+{
+    if (!mRenderThread) {
+        draw(pColId, pRowId, pRenderable, pTitle);
+        return 0;
+    }
+    /* cell is validated and its view copied here,
+     * so that errors are reported to the caller */
+    DeferredCell cell = makeCell(pColId, pRowId, pRenderable, pTitle);
+    if (mOnDemand) {
+        mCells.push_back(cell);
+        return 0;
+    }
+    return mRenderThread->enqueue([this, cell] {
+        renderCell(cell.mColId, cell.mRowId, cell.mRenderable,
+                   cell.mHasTitle ? cell.mTitle.c_str() : NULL, cell.mView);
+    });
+}
+
+window_impl::DeferredCell window_impl::makeCell(int pColId, int pRowId,
+                                                const std::shared_ptr<AbstractRenderable>& pRenderable,
+                                                const char* pTitle) const
+{
+    DeferredCell cell;
+    cell.mColId      = pColId;
+    cell.mRowId      = pRowId;
+    cell.mRenderable = pRenderable;
+    cell.mHasTitle   = pTitle != NULL;
+    cell.mTitle      = cell.mHasTitle ? pTitle : "";
+    cell.mView       = cellView(pColId, pRowId);
+    return cell;
+}
+
+bool window_impl::takeCells(std::vector<DeferredCell>& pCells)
+{
+    pCells.clear();
+    pCells.swap(mCells);
+    std::vector<unsigned long long> state;
+    for (auto& cell : pCells) {
+        state.push_back((unsigned long long)cell.mRenderable.get());
+        state.push_back(cell.mRenderable->version());
+        state.push_back(cell.mColId + cell.mRowId * mWindow->mCols);
+        state.push_back(std::hash<std::string>()(cell.mTitle) + cell.mHasTitle);
+    }
+    return needsRedraw(state);
+}
+
+void window_impl::renderCells(const std::vector<DeferredCell>& pCells)
+{
+    for (auto& cell : pCells) {
+        renderCell(cell.mColId, cell.mRowId, cell.mRenderable,
+                   cell.mHasTitle ? cell.mTitle.c_str() : NULL, cell.mView);
+    }
+}
+
+void window_impl::present()
+{
+    FG_TRACE_SCOPE("window_impl::swapBuffers");
+    finishFrame();
+    mWindow->swapBuffers();
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
 void window_impl::swapBuffers()
 {
+    FG_TRACE_SCOPE("window_impl::swapBuffers");
+    if (mRenderThread) {
+        mRenderThread->wait(swapBuffersAsync());
+        return;
+    }
+    if (mOnDemand) {
+        std::vector<DeferredCell> cells;
+        if (!takeCells(cells)) {
+            pollEvents();
+            return;
+        }
+        renderCells(cells);
+    }
+    finishFrame();
     mWindow->swapBuffers();
     mWindow->pollEvents();
+    mWindow->applyResize();
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
+unsigned long long window_impl::swapBuffersAsync()
+{
+    if (!mRenderThread) {
+        swapBuffers();
+        return 0;
+    }
+    /* like drawAsync, whether anything changed is decided on the
+     * calling thread, which owns the cells and window events */
+    std::vector<DeferredCell> cells;
+    if (mOnDemand && !takeCells(cells)) {
+        pollEvents();
+        return 0;
+    }
+    unsigned long long id = mRenderThread->enqueue([this, cells] {
+        renderCells(cells);
+        present();
+    });
+    pollEvents();
+    return id;
+}
+
+void window_impl::finishFrame()
+{
+    FrameCheckGL("window_impl::finishFrame");
+    mProfiler->endFrame();
+    FG_TRACE_RESOLVE_GPU(false);
+    if (mStatsOverlay)
+        drawStatsOverlay();
+}
+
+void window_impl::drawStatsOverlay()
+{
+    const fg_frame_stats stats = mProfiler->stats();
+    char lines[2][160];
+    snprintf(lines[0], sizeof(lines[0]),
+             "frame %llu  cpu %.2f ms  gpu %.2f ms  draws %u  upload %.1f KB",
+             stats.mFrame, stats.mCPUTime[FG_STAT_FRAME], stats.mGPUTime[FG_STAT_FRAME],
+             stats.mDrawCalls[FG_STAT_FRAME], stats.mUploadedBytes / 1024.0);
+    snprintf(lines[1], sizeof(lines[1]),
+             "gpu ms  chart %.2f  renderables %.2f  text %.2f  upload %.2f",
+             stats.mGPUTime[FG_STAT_CHART], stats.mGPUTime[FG_STAT_RENDERABLE],
+             stats.mGPUTime[FG_STAT_TEXT], stats.mGPUTime[FG_STAT_UPLOAD]);
+
+    /* overlay is not part of the measured frame */
+    MakeContextCurrent(this);
+    profiler_impl::setCurrent(nullptr);
+    glViewport(0, 0, mWindow->mWidth, mWindow->mHeight);
+    mFont->setOthro2D(mWindow->mWidth, mWindow->mHeight);
+    float pos[2] = {8.0f, mWindow->mHeight - 20.0f};
+    for (int i = 0; i < 2; ++i) {
+        mFont->render(mID, pos, AF_BLUE, lines[i], 14);
+        pos[1] -= 18.0f;
+    }
+    profiler_impl::setCurrent(mProfiler.get());
+}
+
+void window_impl::setProfiling(const bool pProfile)
+{
+    if (forward([&] { setProfiling(pProfile); }))
+        return;
+    mProfiler->setEnabled(pProfile);
+    if (!pProfile)
+        mStatsOverlay = false;
+}
+
+void window_impl::showStats(const bool pShow)
+{
+    if (forward([&] { showStats(pShow); }))
+        return;
+    if (pShow)
+        mProfiler->setEnabled(true);
+    mStatsOverlay = pShow;
+    mWindow->mDirty = true;
+}
+
+fg_frame_stats window_impl::frameStats() const
+{
+    return mProfiler->stats();
+}
+
 void window_impl::saveFrameBuffer(const char* pFullPath)
 {
+    if (forward([&] { saveFrameBuffer(pFullPath); }))
+        return;
+    FG_TRACE_SCOPE("window_impl::saveFrameBuffer");
+
     if (!pFullPath) {
         throw fg::ArgumentError("window_impl::saveFrameBuffer", __LINE__, 1,
                                 "Empty path string");
@@ -18,16 +18,26 @@
 #endif
 
 #include <colormap_impl.hpp>
+#include <err_opengl.hpp>
 #include <font_impl.hpp>
 #include <image_impl.hpp>
 #include <chart_impl.hpp>
+#include <profiler_impl.hpp>
+#include <render_thread_impl.hpp>
+#include <uploader_impl.hpp>
 
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace opengl
 {
 
-class window_impl {
+class window_impl : public std::enable_shared_from_this<window_impl> {
     private:
         long long     mCxt;
         long long     mDsp;
@@ -38,8 +48,104 @@ class window_impl {
         std::shared_ptr<font_impl>     mFont;
         std::shared_ptr<colormap_impl> mCMap;
 
-        GLuint        mColorMapUBO;
-        GLuint        mUBOSize;
+        /* color map texture used by renderables and its length,
+         * mUserCMap is the texture of color map set by user, if any */
+        GLuint        mCMapTex;
+        GLuint        mCMapLen;
+        GLuint        mUserCMap;
+
+        /* background uploader, created on first asynchronous upload */
+        std::shared_ptr<uploader_impl> mUploader;
+        std::mutex                     mUploaderMutex;
+
+        /* render thread and the thread that created the window,
+         * events are processed only on the latter */
+        std::unique_ptr<render_thread_impl> mRenderThread;
+        std::thread::id                     mOwnerThread;
+        /* swap interval last set on the context, -1 when unknown */
+        int                                 mSwapInterval;
+
+        /* render on demand: frames are drawn only when the window
+         * or what is drawn in it changed since the last frame */
+        struct DeferredCell {
+            int         mColId;
+            int         mRowId;
+            std::shared_ptr<AbstractRenderable> mRenderable;
+            bool        mHasTitle;
+            std::string mTitle;
+            glm::mat4   mView;
+        };
+        bool                                mOnDemand;
+        /* identities and versions of what was drawn last */
+        std::vector<unsigned long long>     mDrawnState;
+        /* cells are drawn together on swap, only if any of them changed */
+        std::vector<DeferredCell>           mCells;
+
+        /* grid cells are rendered into textures of their own and
+         * rendered again only when what they show changes, the
+         * frame is composed from these textures, see renderCell */
+        struct CellCache {
+            GLuint      mFBO;
+            GLuint      mTex;
+            glm::mat4   mView;
+            std::vector<unsigned long long> mState;
+        };
+        std::map<int, CellCache>            mCellCache;
+        /* cells are rendered into these multisampled buffers first,
+         * sized to the cell size of the current layout */
+        GLuint                              mCellFBO;
+        GLuint                              mCellColorRBO;
+        GLuint                              mCellDepthRBO;
+        int                                 mCellCacheWidth;
+        int                                 mCellCacheHeight;
+        GLuint                              mCellProgram;
+        GLuint                              mCellMatIndex;
+        GLuint                              mCellTexIndex;
+        GLuint                              mCellOffsetIndex;
+
+        /* frame timings, shown on top of the frame if mStatsOverlay is set */
+        std::unique_ptr<profiler_impl>      mProfiler;
+        bool                                mStatsOverlay;
+        /* errors of debug output, NULL unless FG_GL_DEBUG is set */
+        std::unique_ptr<GLDebugLog>         mDebugLog;
+
+        void waitOnUploads();
+        void pollEvents();
+        /* run command on render thread and wait for it, returns
+         * false when the caller has to run it on its own */
+        bool forward(const std::function<void()>& pCommand);
+        /* copy of the view matrix of a grid cell, throws
+         * if the cell is not part of the current grid */
+        glm::mat4 cellView(int pColId, int pRowId) const;
+        void renderFrame(const std::shared_ptr<AbstractRenderable>& pRenderable,
+                         const glm::mat4& pView);
+        void renderCell(int pColId, int pRowId,
+                        const std::shared_ptr<AbstractRenderable>& pRenderable,
+                        const char* pTitle, const glm::mat4& pView);
+        void drawCell(int pX, int pY,
+                      const std::shared_ptr<AbstractRenderable>& pRenderable,
+                      const char* pTitle, const glm::mat4& pView);
+        DeferredCell makeCell(int pColId, int pRowId,
+                              const std::shared_ptr<AbstractRenderable>& pRenderable,
+                              const char* pTitle) const;
+        /* moves the cells drawn since the last swap into pCells,
+         * returns true when they have to be rendered, see needsRedraw */
+        bool takeCells(std::vector<DeferredCell>& pCells);
+        void renderCells(const std::vector<DeferredCell>& pCells);
+        void prepareCellCache();
+        void releaseCellCache();
+        void present();
+        /* has to be called right before buffers are swapped */
+        void finishFrame();
+        void drawStatsOverlay();
+        void setSwapInterval(const int pInterval);
+        /* compares pState with the last drawn state, takes it over
+         * and returns true when a new frame has to be drawn */
+        bool needsRedraw(std::vector<unsigned long long>& pState);
+
+        /* scheduler renders several windows and
+         * presents them together, see scheduler_impl */
+        friend class scheduler_impl;
 
     public:
         window_impl(int pWidth, int pHeight, const char* pTitle,
@@ -52,6 +158,11 @@ class window_impl {
         void setPos(int pX, int pY);
         void setSize(unsigned pWidth, unsigned pHeight);
         void setColorMap(fg::ColorMap cmap);
+        void setColorMap(const float* pRGBA, const size_t pLength);
+
+        void uploadAsync(const GLuint pBuffer, const void* pData,
+                         const size_t pBytes, const size_t pOffset);
+        void finishUploads();
 
         int getID() const;
         long long context() const;
@@ -61,24 +172,54 @@ class window_impl {
         GLEWContext* glewContext() const;
         const wtk::Widget* get() const;
         const std::shared_ptr<colormap_impl>& colorMapPtr() const;
+        profiler_impl* profiler() const;
+        GLDebugLog* debugLog() const;
 
         void hide();
         void show();
         bool close();
 
+        void setThreaded(const bool pThreaded);
+
+        void setRenderOnDemand(const bool pOnDemand);
+
+        void setProfiling(const bool pProfile);
+
+        void showStats(const bool pShow);
+
+        fg_frame_stats frameStats() const;
+
+        void run(fg_frame_callback pCallback, void* pUserData, const float pMaxFps);
+
         void draw(const std::shared_ptr<AbstractRenderable>& pRenderable);
 
+        unsigned long long drawAsync(const std::shared_ptr<AbstractRenderable>& pRenderable);
+
         void grid(int pRows, int pCols);
 
         void draw(int pColId, int pRowId,
                   const std::shared_ptr<AbstractRenderable>& pRenderable,
                   const char* pTitle);
 
+        unsigned long long drawAsync(int pColId, int pRowId,
+                                     const std::shared_ptr<AbstractRenderable>& pRenderable,
+                                     const char* pTitle);
+
         void swapBuffers();
 
+        unsigned long long swapBuffersAsync();
+
+        unsigned long long submit(fg_window_task pTask, void* pUserData);
+
+        void wait(const unsigned long long pId);
+
         void saveFrameBuffer(const char* pFullPath);
 };
 
 void MakeContextCurrent(const window_impl* pWindow);
 
+/* releases the context of the window and forgets it
+ * as the current context of the calling thread */
+void ReleaseContext(const window_impl* pWindow);
+
 }
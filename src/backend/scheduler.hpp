@@ -0,0 +1,74 @@
+/*******************************************************
+* Copyright (c) 2015-2019, ArrayFire
+* All rights reserved.
+*
+* This file is distributed under 3-clause BSD license.
+* The complete license agreement can be obtained at:
+* http://arrayfire.com/licenses/BSD-3-Clause
+********************************************************/
+
+#pragma once
+
+#include <backend.hpp>
+#include <scheduler_impl.hpp>
+
+#include <chart.hpp>
+#include <image.hpp>
+#include <tiled_image.hpp>
+#include <window.hpp>
+
+#include <memory>
+
+namespace common
+{
+
+class Scheduler {
+    private:
+        std::shared_ptr<detail::scheduler_impl> mScheduler;
+
+    public:
+        Scheduler() : mScheduler(std::make_shared<detail::scheduler_impl>()) {}
+
+        Scheduler(const fg_scheduler pOther) {
+            mScheduler = reinterpret_cast<Scheduler*>(pOther)->impl();
+        }
+
+        inline const std::shared_ptr<detail::scheduler_impl>& impl() const { return mScheduler; }
+
+        inline void add(const Window* pWindow, Image* pImage, const bool pKeepAspectRatio) {
+            pImage->keepAspectRatio(pKeepAspectRatio);
+            mScheduler->add(pWindow->impl(), pImage->impl());
+        }
+
+        inline void add(const Window* pWindow, TiledImage* pImage, const bool pKeepAspectRatio) {
+            pImage->keepAspectRatio(pKeepAspectRatio);
+            mScheduler->add(pWindow->impl(), pImage->impl());
+        }
+
+        inline void add(const Window* pWindow, const Chart* pChart) {
+            mScheduler->add(pWindow->impl(), pChart->impl());
+        }
+
+        inline void add(const Window* pWindow, int pColId, int pRowId,
+                        Image* pImage, const char* pTitle, const bool pKeepAspectRatio) {
+            pImage->keepAspectRatio(pKeepAspectRatio);
+            mScheduler->add(pWindow->impl(), pColId, pRowId, pImage->impl(), pTitle);
+        }
+
+        inline void add(const Window* pWindow, int pColId, int pRowId,
+                        TiledImage* pImage, const char* pTitle, const bool pKeepAspectRatio) {
+            pImage->keepAspectRatio(pKeepAspectRatio);
+            mScheduler->add(pWindow->impl(), pColId, pRowId, pImage->impl(), pTitle);
+        }
+
+        inline void add(const Window* pWindow, int pColId, int pRowId,
+                        const Chart* pChart, const char* pTitle) {
+            mScheduler->add(pWindow->impl(), pColId, pRowId, pChart->impl(), pTitle);
+        }
+
+        inline void clear() { mScheduler->clear(); }
+
+        inline void draw() { mScheduler->draw(); }
+};
+
+}
@@ -0,0 +1,143 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+#include <thread_pool.hpp>
+#include <util.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace common
+{
+
+static unsigned threadCount()
+{
+    std::string value = getEnvVar("FG_UTIL_THREADS");
+    int count = value.empty() ? 0 : std::atoi(value.c_str());
+    if (count > 0)
+        return (unsigned)count;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+ThreadPool& ThreadPool::instance()
+{
+    static ThreadPool pool(threadCount());
+    return pool;
+}
+
+ThreadPool::ThreadPool(const unsigned pThreads)
+    : mGeneration(0), mStop(false), mTask(nullptr), mPending(0)
+{
+    for (unsigned i = 0; i < pThreads; ++i)
+        mQueues.emplace_back(new Queue());
+    /* thread zero is the caller of parallelFor */
+    for (unsigned i = 1; i < pThreads; ++i)
+        mThreads.emplace_back(&ThreadPool::loop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+    for (auto& thread : mThreads)
+        thread.join();
+}
+
+bool ThreadPool::pop(const unsigned pSelf, Chunk& pChunk)
+{
+    const unsigned n = size();
+    for (unsigned i = 0; i < n; ++i) {
+        Queue& queue = *mQueues[(pSelf + i) % n];
+        std::lock_guard<std::mutex> lock(queue.mMutex);
+        if (queue.mChunks.empty())
+            continue;
+        if (i == 0) {
+            pChunk = queue.mChunks.back();
+            queue.mChunks.pop_back();
+        } else {
+            pChunk = queue.mChunks.front();
+            queue.mChunks.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::work(const unsigned pSelf)
+{
+    Chunk chunk;
+    while (pop(pSelf, chunk)) {
+        (*mTask)(chunk.first, chunk.second, pSelf);
+        if (mPending.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mDone.notify_all();
+        }
+    }
+}
+
+void ThreadPool::loop(const unsigned pSelf)
+{
+    unsigned long long seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWake.wait(lock, [&] { return mStop || mGeneration != seen; });
+            if (mStop)
+                return;
+            seen = mGeneration;
+        }
+        work(pSelf);
+    }
+}
+
+void ThreadPool::parallelFor(const size_t pCount, const size_t pGrain, const RangeTask& pTask)
+{
+    const size_t grain = std::max<size_t>(pGrain, 1);
+    if (pCount == 0)
+        return;
+    if (size() == 1 || pCount <= grain) {
+        pTask(0, pCount, 0);
+        return;
+    }
+
+    std::lock_guard<std::mutex> loopLock(mLoopMutex);
+
+    const size_t chunks = (pCount + grain - 1) / grain;
+    const unsigned n    = size();
+
+    mTask = &pTask;
+    mPending.store(chunks);
+    /* queue q gets chunks [q*chunks/n, (q+1)*chunks/n), pushed
+     * in reverse so that its owner starts at the lowest address */
+    for (unsigned q = 0; q < n; ++q) {
+        const size_t first = q * chunks / n;
+        const size_t last  = (q + 1) * chunks / n;
+        std::lock_guard<std::mutex> lock(mQueues[q]->mMutex);
+        for (size_t c = last; c > first; --c) {
+            const size_t begin = (c - 1) * grain;
+            mQueues[q]->mChunks.push_back(Chunk(begin, std::min(begin + grain, pCount)));
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mGeneration;
+    }
+    mWake.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDone.wait(lock, [&] { return mPending.load() == 0; });
+    mTask = nullptr;
+}
+
+}
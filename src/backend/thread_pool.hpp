@@ -0,0 +1,88 @@
+/*******************************************************
+ * Copyright (c) 2015-2019, ArrayFire
+ * All rights reserved.
+ *
+ * This file is distributed under 3-clause BSD license.
+ * The complete license agreement can be obtained at:
+ * http://arrayfire.com/licenses/BSD-3-Clause
+ ********************************************************/
+
+/// This file contains the thread pool used by CPU kernels of fg::util
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace common
+{
+
+/// Work-stealing pool of threads for data parallel loops
+///
+/// A range is cut into chunks which are dealt out in contiguous runs to
+/// a queue per thread, so that each thread walks memory in order. Threads
+/// take chunks from the back of their own queue and, once it is empty,
+/// steal from the front of the queues of others. The calling thread takes
+/// part as thread zero.
+///
+/// The number of threads is that of hardware threads unless the
+/// FG_UTIL_THREADS environment variable asks otherwise.
+class ThreadPool {
+    public:
+        /// Called with a range [begin, end) and the index of the thread
+        /// running it, in [0, size()), which is meant for per thread results
+        typedef std::function<void(size_t, size_t, unsigned)> RangeTask;
+
+        static ThreadPool& instance();
+
+        ~ThreadPool();
+
+        /// @return number of threads, the calling thread included
+        unsigned size() const { return (unsigned)mQueues.size(); }
+
+        /// Run pTask over [0, pCount) in chunks of pGrain elements and
+        /// return once all of them are done. Small ranges run on the
+        /// calling thread only.
+        void parallelFor(const size_t pCount, const size_t pGrain, const RangeTask& pTask);
+
+    private:
+        typedef std::pair<size_t, size_t> Chunk;
+
+        struct Queue {
+            std::mutex        mMutex;
+            std::deque<Chunk> mChunks;
+        };
+
+        std::vector<std::thread>            mThreads;
+        std::vector<std::unique_ptr<Queue>> mQueues;
+
+        std::mutex              mMutex;
+        std::condition_variable mWake;
+        std::condition_variable mDone;
+        unsigned long long      mGeneration;
+        bool                    mStop;
+
+        /* one loop at a time, callers on other threads wait */
+        std::mutex              mLoopMutex;
+        const RangeTask*        mTask;
+        std::atomic<size_t>     mPending;
+
+        explicit ThreadPool(const unsigned pThreads);
+
+        ThreadPool(const ThreadPool&);
+        ThreadPool& operator=(const ThreadPool&);
+
+        bool pop(const unsigned pSelf, Chunk& pChunk);
+        void work(const unsigned pSelf);
+        void loop(const unsigned pSelf);
+};
+
+}
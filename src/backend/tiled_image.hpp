@@ -0,0 +1,62 @@
+/*******************************************************
+* Copyright (c) 2015-2019, ArrayFire
+* All rights reserved.
+*
+* This file is distributed under 3-clause BSD license.
+* The complete license agreement can be obtained at:
+* http://arrayfire.com/licenses/BSD-3-Clause
+********************************************************/
+
+#pragma once
+
+#include <backend.hpp>
+#include <tiled_image_impl.hpp>
+
+#include <glm/glm.hpp>
+
+#include <memory>
+
+namespace common
+{
+
+class TiledImage {
+    private:
+        std::shared_ptr<detail::tiled_image_impl> mImage;
+
+    public:
+        TiledImage(const uint pWidth, const uint pHeight,
+                   const fg::ChannelFormat pFormat, const fg::dtype pDataType,
+                   fg_tile_loader pLoader, void* pUserData)
+            : mImage(std::make_shared<detail::tiled_image_impl>(pWidth, pHeight,
+                                                                 pFormat, pDataType,
+                                                                 pLoader, pUserData)) {}
+
+        TiledImage(const char* pFilePath, const uint pWidth, const uint pHeight,
+                   const fg::ChannelFormat pFormat, const fg::dtype pDataType)
+            : mImage(std::make_shared<detail::tiled_image_impl>(pFilePath, pWidth, pHeight,
+                                                                 pFormat, pDataType)) {}
+
+        TiledImage(const fg_tiled_image pOther) {
+            mImage = reinterpret_cast<TiledImage*>(pOther)->impl();
+        }
+
+        inline const std::shared_ptr<detail::tiled_image_impl>& impl() const { return mImage; }
+
+        inline void setCacheSize(const uint pMaxTiles) { mImage->setCacheSize(pMaxTiles); }
+
+        inline void setAlpha(const float pAlpha) { mImage->setAlpha(pAlpha); }
+
+        inline void keepAspectRatio(const bool pKeep) { mImage->keepAspectRatio(pKeep); }
+
+        inline void setColorMap(const float* pRGBA, const size_t pLength) {
+            mImage->setColorMap(pRGBA, pLength);
+        }
+
+        inline uint width() const { return mImage->width(); }
+
+        inline uint height() const { return mImage->height(); }
+
+        inline uint levels() const { return mImage->levels(); }
+};
+
+}
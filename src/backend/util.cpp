@@ -8,11 +8,19 @@
  ********************************************************/
 
 /// This file contains platform independent utility functions
+#include <fg/exception.h>
+#include <util.hpp>
+
 #include <string>
 #include <cstdlib>
 
 #if defined(OS_WIN)
 #include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 using std::string;
@@ -35,3 +43,58 @@ string getEnvVar(const std::string &key)
     return str==NULL ? string("") : string(str);
 #endif
 }
+
+MappedFile::MappedFile(const std::string &path)
+    : mData(NULL), mSize(0)
+{
+#if defined(OS_WIN)
+    mFile = CreateFile(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                       OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+    if (mFile == INVALID_HANDLE_VALUE) {
+        throw fg::Error("MappedFile constructor", __LINE__,
+                        "Failed to open file", FG_ERR_FILE_NOT_FOUND);
+    }
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(mFile, &fileSize);
+    mSize = (size_t)fileSize.QuadPart;
+    mMapping = CreateFileMapping(mFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mMapping != NULL) {
+        mData = MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (mData == NULL) {
+        if (mMapping != NULL) CloseHandle(mMapping);
+        CloseHandle(mFile);
+        throw fg::Error("MappedFile constructor", __LINE__,
+                        "Failed to map file", FG_ERR_RUNTIME);
+    }
+#else
+    mFile = open(path.c_str(), O_RDONLY);
+    if (mFile < 0) {
+        throw fg::Error("MappedFile constructor", __LINE__,
+                        "Failed to open file", FG_ERR_FILE_NOT_FOUND);
+    }
+    struct stat fileStat;
+    fstat(mFile, &fileStat);
+    mSize = (size_t)fileStat.st_size;
+    mData = mmap(NULL, mSize, PROT_READ, MAP_SHARED, mFile, 0);
+    if (mData == MAP_FAILED) {
+        close(mFile);
+        throw fg::Error("MappedFile constructor", __LINE__,
+                        "Failed to map file", FG_ERR_RUNTIME);
+    }
+    /* tiles are read in a scattered manner */
+    madvise(mData, mSize, MADV_RANDOM);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#if defined(OS_WIN)
+    UnmapViewOfFile(mData);
+    CloseHandle(mMapping);
+    CloseHandle(mFile);
+#else
+    munmap(mData, mSize);
+    close(mFile);
+#endif
+}
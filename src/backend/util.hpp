@@ -10,7 +10,31 @@
 /// This file contains platform independent utility functions
 
 #include <string>
+#include <cstddef>
 
 #pragma once
 
 std::string getEnvVar(const std::string &key);
+
+/// Read-only memory mapping of an entire file
+class MappedFile {
+    private:
+        void*  mData;
+        size_t mSize;
+#if defined(OS_WIN)
+        void*  mFile;
+        void*  mMapping;
+#else
+        int    mFile;
+#endif
+
+        MappedFile(const MappedFile&);
+        MappedFile& operator=(const MappedFile&);
+
+    public:
+        explicit MappedFile(const std::string &path);
+        ~MappedFile();
+
+        const unsigned char* data() const { return (const unsigned char*)mData; }
+        size_t size() const { return mSize; }
+};
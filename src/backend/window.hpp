@@ -15,6 +15,7 @@
 #include <chart.hpp>
 #include <font.hpp>
 #include <image.hpp>
+#include <tiled_image.hpp>
 
 #include <memory>
 
@@ -69,6 +70,10 @@ class Window {
             mWindow->setColorMap(cmap);
         }
 
+        inline void setColorMap(const float* pRGBA, const size_t pLength) {
+            mWindow->setColorMap(pRGBA, pLength);
+        }
+
         inline int getID() const {
             return mWindow->getID();
         }
@@ -110,6 +115,11 @@ class Window {
             mWindow->draw(pImage->impl()) ;
         }
 
+        inline void draw(TiledImage* pImage, const bool pKeepAspectRatio) {
+            pImage->keepAspectRatio(pKeepAspectRatio);
+            mWindow->draw(pImage->impl()) ;
+        }
+
         inline void draw(const Chart* pChart) {
             mWindow->draw(pChart->impl()) ;
         }
@@ -118,6 +128,73 @@ class Window {
             mWindow->swapBuffers();
         }
 
+        inline void setThreaded(const bool pThreaded) {
+            mWindow->setThreaded(pThreaded);
+        }
+
+        inline unsigned long long drawAsync(Image* pImage, const bool pKeepAspectRatio) {
+            pImage->keepAspectRatio(pKeepAspectRatio);
+            return mWindow->drawAsync(pImage->impl());
+        }
+
+        inline unsigned long long drawAsync(TiledImage* pImage, const bool pKeepAspectRatio) {
+            pImage->keepAspectRatio(pKeepAspectRatio);
+            return mWindow->drawAsync(pImage->impl());
+        }
+
+        inline unsigned long long drawAsync(const Chart* pChart) {
+            return mWindow->drawAsync(pChart->impl());
+        }
+
+        template<typename T>
+        unsigned long long drawAsync(int pColId, int pRowId, T* pRenderable, const char* pTitle) {
+            return mWindow->drawAsync(pColId, pRowId, pRenderable->impl(), pTitle);
+        }
+
+        unsigned long long drawAsync(int pColId, int pRowId, Image* pRenderable,
+                                     const char* pTitle, const bool pKeepAspectRatio) {
+            pRenderable->keepAspectRatio(pKeepAspectRatio);
+            return mWindow->drawAsync(pColId, pRowId, pRenderable->impl(), pTitle);
+        }
+
+        unsigned long long drawAsync(int pColId, int pRowId, TiledImage* pRenderable,
+                                     const char* pTitle, const bool pKeepAspectRatio) {
+            pRenderable->keepAspectRatio(pKeepAspectRatio);
+            return mWindow->drawAsync(pColId, pRowId, pRenderable->impl(), pTitle);
+        }
+
+        inline unsigned long long swapBuffersAsync() {
+            return mWindow->swapBuffersAsync();
+        }
+
+        inline unsigned long long submit(fg_window_task pTask, void* pUserData) {
+            return mWindow->submit(pTask, pUserData);
+        }
+
+        inline void wait(const unsigned long long pId) {
+            mWindow->wait(pId);
+        }
+
+        inline void setRenderOnDemand(const bool pOnDemand) {
+            mWindow->setRenderOnDemand(pOnDemand);
+        }
+
+        inline void run(fg_frame_callback pCallback, void* pUserData, const float pMaxFps) {
+            mWindow->run(pCallback, pUserData, pMaxFps);
+        }
+
+        inline void setProfiling(const bool pProfile) {
+            mWindow->setProfiling(pProfile);
+        }
+
+        inline void showStats(const bool pShow) {
+            mWindow->showStats(pShow);
+        }
+
+        inline fg_frame_stats frameStats() const {
+            return mWindow->frameStats();
+        }
+
         inline void grid(int pRows, int pCols) {
             mWindow->grid(pRows, pCols);
         }
@@ -133,9 +210,24 @@ class Window {
             mWindow->draw(pColId, pRowId, pRenderable->impl(), pTitle);
         }
 
+        void draw(int pColId, int pRowId, TiledImage* pRenderable,
+                  const char* pTitle, const bool pKeepAspectRatio) {
+            pRenderable->keepAspectRatio(pKeepAspectRatio);
+            mWindow->draw(pColId, pRowId, pRenderable->impl(), pTitle);
+        }
+
         inline void saveFrameBuffer(const char* pFullPath) {
             mWindow->saveFrameBuffer(pFullPath);
         }
+
+        inline void uploadAsync(const uint pBuffer, const void* pData,
+                                const size_t pBytes, const size_t pOffset) {
+            mWindow->uploadAsync(pBuffer, pData, pBytes, pOffset);
+        }
+
+        inline void finishUploads() {
+            mWindow->finishUploads();
+        }
 };
 
 }